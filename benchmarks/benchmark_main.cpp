@@ -4,6 +4,7 @@
 #include <iomanip>
 #include "../src/cpu.h"
 #include "../src/memory.h"
+#include "../src/jit/jit_x64.h"
 
 // Simple Harness to load .ht files and time execution
 // using namespace Helix; // cpu.h is global
@@ -15,9 +16,14 @@ struct BenchResult {
     double mips;
 };
 
-BenchResult RunBenchmark(const std::string& name, const std::string& filename) {
+BenchResult RunBenchmark(const std::string& name, const std::string& filename, Cpu::Core core,
+                         Cpu::Instrumentation metrics, bool host_profile) {
     TernaryMemory mem;
     Cpu cpu(mem);
+    cpu.core = core;
+    cpu.instrumentation = metrics;
+    HostProfile profile;
+    if (host_profile) cpu.SetHostProfile(&profile);
     
     // Load .ht Executable
     if (!mem.LoadExecutable(filename)) {
@@ -28,17 +34,17 @@ BenchResult RunBenchmark(const std::string& name, const std::string& filename) {
     std::cout << "Running " << name << "..." << std::endl;
     
     auto start_time = std::chrono::high_resolution_clock::now();
-    // Run until HLT
-    while (true) {
-        cpu.Step(100); // Batch steps
-        if (cpu.halted) break;
-        if (cpu.metrics.total_cycles > 10000000) { // Safety break
-            std::cerr << "Timeout!" << std::endl;
-            break;
-        }
+    // Run until HLT (10M instruction safety limit)
+    Cpu::StopConditions stop;
+    stop.max_cycles = 10000000;
+    Cpu::RunResult run = cpu.RunUntil(stop);
+    uint64_t instructions = run.cycles;
+    if (run.reason == Cpu::StopReason::CycleLimit) {
+        std::cerr << "Timeout!" << std::endl;
     }
     
-    uint64_t total_cycles = cpu.metrics.total_cycles;
+    // --metrics=none leaves the cycle counter alone: fall back to instructions
+    uint64_t total_cycles = (metrics == Cpu::Instrumentation::None) ? instructions : cpu.metrics.total_cycles;
     
     auto end_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> duration = end_time - start_time;
@@ -48,6 +54,7 @@ BenchResult RunBenchmark(const std::string& name, const std::string& filename) {
     // Emulation MIPS = (Active Cycles) / Seconds?
     // Let's stick to Cycles/Sec for now or just report Cycles.
     double real_mips = (total_cycles / 1000000.0) / (duration.count() / 1000.0);
+    if (host_profile) cpu.DumpMetrics();
 
     return {name, total_cycles, duration.count(), real_mips};
 }
@@ -56,16 +63,42 @@ int main(int argc, char** argv) {
     std::cout << "Helix9 Benchmark Suite v1.0" << std::endl;
     std::cout << "---------------------------" << std::endl;
 
+    // --threaded / --blocks / --jit: run on the threaded-dispatch, basic-block or JIT core
+    // --metrics=none|basic|full: instrumentation level (default full)
+    // --host-profile: host time per opcode and memory path after each benchmark
+    //   (runs the threaded core's tracing instantiation, so MIPS drop)
+    Cpu::Core core = Cpu::Core::Switch;
+    const char* core_name = "switch";
+    Cpu::Instrumentation metrics = Cpu::Instrumentation::Full;
+    const char* metrics_name = "full";
+    bool host_profile = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threaded") { core = Cpu::Core::Threaded; core_name = "threaded"; }
+        if (arg == "--blocks") { core = Cpu::Core::Block; core_name = "blocks"; }
+        if (arg == "--jit") { core = Cpu::Core::Jit; core_name = "jit"; }
+        if (arg == "--metrics=none") { metrics = Cpu::Instrumentation::None; metrics_name = "none"; }
+        if (arg == "--metrics=basic") { metrics = Cpu::Instrumentation::Basic; metrics_name = "basic"; }
+        if (arg == "--metrics=full") { metrics = Cpu::Instrumentation::Full; metrics_name = "full"; }
+        if (arg == "--host-profile") host_profile = true;
+    }
+    std::cout << "Core: " << core_name << ", metrics: " << metrics_name
+              << (host_profile ? ", host profile (threaded tracing core)" : "") << std::endl;
+    if (core == Cpu::Core::Jit && !JitX64::Supported()) {
+        std::cout << "(JIT not supported on this host; blocks run interpreted)" << std::endl;
+    }
+
     std::vector<BenchResult> results;
     
     // Expect compiled .ht files in current dir or specific path
     // We assume they are pre-compiled or we verify assembly first.
     
-    results.push_back(RunBenchmark("Base Arithmetic", "benchmarks/bench_base.ht"));
-    results.push_back(RunBenchmark("Cognitive Ops", "benchmarks/bench_cog.ht"));
-    results.push_back(RunBenchmark("Agent Cycle", "benchmarks/bench_agent.ht"));
-    results.push_back(RunBenchmark("Vector Soft (256)", "benchmarks/bench_vec_soft.ht"));
-    results.push_back(RunBenchmark("Vector Hard (256)", "benchmarks/bench_vec_hard.ht"));
+    results.push_back(RunBenchmark("Base Arithmetic", "benchmarks/bench_base.ht", core, metrics, host_profile));
+    results.push_back(RunBenchmark("Cognitive Ops", "benchmarks/bench_cog.ht", core, metrics, host_profile));
+    results.push_back(RunBenchmark("Agent Cycle", "benchmarks/bench_agent.ht", core, metrics, host_profile));
+    results.push_back(RunBenchmark("Vector Soft (256)", "benchmarks/bench_vec_soft.ht", core, metrics, host_profile));
+    results.push_back(RunBenchmark("Vector Hard (256)", "benchmarks/bench_vec_hard.ht", core, metrics, host_profile));
+    results.push_back(RunBenchmark("Vector Regs (32)", "benchmarks/bench_vec_regs.ht", core, metrics, host_profile));
     
     std::cout << "\nResults:" << std::endl;
     std::cout << std::left << std::setw(20) << "Benchmark" 
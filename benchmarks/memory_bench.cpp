@@ -0,0 +1,105 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <random>
+#include <iomanip>
+#include "../src/memory.h"
+#include "../src/cognitive/agent.h"
+#include "../src/tnn/helix_runtime.h"
+
+// Memory Footprint Benchmark: 10k-agent belief memory + TNN weights.
+// Usage: helix_mem_bench [num_agents]
+
+using namespace Helix;
+using namespace Helix::Cognitive;
+
+static const int PAGES_PER_AGENT = 4; // 2 belief + input + output
+
+// Fill through the raw page pointer (bypasses the UART mapping at 0x8000)
+static void FillPage(TernaryMemory& mem, int64_t page_id, std::mt19937_64& rng) {
+    TernaryWord* words = mem.GetRawPointer(TernaryWord::FromInt64(page_id * PAGE_SIZE), PAGE_SIZE);
+    if (!words) return;
+    for (int i = 0; i < PAGE_SIZE; ++i) {
+        uint64_t p = rng() & ((1ULL << 27) - 1);
+        uint64_t n = rng() & ~p & ((1ULL << 27) - 1);
+        words[i] = TernaryWord(p, n);
+    }
+}
+
+static double MiB(size_t bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+int main(int argc, char** argv) {
+    int num_agents = 10000;
+    if (argc >= 2) {
+        try { num_agents = std::stoi(argv[1]); } catch(...) {}
+    }
+
+    std::cout << "Helix9 Memory Footprint Benchmark" << std::endl;
+    std::cout << "---------------------------------" << std::endl;
+    std::cout << "sizeof(TernaryWord) = " << sizeof(TernaryWord) << " bytes" << std::endl;
+
+    TernaryMemory mem;
+    std::vector<std::shared_ptr<Agent>> agents;
+    std::mt19937_64 rng(2026);
+
+    // --- 1. Populate Agents (pages owned by each agent, System context) ---
+    int64_t first_page = 0x3000 / PAGE_SIZE;
+    for (int a = 0; a < num_agents; ++a) {
+        auto agent = std::make_shared<Agent>(a + 1);
+        int64_t page = first_page + (int64_t)a * PAGES_PER_AGENT;
+        agent->belief_page_start = (uint16_t)page;
+        agent->belief_page_count = 2;
+        for (int k = 0; k < PAGES_PER_AGENT; ++k) {
+            mem.AllocatePage(page + k, agent->id, PERM_OWNER_READ | PERM_OWNER_WRITE);
+            FillPage(mem, page + k, rng);
+        }
+        agents.push_back(agent);
+    }
+
+    // --- 2. TNN Weights (shared 256x256 dense layer per 100 agents) ---
+    std::vector<TNNLayer> layers(num_agents / 100 + 1);
+    for (auto& layer : layers) {
+        layer.type = "Dense";
+        layer.input_size = 256;
+        layer.output_size = 256;
+        layer.weights.resize(256 * 256);
+        for (auto& w : layer.weights) w = TernaryWord::FromInt64((int64_t)(rng() % 3) - 1);
+    }
+    size_t weight_words = layers.size() * 256 * 256;
+
+    // --- 3. Belief Update Pass: belief[0] = Consensus(belief[0], input) ---
+    auto start_time = std::chrono::high_resolution_clock::now();
+    for (int a = 0; a < num_agents; ++a) {
+        int64_t page = first_page + (int64_t)a * PAGES_PER_AGENT;
+        TernaryWord* belief = mem.GetRawPointer(TernaryWord::FromInt64(page * PAGE_SIZE), PAGE_SIZE);
+        TernaryWord* input = mem.GetRawPointer(TernaryWord::FromInt64((page + 2) * PAGE_SIZE), PAGE_SIZE);
+        if (!belief || !input) continue;
+        for (int i = 0; i < PAGE_SIZE; ++i) belief[i] = belief[i].Consensus(input[i]);
+    }
+    auto end_time = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> duration = end_time - start_time;
+
+    // --- Report ---
+    size_t page_words = mem.AllocatedPageCount() * PAGE_SIZE;
+    size_t mem_bytes = mem.FootprintBytes();
+    size_t weight_bytes = weight_words * sizeof(TernaryWord);
+    size_t legacy_bytes = (page_words + 12288 + weight_words) * 16; // Former 2x uint64_t layout
+    size_t scanned_bytes = (size_t)num_agents * PAGE_SIZE * 2 * sizeof(TernaryWord);
+
+    std::cout << "\nAgents:            " << num_agents << std::endl;
+    std::cout << "Cognitive Pages:   " << mem.AllocatedPageCount() << std::endl;
+    std::cout << "Page Words:        " << page_words << std::endl;
+    std::cout << "Weight Words:      " << weight_words << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "TernaryMemory:     " << MiB(mem_bytes) << " MiB" << std::endl;
+    std::cout << "TNN Weights:       " << MiB(weight_bytes) << " MiB" << std::endl;
+    std::cout << "Total:             " << MiB(mem_bytes + weight_bytes) << " MiB"
+              << " (16-byte layout: " << MiB(legacy_bytes) << " MiB)" << std::endl;
+    std::cout << "Belief Update:     " << duration.count() << " ms ("
+              << (scanned_bytes / 1e6) / (duration.count() / 1000.0) << " MB/s read)" << std::endl;
+
+    return 0;
+}
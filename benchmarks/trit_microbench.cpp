@@ -0,0 +1,384 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include "../src/trit_word.h"
+#include "../src/trit_span.h"
+
+// Microbenchmarks for TernaryWord primitives (ns per operation).
+// Usage: helix_microbench [iterations]
+
+struct MicroResult {
+    std::string name;
+    double ns_per_op;
+};
+
+// Operand pool: random full-width valid words (pos & neg disjoint)
+static std::vector<TernaryWord> MakeOperands(size_t count, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    const uint64_t mask = (1ULL << 27) - 1;
+    std::vector<TernaryWord> words(count);
+    for (auto& w : words) {
+        uint64_t p = rng() & mask;
+        w = TernaryWord(p, rng() & ~p & mask);
+    }
+    return words;
+}
+
+// Volatile sink so the compiler cannot drop the measured work
+static volatile uint64_t g_sink = 0;
+
+static MicroResult Measure(const std::string& name, uint64_t iterations, const std::function<uint64_t(uint64_t)>& body) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    uint64_t acc = body(iterations);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    g_sink = g_sink + acc;
+
+    std::chrono::duration<double, std::nano> duration = end_time - start_time;
+    return {name, duration.count() / (double)iterations};
+}
+
+int main(int argc, char** argv) {
+    uint64_t iterations = 2000000;
+    if (argc >= 2) {
+        try { iterations = std::stoull(argv[1]); } catch(...) {}
+    }
+
+    std::cout << "Helix9 TernaryWord Microbenchmarks" << std::endl;
+    std::cout << "----------------------------------" << std::endl;
+
+    const size_t POOL = 1024; // Power of two, fits in L1
+    std::vector<TernaryWord> a = MakeOperands(POOL, 1);
+    std::vector<TernaryWord> b = MakeOperands(POOL, 2);
+
+    std::vector<MicroResult> results;
+
+    // --- Adder ---
+    results.push_back(Measure("Add (ripple ref)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        int8_t carry = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            TernaryWord r = a[i & (POOL - 1)].AddRipple(b[i & (POOL - 1)], carry);
+            acc += r.pos ^ r.neg ^ (uint64_t)carry;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("Add (lookahead)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        int8_t carry = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            TernaryWord r = a[i & (POOL - 1)].Add(b[i & (POOL - 1)], carry);
+            acc += r.pos ^ r.neg ^ (uint64_t)carry;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("SaturatingAdd", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            TernaryWord r = a[i & (POOL - 1)].SaturatingAdd(b[i & (POOL - 1)]);
+            acc += r.pos ^ r.neg;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("PC Increment (Add 1)", iterations, [&](uint64_t n) {
+        TernaryWord pc;
+        TernaryWord one(1, 0);
+        for (uint64_t i = 0; i < n; ++i) {
+            pc = pc.Add(one);
+        }
+        return pc.pos ^ pc.neg;
+    }));
+
+    // --- Multiply / Divide (small operands: the common MUL/DIV case) ---
+    std::vector<TernaryWord> sa_ops(POOL), sb_ops(POOL);
+    std::mt19937_64 small_rng(3);
+    for (size_t i = 0; i < POOL; ++i) {
+        sa_ops[i] = TernaryWord::FromInt64((int64_t)(small_rng() % 200001) - 100000);
+        sb_ops[i] = TernaryWord::FromInt64((int64_t)(small_rng() % 2001) - 1000 + (i % 2 ? 0 : 3));
+    }
+
+    results.push_back(Measure("Multiply (int64 trip)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            TernaryWord r = TernaryWord::FromInt64(sa_ops[i & (POOL - 1)].ToInt64() * sb_ops[i & (POOL - 1)].ToInt64());
+            acc += r.pos ^ r.neg;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("Multiply", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        TernaryWord high;
+        for (uint64_t i = 0; i < n; ++i) {
+            TernaryWord r = sa_ops[i & (POOL - 1)].Multiply(sb_ops[i & (POOL - 1)], high);
+            acc += r.pos ^ r.neg ^ high.pos;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("Multiply (planes)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        TernaryWord high;
+        for (uint64_t i = 0; i < n; ++i) {
+            TernaryWord r = sa_ops[i & (POOL - 1)].MultiplyPlanes(sb_ops[i & (POOL - 1)], high);
+            acc += r.pos ^ r.neg ^ high.pos;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("Multiply full", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        TernaryWord high;
+        for (uint64_t i = 0; i < n; ++i) {
+            TernaryWord r = a[i & (POOL - 1)].Multiply(b[i & (POOL - 1)], high);
+            acc += r.pos ^ r.neg ^ high.pos;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("DivMod (int64 trip)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            int64_t x = sa_ops[i & (POOL - 1)].ToInt64(), d = sb_ops[i & (POOL - 1)].ToInt64();
+            if (d == 0) continue;
+            TernaryWord q = TernaryWord::FromInt64(x / d), r = TernaryWord::FromInt64(x % d);
+            acc += q.pos ^ r.neg;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("DivMod", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        TernaryWord q, r;
+        for (uint64_t i = 0; i < n; ++i) {
+            if (sa_ops[i & (POOL - 1)].DivMod(sb_ops[i & (POOL - 1)], q, r)) acc += q.pos ^ r.neg;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("DivMod (planes)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        TernaryWord q, r;
+        for (uint64_t i = 0; i < n; ++i) {
+            if (sa_ops[i & (POOL - 1)].DivModPlanes(sb_ops[i & (POOL - 1)], q, r)) acc += q.pos ^ r.neg;
+        }
+        return acc;
+    }));
+
+    // --- Conversion ---
+    std::vector<int64_t> values(POOL);
+    for (size_t i = 0; i < POOL; ++i) values[i] = a[i].ToInt64();
+
+    results.push_back(Measure("FromInt64 (reference)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            TernaryWord w = TernaryWord::FromInt64Reference(values[i & (POOL - 1)]);
+            acc += w.pos ^ w.neg;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("FromInt64 (table)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            TernaryWord w = TernaryWord::FromInt64(values[i & (POOL - 1)]);
+            acc += w.pos ^ w.neg;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("ToInt64 (reference)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) acc += (uint64_t)a[i & (POOL - 1)].ToInt64Reference();
+        return acc;
+    }));
+    results.push_back(Measure("ToInt64 (table)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) acc += (uint64_t)a[i & (POOL - 1)].ToInt64();
+        return acc;
+    }));
+
+    // --- Packed Encoding (stream entries are ns per word) ---
+    std::vector<uint64_t> codes(POOL);
+    for (size_t i = 0; i < POOL; ++i) codes[i] = a[i].ToPackedReference();
+    bool host_bmi2 = TernaryWord::PackedUsesBMI2();
+
+    results.push_back(Measure("ToPacked (reference)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) acc += a[i & (POOL - 1)].ToPackedReference();
+        return acc;
+    }));
+    results.push_back(Measure("FromPacked (reference)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) acc += TernaryWord::FromPackedReference(codes[i & (POOL - 1)]).pos;
+        return acc;
+    }));
+    for (int backend = 0; backend <= (host_bmi2 ? 1 : 0); ++backend) {
+        TernaryWord::SetPackedBMI2(backend == 1);
+        std::string tag = backend ? " (BMI2)" : " (portable)";
+        results.push_back(Measure("ToPacked" + tag, iterations, [&](uint64_t n) {
+            uint64_t acc = 0;
+            for (uint64_t i = 0; i < n; ++i) acc += a[i & (POOL - 1)].ToPacked();
+            return acc;
+        }));
+        results.push_back(Measure("FromPacked" + tag, iterations, [&](uint64_t n) {
+            uint64_t acc = 0;
+            for (uint64_t i = 0; i < n; ++i) acc += TernaryWord::FromPacked(codes[i & (POOL - 1)]).pos;
+            return acc;
+        }));
+
+        std::vector<uint8_t> stream(TernaryWord::PackedStreamBytes(POOL));
+        std::vector<TernaryWord> back(POOL);
+        uint64_t passes = iterations / POOL + 1;
+        results.push_back(Measure("PackStream" + tag, passes * POOL, [&](uint64_t n) {
+            for (uint64_t k = 0; k < n / POOL; ++k) TernaryWord::PackStream(a.data(), POOL, stream.data());
+            return (uint64_t)stream[0];
+        }));
+        results.push_back(Measure("UnpackStream" + tag, passes * POOL, [&](uint64_t n) {
+            for (uint64_t k = 0; k < n / POOL; ++k) TernaryWord::UnpackStream(stream.data(), POOL, back.data());
+            return (uint64_t)back[0].pos;
+        }));
+    }
+    TernaryWord::SetPackedBMI2(host_bmi2);
+
+    // --- Decode Stage (5 field slices per instruction, as in Cpu::Step) ---
+    std::vector<TernaryWord> insts(POOL);
+    for (size_t i = 0; i < POOL; ++i) {
+        insts[i].SetSlice(21, 6, (int64_t)(i % 41));
+        insts[i].SetSlice(18, 3, (int64_t)(i % 5));
+        insts[i].SetSlice(14, 4, (int64_t)(i % 16));
+        insts[i].SetSlice(10, 4, (int64_t)((i * 7) % 16));
+        insts[i].SetSlice(0, 10, (int64_t)(i * 37) - 9000);
+    }
+
+    results.push_back(Measure("Decode (reference)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            const TernaryWord& w = insts[i & (POOL - 1)];
+            acc += w.SliceReference(21, 6) + w.SliceReference(18, 3) + w.SliceReference(14, 4)
+                 + w.SliceReference(10, 4) + w.SliceReference(0, 10);
+        }
+        return acc;
+    }));
+    results.push_back(Measure("Decode (bitplane)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            const TernaryWord& w = insts[i & (POOL - 1)];
+            acc += w.Slice(21, 6) + w.Slice(18, 3) + w.Slice(14, 4)
+                 + w.Slice(10, 4) + w.Slice(0, 10);
+        }
+        return acc;
+    }));
+    results.push_back(Measure("XOR (bitplane)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            TernaryWord r = a[i & (POOL - 1)].XOR(b[i & (POOL - 1)]);
+            acc += r.pos ^ r.neg;
+        }
+        return acc;
+    }));
+    results.push_back(Measure("ShiftLeft (bitplane)", iterations, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            TernaryWord r = a[i & (POOL - 1)].ShiftLeft();
+            acc += r.pos ^ r.neg;
+        }
+        return acc;
+    }));
+
+    // --- Bulk Kernels (ns per word): per-word methods vs TritSpan dispatch ---
+    TritArray sa, sb, sout(POOL);
+    sa.Load(a.data(), POOL);
+    sb.Load(b.data(), POOL);
+    std::vector<TernaryWord> out(POOL);
+    uint64_t passes = iterations / POOL + 1;
+
+    results.push_back(Measure("Consensus (per-word)", passes * POOL, [&](uint64_t n) {
+        for (uint64_t k = 0; k < n / POOL; ++k) {
+            for (size_t i = 0; i < POOL; ++i) out[i] = a[i].Consensus(b[i]);
+        }
+        return (uint64_t)out[0].pos;
+    }));
+    results.push_back(Measure("PopCount (per-word)", passes * POOL, [&](uint64_t n) {
+        uint64_t acc = 0;
+        for (uint64_t k = 0; k < n / POOL; ++k) {
+            for (size_t i = 0; i < POOL; ++i) acc += a[i].PopCount();
+        }
+        return acc;
+    }));
+
+    TritKernels::ISA best = TritKernels::DetectISA();
+    for (int isa = 0; isa <= (int)best; ++isa) {
+        TritKernels::ForceISA((TritKernels::ISA)isa);
+        std::string tag = std::string(" (") + TritKernels::ISAName((TritKernels::ISA)isa) + ")";
+        results.push_back(Measure("Consensus" + tag, passes * POOL, [&](uint64_t n) {
+            for (uint64_t k = 0; k < n / POOL; ++k) TritKernels::Consensus(sout.Span(), sa.Span(), sb.Span());
+            return (uint64_t)sout.pos[0];
+        }));
+        results.push_back(Measure("PopCount" + tag, passes * POOL, [&](uint64_t n) {
+            uint64_t acc = 0;
+            for (uint64_t k = 0; k < n / POOL; ++k) acc += TritKernels::PopCount(sa.Span());
+            return acc;
+        }));
+        results.push_back(Measure("Hamming" + tag, passes * POOL, [&](uint64_t n) {
+            uint64_t acc = 0;
+            for (uint64_t k = 0; k < n / POOL; ++k) acc += TritKernels::HammingDistance(sa.Span(), sb.Span());
+            return acc;
+        }));
+        // Interleaved words (page ops run on Page::words directly)
+        results.push_back(Measure("Consensus words" + tag, passes * POOL, [&](uint64_t n) {
+            for (uint64_t k = 0; k < n / POOL; ++k) TritKernels::Consensus(out.data(), a.data(), b.data(), POOL);
+            return (uint64_t)out[0].pos;
+        }));
+        results.push_back(Measure("PopCount words" + tag, passes * POOL, [&](uint64_t n) {
+            uint64_t acc = 0;
+            for (uint64_t k = 0; k < n / POOL; ++k) acc += TritKernels::PopCount(a.data(), POOL);
+            return acc;
+        }));
+    }
+    TritKernels::ForceISA(best);
+
+    // --- Matrix-vector product, single-trit weights (ns per weight) ---
+    // The VMMUL general path (int64 multiply-add) against the bitplane path
+    // (pack each row, then popcounts), on the dispatched ISA.
+    for (size_t dim : { (size_t)256, (size_t)1024 }) {
+        std::mt19937_64 trng(dim);
+        std::vector<TernaryWord> matrix(dim * dim), x(dim);
+        for (auto& w : matrix) w = TernaryWord::FromInt64((int64_t)(trng() % 3) - 1);
+        for (auto& w : x) w = TernaryWord::FromInt64((int64_t)(trng() % 3) - 1);
+        uint64_t weights = (iterations / (dim * dim) + 1) * dim * dim;
+        std::string tag = " " + std::to_string(dim) + "x" + std::to_string(dim);
+
+        results.push_back(Measure("MatVec int64" + tag, weights, [&](uint64_t n) {
+            std::vector<int64_t> xv(dim);
+            uint64_t acc = 0;
+            for (uint64_t k = 0; k < n / (dim * dim); ++k) {
+                for (size_t j = 0; j < dim; ++j) xv[j] = x[j].ToInt64();
+                for (size_t i = 0; i < dim; ++i) {
+                    const TernaryWord* row = &matrix[i * dim];
+                    int64_t sum = 0;
+                    for (size_t j = 0; j < dim; ++j) sum += xv[j] * row[j].ToInt64();
+                    acc += (uint64_t)sum;
+                }
+            }
+            return acc;
+        }));
+        results.push_back(Measure("MatVec bitplane" + tag, weights, [&](uint64_t n) {
+            size_t blocks = TritKernels::BitplaneBlocks(dim);
+            std::vector<uint64_t> xp(blocks), xn(blocks), rp(blocks), rn(blocks);
+            uint64_t acc = 0;
+            for (uint64_t k = 0; k < n / (dim * dim); ++k) {
+                TritKernels::PackSingleTrit(x.data(), dim, xp.data(), xn.data());
+                for (size_t i = 0; i < dim; ++i) {
+                    TritKernels::PackSingleTrit(&matrix[i * dim], dim, rp.data(), rn.data());
+                    acc += (uint64_t)TritKernels::BitplaneDot(xp.data(), xn.data(), rp.data(), rn.data(), blocks);
+                }
+            }
+            return acc;
+        }));
+    }
+
+    std::cout << "\nResults (" << iterations << " iterations):" << std::endl;
+    std::cout << std::left << std::setw(28) << "Operation" << std::setw(15) << "ns/op" << std::endl;
+    std::cout << "-------------------------------------------" << std::endl;
+    for (const auto& r : results) {
+        std::cout << std::left << std::setw(28) << r.name
+                  << std::setw(15) << std::fixed << std::setprecision(2) << r.ns_per_op << std::endl;
+    }
+
+    return 0;
+}
@@ -1,11 +1,19 @@
 #include "../src/cpu.h"
 #include "../src/isa.h"
 #include "../src/trit_word.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <random>
+#include <string>
+#include <thread>
 #include <vector>
 
 // TNN Benchmark: Scalar vs Vector Dot Product
 // Goal: Demonstrate speedup of Dimension=32 Dot Product
+// Usage: tnn_benchmark [max_threads]   (VMMUL scaling, default: host cores)
 
 // Helper to encode instruction
 TernaryWord Encode(int opcode, int mode, int rd, int rs1, int rs2_imm) {
@@ -18,7 +26,7 @@ TernaryWord Encode(int opcode, int mode, int rd, int rs1, int rs2_imm) {
     return word;
 }
 
-int main() {
+int main(int argc, char** argv) {
     TernaryMemory mem; 
     Cpu cpu(mem);
     
@@ -189,5 +197,61 @@ int main() {
     std::cout << "[Fused: VMMSGN] Active Cycles: " << fused_cycles << std::endl;
     std::cout << "Cycle Savings: " << (unfused_cycles - fused_cycles) << " cycles per layer." << std::endl;
     
+    // ------------------------------------------
+    // 4. VMMUL Thread Scaling
+    // ------------------------------------------
+    // Square layers in cognitive memory, single-trit weights (bitplane path)
+    // and 5-level weights (int64 path), host time per VMMUL for 1..N worker
+    // threads. The output vector must not depend on the thread count.
+    int max_threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    if (argc >= 2) max_threads = std::max(1, std::atoi(argv[1]));
+    std::cout << "\n--- VMMUL Thread Scaling (host cores: " << std::thread::hardware_concurrency() << ") ---" << std::endl;
+    std::cout << std::left << std::setw(24) << "Layer" << std::setw(10) << "Threads" << std::setw(14) << "us/VMMUL"
+              << std::setw(10) << "Speedup" << std::endl;
+    const int64_t layer_vec = 0x3000, layer_matrix = 0x9000; // Clear of the UART at 0x8000
+    for (int dim : { 256, 512, 1024 }) {
+        for (int levels : { 3, 5 }) {
+            TernaryMemory lmem;
+            Cpu lcpu(lmem);
+            std::mt19937 rng(dim);
+            for (int i = 0; i < dim; ++i) lmem.Write(layer_vec + i, TernaryWord::FromInt64((int64_t)(rng() % 3) - 1));
+            for (int64_t i = 0; i < (int64_t)dim * dim; ++i) {
+                lmem.Write(layer_matrix + i, TernaryWord::FromInt64((int64_t)(rng() % levels) - levels / 2));
+            }
+            lcpu.regs[1].SetInt(layer_vec);
+            lcpu.regs[2].SetInt(layer_matrix);
+            lcpu.vector_length = dim;
+            lmem.Write(TernaryWord::FromInt64(0), Encode((int)Opcode::VLDR, 0, 0, 0, 1));  // VLDR V0, R1
+            lmem.Write(TernaryWord::FromInt64(1), Encode((int)Opcode::VMMUL, 0, 1, 0, 2)); // VMMUL V1, V0, R2
+            lcpu.Step(2); // Load, and one untimed VMMUL
+
+            std::string layer = std::to_string(dim) + "x" + std::to_string(dim) + (levels == 3 ? " ternary" : " 5-level");
+            double base_us = 0;
+            std::vector<TernaryWord> reference;
+            for (int t = 1; t <= max_threads; ++t) {
+                lcpu.vector_threads = t;
+                int reps = std::max(8, (1 << 23) / (dim * dim));
+                auto start = std::chrono::steady_clock::now();
+                for (int r = 0; r < reps; ++r) {
+                    lcpu.pc = TernaryWord::FromInt64(1);
+                    lcpu.Step(1);
+                }
+                double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / reps;
+                if (t == 1) base_us = us;
+
+                std::vector<TernaryWord> result(dim);
+                for (int i = 0; i < dim; ++i) result[i] = lcpu.vec_regs.Get(1, i);
+                if (t == 1) reference = result;
+                bool same = true;
+                for (int i = 0; i < dim; ++i) same = same && result[i].pos == reference[i].pos && result[i].neg == reference[i].neg;
+
+                std::cout << std::left << std::setw(24) << (t == 1 ? layer : "") << std::setw(10) << t
+                          << std::setw(14) << std::fixed << std::setprecision(1) << us
+                          << std::setprecision(2) << base_us / us << "x" << (same ? "" : "  MISMATCH") << std::endl;
+                std::cout.unsetf(std::ios::floatfield);
+            }
+        }
+    }
+    
     return 0;
 }
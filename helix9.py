@@ -48,6 +48,9 @@ class Helix9:
         self.lib.Helix_CPU_Step.argtypes = []
         self.lib.Helix_CPU_Step.restype = None
 
+        self.lib.Helix_CPU_Run.argtypes = [ctypes.c_int, ctypes.POINTER(ctypes.c_int), ctypes.c_int]
+        self.lib.Helix_CPU_Run.restype = ctypes.c_int
+
         self.lib.Helix_CPU_GetPC.argtypes = []
         self.lib.Helix_CPU_GetPC.restype = ctypes.c_int
 
@@ -108,6 +111,13 @@ class Helix9:
     def step(self):
         self.lib.Helix_CPU_Step()
 
+    # Stop reasons returned by run() (Cpu::StopReason)
+    STOP_HALTED, STOP_CYCLE_LIMIT, STOP_BREAKPOINT = 0, 1, 2
+
+    def run(self, max_cycles, breakpoints=()):
+        bps = (ctypes.c_int * len(breakpoints))(*breakpoints)
+        return self.lib.Helix_CPU_Run(max_cycles, bps, len(breakpoints))
+
     def get_pc(self):
         return self.lib.Helix_CPU_GetPC()
 
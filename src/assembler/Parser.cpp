@@ -377,7 +377,9 @@ TernaryWord Parser::EncodeInstruction(const std::string& mnemonic, const std::ve
         
         // Legacy/Other
         {"vec.cns", (int)Opcode::VEC_CNS}, 
-        {"vec.pop", (int)Opcode::VEC_POP}
+        {"vec.pop", (int)Opcode::VEC_POP},
+        {"dec.mask", (int)Opcode::VEC_DEC},
+        {"sat.mac", (int)Opcode::VEC_MAC}
     };
 
 
@@ -581,8 +583,8 @@ TernaryWord Parser::EncodeInstruction(const std::string& mnemonic, const std::ve
         rs1 = ops[1].reg;
         mode = 0;
     }
-    else if (opcode == 30) { // VEC_CNS
-        // vec.cns pd, ps1, ps2
+    else if (opcode == 30 || opcode == 41 || opcode == 42) { // VEC_CNS, DEC.MASK, SAT.MAC
+        // vec.cns pd, ps1, ps2 / dec.mask pd, ps1, ps2 / sat.mac rd, ps1, ps2
         if (ops.size() < 3) { std::cerr << "Error: Vector op requires 3 operands" << std::endl; exit(1); }
         rd = ops[0].reg;
         rs1 = ops[1].reg;
@@ -2,6 +2,12 @@
 #include "neural_net.h"
 #include <iostream>
 
+#ifdef _WIN32
+#define HELIX_EXPORT __declspec(dllexport)
+#else
+#define HELIX_EXPORT __attribute__((visibility("default")))
+#endif
+
 // Global State Holders
 static TernaryMemory* global_mem = nullptr;
 static Cpu* global_cpu = nullptr;
@@ -9,7 +15,7 @@ static TSAI_Model* global_ai = nullptr;
 
 extern "C" {
     // --- CPU API ---
-    __declspec(dllexport) void Helix_CreateCPU() {
+    HELIX_EXPORT void Helix_CreateCPU() {
         if (global_cpu) delete global_cpu;
         if (global_mem) delete global_mem;
         
@@ -20,7 +26,7 @@ extern "C" {
         global_mem->Write(TernaryWord::FromInt64(0), TernaryWord::FromInt64(0)); 
     }
 
-    __declspec(dllexport) void Helix_DestroyCPU() {
+    HELIX_EXPORT void Helix_DestroyCPU() {
         if (global_cpu) {
             delete global_cpu;
             global_cpu = nullptr;
@@ -31,13 +37,13 @@ extern "C" {
         }
     }
 
-    __declspec(dllexport) void Helix_CPU_WriteMem(int addr, int val) {
+    HELIX_EXPORT void Helix_CPU_WriteMem(int addr, int val) {
         if (global_mem) {
             global_mem->Write(TernaryWord::FromInt64(addr), TernaryWord::FromInt64(val));
         }
     }
 
-    __declspec(dllexport) int Helix_CPU_ReadMem(int addr) {
+    HELIX_EXPORT int Helix_CPU_ReadMem(int addr) {
         if (global_mem) {
             TernaryWord w = global_mem->Read(TernaryWord::FromInt64(addr));
             return (int)w.ToInt64();
@@ -45,18 +51,28 @@ extern "C" {
         return 0;
     }
 
-    __declspec(dllexport) void Helix_CPU_Step() {
+    HELIX_EXPORT void Helix_CPU_Step() {
         if (global_cpu) {
-            global_cpu->Step();
+            global_cpu->RunUntil(Cpu::StopConditions(1));
         }
     }
 
-    __declspec(dllexport) int Helix_CPU_GetPC() {
+    // Run up to max_cycles instructions, stopping at HLT or in front of one of
+    // the breakpoints (may be null). Returns the Cpu::StopReason.
+    HELIX_EXPORT int Helix_CPU_Run(int max_cycles, const int* breakpoints, int num_breakpoints) {
+        if (!global_cpu) return (int)Cpu::StopReason::Halted;
+        Cpu::StopConditions stop;
+        stop.max_cycles = max_cycles > 0 ? (uint64_t)max_cycles : 0;
+        for (int i = 0; breakpoints && i < num_breakpoints; ++i) stop.breakpoints.push_back(breakpoints[i]);
+        return (int)global_cpu->RunUntil(stop).reason;
+    }
+
+    HELIX_EXPORT int Helix_CPU_GetPC() {
         if (global_cpu) return (int)global_cpu->pc.ToInt64();
         return 0;
     }
     
-    __declspec(dllexport) int Helix_CPU_GetRegister(int reg_idx) {
+    HELIX_EXPORT int Helix_CPU_GetRegister(int reg_idx) {
         if (global_cpu && reg_idx >= 0 && reg_idx < 16) {
              return (int)global_cpu->regs[reg_idx].ToInt64();
         }
@@ -64,25 +80,25 @@ extern "C" {
     }
 
     // --- AI API ---
-    __declspec(dllexport) void Helix_CreateAI() {
+    HELIX_EXPORT void Helix_CreateAI() {
         if (global_ai) delete global_ai;
         global_ai = new TSAI_Model();
     }
     
-    __declspec(dllexport) void Helix_AI_AddLayer(int in, int out, double sparsity) {
+    HELIX_EXPORT void Helix_AI_AddLayer(int in, int out, double sparsity) {
         if (global_ai) {
              global_ai->AddLayer(in, out, sparsity);
         }
     }
     
-    __declspec(dllexport) void Helix_AI_SetLR(double lr) {
+    HELIX_EXPORT void Helix_AI_SetLR(double lr) {
         if (global_ai) global_ai->learning_rate = lr;
     }
 
     // Pass arrays from Python: double* inputs, int size
     // WARNING: This applies updates immediately after each sample (Batch Size 1)
     // For better training, use Helix_AI_TrainStep + Helix_AI_ApplyUpdates
-    __declspec(dllexport) double Helix_AI_Train(double* inputs, int in_size, double* targets, int out_size) {
+    HELIX_EXPORT double Helix_AI_Train(double* inputs, int in_size, double* targets, int out_size) {
         if (!global_ai) return 0.0;
         
         std::vector<TernaryFloat> in_vec;
@@ -106,7 +122,7 @@ extern "C" {
     }
     
     // NEW: Accumulate gradients without applying (for batching)
-    __declspec(dllexport) void Helix_AI_TrainStep(double* inputs, int in_size, double* targets, int out_size) {
+    HELIX_EXPORT void Helix_AI_TrainStep(double* inputs, int in_size, double* targets, int out_size) {
         if (!global_ai) return;
         
         std::vector<TernaryFloat> in_vec;
@@ -119,11 +135,11 @@ extern "C" {
     }
     
     // NEW: Apply accumulated gradients (call after batch of TrainStep calls)
-    __declspec(dllexport) void Helix_AI_ApplyUpdates() {
+    HELIX_EXPORT void Helix_AI_ApplyUpdates() {
         if (global_ai) global_ai->ApplyUpdates();
     }
     
-    __declspec(dllexport) void Helix_AI_Predict(double* inputs, int in_size, double* outputs, int out_size) {
+    HELIX_EXPORT void Helix_AI_Predict(double* inputs, int in_size, double* outputs, int out_size) {
         if (!global_ai) return;
         
         std::vector<TernaryFloat> in_vec;
@@ -139,7 +155,7 @@ extern "C" {
     // PHASE 3: High-performance training - entire epoch loop in C++
     // all_inputs: flattened array [num_samples * in_size]
     // all_targets: flattened array [num_samples * out_size]
-    __declspec(dllexport) double Helix_AI_Fit(
+    HELIX_EXPORT double Helix_AI_Fit(
         double* all_inputs,
         double* all_targets,
         int num_samples,
@@ -60,7 +60,7 @@ void Scheduler::ExecuteAgent(std::shared_ptr<Agent> agent) {
     // 2. CONTEXT SWITCH
     // Save System Context (for safety)
     TernaryWord system_pc = cpu.pc;
-    TernaryWord system_status = cpu.status;
+    StatusWord system_status = cpu.status; // Keeps any pending flags as-is
     std::vector<TernaryWord> system_regs(16);
     for(int i=0; i<16; ++i) system_regs[i] = cpu.regs[i];
 
@@ -74,7 +74,7 @@ void Scheduler::ExecuteAgent(std::shared_ptr<Agent> agent) {
     
     // 4. UPDATE AGENT STATE
     agent->pc = cpu.pc.ToInt64();
-    agent->status = cpu.status.ToInt64();
+    agent->status = cpu.status.ToInt64(); // Evaluates pending flags
     for(int i=0; i<16; ++i) {
         agent->regs[i] = cpu.regs[i].ToInt64();
     }
@@ -18,17 +18,9 @@ void StabilityMonitor::SetFluxThreshold(double threshold) {
 void StabilityMonitor::CaptureState(const Agent& agent, TernaryMemory& mem) {
     // 1. Snapshot Belief Page
     if (mem.IsPageAllocated(agent.belief_page_start)) {
-        // We need a deep copy of the page
-        // Since Memory doesn't expose raw pointer easily, we read words.
-        // Actually, we can use the friend access or just copy words if we add a Helper.
-        // For now, let's assume we can get the page or read it word-by-word.
-        // Optimization: Memory needs a GetPageCopy method?
-        // Or we just iterate.
-        
+        // Deep copy of the page, read as one block
         Page current_page;
-        for(int i=0; i<PAGE_SIZE; ++i) {
-            current_page.words[i] = mem.Read(TernaryWord::FromInt64(agent.belief_page_start * PAGE_SIZE + i));
-        }
+        mem.ReadBlock(agent.belief_page_start * PAGE_SIZE, current_page.words.data(), PAGE_SIZE);
 
         // 2. Calculate Flux vs Previous
         if (last_belief_state.count(agent.id)) {
@@ -16,13 +16,12 @@ namespace CognitiveTrace {
 
         out << "Offset,Value,Trits\n";
         
-        // We need to access the page data. 
-        // TernaryMemory doesn't expose raw pointer easily, but we can Read loop.
-        // Or friend class? For now, Read loop is fine for debug tools.
-        int64_t base_addr = page_id * PAGE_SIZE; // 256 words
+        // One block read of the page (256 words), as Read would see it
+        TernaryWord words[PAGE_SIZE];
+        mem.ReadBlock(page_id * PAGE_SIZE, words, PAGE_SIZE);
         
         for (int i = 0; i < PAGE_SIZE; ++i) {
-            TernaryWord w = mem.Read(TernaryWord::FromInt64(base_addr + i));
+            const TernaryWord& w = words[i];
             out << i << "," << w.ToInt64() << "," << w.ToString() << "\n";
         }
         
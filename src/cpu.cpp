@@ -1,8 +1,10 @@
 #include "cpu.h"
 #include "isa.h"
+#include "jit/jit_x64.h"
+#include "trit_span.h"
+#include "worker_pool.h"
 #include <iostream>
 #include <iomanip>
-#include <bitset>
 
 Cpu::Cpu(TernaryMemory& memory) : mem(memory), halted(false), vec_unit(*this), trace_enabled(false) {
     // Registers are already array-initialized
@@ -10,6 +12,8 @@ Cpu::Cpu(TernaryMemory& memory) : mem(memory), halted(false), vec_unit(*this), t
     status = TernaryWord::FromInt64(0);
 }
 
+Cpu::~Cpu() = default; // JitX64 is complete here
+
 // Helpers
 void Cpu::Trap(int64_t vector_addr) {
     // 1. Push PC (TODO: Stack implementation in Phase 2b)
@@ -20,40 +24,18 @@ void Cpu::Trap(int64_t vector_addr) {
 }
 
 void Cpu::UpdateFlags(const TernaryWord& result) {
-    int64_t val = result.ToInt64();
-    status.SetTrit(0, val == 0 ? 1 : 0); // Z
-    status.SetTrit(1, val > 0 ? 1 : 0);  // P
-    status.SetTrit(2, val < 0 ? 1 : 0);  // N
+    UpdateFlags(result.ToInt64());
 }
 
-void Cpu::UpdateFlagsArithmetic(const TernaryWord& result, bool carry, bool overflow) {
-    UpdateFlags(result);
-    status.SetTrit(3, carry ? 1 : 0);    // C
-    status.SetTrit(4, overflow ? 1 : 0); // O
+void Cpu::UpdateFlagsArithmetic(const TernaryWord& result, int8_t carry, bool overflow) {
+    UpdateFlagsArithmetic(result.ToInt64(), carry, overflow);
 }
 
-uint64_t Cpu::Step(uint64_t max_cycles) {
-    uint64_t cycles_executed = 0;
-    while (!halted && cycles_executed < max_cycles) {
-        // --- FETCH ---
-        TernaryWord instruction_word = mem.Read(pc);
-        
-        // Increment PC (Sequential execution)
-        pc = pc.Add(TernaryWord::FromInt64(1));
-
-        // ... Rest of Decode/Execute ...
-
-    // --- DECODE ---
+void Cpu::Decode(const TernaryWord& instruction_word, DecodedInst& out) {
     // Format: [Opcode(6)][Mode(3)][Rd(4)][Rs1(4)][Rs2/Imm(10)]
     // Indices: 21..26, 18..20, 14..17, 10..13, 0..9
-    
-    int64_t op_val = instruction_word.Slice(21, 6);
-    Opcode opcode = static_cast<Opcode>(op_val);
-
-    int64_t mode = instruction_word.Slice(18, 3);
     int64_t rd_idx = instruction_word.Slice(14, 4);
     int64_t rs1_idx = instruction_word.Slice(10, 4);
-    // int64_t rs2_idx = instruction_word.Slice(0, 4); // Not strictly used if Imm
     int64_t imm_val = instruction_word.Slice(0, 10); // Rs2/Imm overlaps
     int64_t rs2_idx = imm_val; // For Reg mode, we treat lower bits as Reg index (0-15)
 
@@ -62,194 +44,260 @@ uint64_t Cpu::Step(uint64_t max_cycles) {
     if (rs1_idx < 0 || rs1_idx > 15) rs1_idx = 0;
     if (rs2_idx < 0 || rs2_idx > 15) rs2_idx = 0;
 
-    TernaryWord& Rd = regs[rd_idx];
-    const TernaryWord& Rs1 = regs[rs1_idx];
-    const TernaryWord& Rs2 = regs[rs2_idx];
-    TernaryWord Imm = TernaryWord::FromInt64(imm_val); 
-    
-    // Resolve Second Operand (Register or Immediate)
-    TernaryWord Op2 = (mode == 1) ? Imm : regs[rs2_idx];
-    if (mode == 1) {
-         // Immediate Mode
-         Op2 = Imm;
-    } else {
-         // Register Mode (0)
-         // Note: Parser uses Mode 1 for Imm. Mode 0 for Reg.
-         Op2 = regs[rs2_idx];
+    out.op = (int16_t)instruction_word.Slice(21, 6);
+    out.handler = (out.op >= 0 && out.op < OPCODE_SLOTS) ? (uint8_t)out.op : (uint8_t)OPCODE_SLOTS;
+    out.mode = (int8_t)instruction_word.Slice(18, 3);
+    out.rd = (int8_t)rd_idx;
+    out.rs1 = (int8_t)rs1_idx;
+    out.rs2 = (int8_t)rs2_idx;
+    out.imm_val = imm_val;
+    out.imm = TernaryWord::FromInt64(imm_val);
+    out.breakpoint = false;
+}
+
+const Cpu::DecodedInst& Cpu::Fetch(DecodedInst& scratch) {
+    int64_t addr = pc.ToInt64();
+    if (decode_cache_enabled && addr >= 0 && addr < TernaryMemory::SYSTEM_SIZE) {
+        if (decode_cache.empty()) decode_cache.resize(TernaryMemory::SYSTEM_SIZE / PAGE_SIZE);
+        std::unique_ptr<DecodedInst[]>& page = decode_cache[addr / PAGE_SIZE];
+        if (!page) page.reset(new DecodedInst[PAGE_SIZE]);
+        DecodedInst& entry = page[addr % PAGE_SIZE];
+        uint64_t version = mem.CodeVersion(addr);
+        if (entry.version != version) {
+            Decode(mem.Read(addr), entry);
+            entry.version = version;
+            entry.breakpoint = IsBreakpoint(addr);
+        }
+        return entry;
     }
+    // Cognitive pages / out of range: decode in place
+    Decode(mem.Read(addr), scratch);
+    scratch.breakpoint = IsBreakpoint(addr);
+    return scratch;
+}
 
-    // --- EXECUTE ---
-    
-    // Capture state for Flip calculation
-    TernaryWord old_rd_val = regs[rd_idx];
-    TernaryWord new_rd_val = old_rd_val; // Default if not modified
-    bool writeback = false;
+uint64_t Cpu::Step(uint64_t max_cycles) {
+    // Threaded (cpu_threaded.cpp) and block (cpu_blocks.cpp) cores. Traced
+    // Block/Jit steps and binary-traced or profiled steps (any core, guest or
+    // host profile) run on the threaded core's tracing instantiation, and so
+    // does the switch core without instrumentation (the None instantiation
+    // has no counting compiled in).
+    mem.ClearWatchHit();
+    bool none = instrumentation == Instrumentation::None;
+    auto run = [&]() {
+        if (trace_recorder || profiler || host_profile) return StepThreaded(max_cycles);
+        if (core == Core::Switch && !none) return StepSwitch(max_cycles);
+        if (core == Core::Threaded || core == Core::Switch || trace_enabled) return StepThreaded(max_cycles);
+        return StepBlocks(max_cycles);
+    };
+    if (!none) return run();
+
+    // Instrumentation::None: whatever the block cores (per block) and
+    // ExecuteOp's slow paths counted is rolled back
+    Metrics entry_metrics = metrics;
+    uint64_t cycles_executed = run();
+    metrics = entry_metrics;
+    return cycles_executed;
+}
 
+uint64_t Cpu::StepSwitch(uint64_t max_cycles) {
+    uint64_t cycles_executed = 0;
+    DecodedInst scratch;
+    while (!halted && cycles_executed < max_cycles) {
+        // --- FETCH / DECODE ---
+        const DecodedInst& inst = Fetch(scratch);
+        if (inst.breakpoint && cycles_executed > 0) break;
+        
+        // Increment PC (Sequential execution)
+        pc.SetInt(RegArith::Wrap(pc.ToInt64() + 1));
+
+        // --- EXECUTE ---
+        Execute(inst);
+        cycles_executed++;
+        if (mem.WatchHit()) break;
+    } // End While Loop
+    return cycles_executed;
+}
+
+void Cpu::TraceInst(const DecodedInst& inst) {
+    std::cout << "[TRACE] cyc=" << metrics.total_cycles 
+              << " pc=" << pc.ToInt64() 
+              << " op=" << inst.op 
+              << " R" << (int)inst.rd << "=" << regs[(int)inst.rd].ToString() 
+              << std::endl;
+}
+
+void Cpu::Execute(const DecodedInst& inst) {
     // Trace Log
-    if (trace_enabled) {
-        std::cout << "[TRACE] cyc=" << metrics.total_cycles 
-                  << " pc=" << pc.ToInt64() 
-                  << " op=" << op_val 
-                  << " R" << rd_idx << "=" << regs[rd_idx].ToString() 
-                  << std::endl;
-    }
+    if (trace_enabled) TraceInst(inst);
 
     metrics.total_cycles++;
     metrics.energy_proxy++; // Base cost per instruction
 
+    ExecuteOp(inst);
+}
+
+void Cpu::ExecuteOp(const DecodedInst& inst) {
+    int64_t op_val = inst.op;
+    Opcode opcode = static_cast<Opcode>(op_val);
+
+    int64_t mode = inst.mode;
+    int64_t rd_idx = inst.rd;
+    int64_t rs1_idx = inst.rs1;
+    int64_t imm_val = inst.imm_val;
+    int64_t rs2_idx = inst.rs2;
+
+    const RegisterWord& Rs1 = regs[rs1_idx];
+    const TernaryWord& Imm = inst.imm;
+    
+    // Resolve Second Operand (Register or Immediate)
+    // Note: Parser uses Mode 1 for Imm. Mode 0 for Reg.
+    // Arithmetic, addresses and branches use the integer shadows; trit-level
+    // ops (logic, cognitive) read the ternary forms.
+    int64_t op2 = (mode == 1) ? imm_val : regs[rs2_idx].ToInt64();
+    const TernaryWord& Op2 = (mode == 1) ? Imm : regs[rs2_idx].Word();
+
     switch (opcode) {
         // System
         case Opcode::NOP: break; // Passive cycle
         case Opcode::HLT: halted = true; std::cout << "[CPU] Halted." << std::endl; break;
-        case Opcode::MSR: status = Rs1; break;
-        case Opcode::MRS: Rd = status; writeback = true; new_rd_val = Rd; break;
+        case Opcode::MSR: status = Rs1.Word(); break;
+        case Opcode::MRS: WriteReg((int)rd_idx, status); break;
 
         // Arithmetic
         case Opcode::ADD: {
             metrics.active_cycles++;
-            if (status.GetTrit(Cpu::BIT_COG) == 1) {
-                Rd = Rs1.SaturatingAdd(Op2);
-            } else {
-                Rd = Rs1.Add(Op2);
-            }
-            UpdateFlagsArithmetic(Rd, false, false); 
-            writeback = true; new_rd_val = Rd;
+            int8_t carry = 0;
+            int64_t res = (status.GetTrit(Cpu::BIT_COG) == 1)
+                ? RegArith::SaturatingAdd(Rs1.ToInt64(), op2, carry)
+                : RegArith::Add(Rs1.ToInt64(), op2, carry);
+            UpdateFlagsArithmetic(res, carry, carry != 0);
+            WriteRegInt((int)rd_idx, res);
             break;
         }
         case Opcode::SUB: {
             metrics.active_cycles++;
-            TernaryWord neg_op2 = Op2.Negate();
-            Rd = Rs1.Add(neg_op2);
-            UpdateFlagsArithmetic(Rd, false, false);
-            writeback = true; new_rd_val = Rd;
+            int8_t carry = 0;
+            int64_t res = RegArith::Add(Rs1.ToInt64(), -op2, carry);
+            UpdateFlagsArithmetic(res, carry, carry != 0);
+            WriteRegInt((int)rd_idx, res);
             break;
         }
         case Opcode::MUL: {
             metrics.active_cycles++;
-            int64_t res = Rs1.ToInt64() * Op2.ToInt64();
-            Rd = TernaryWord::FromInt64(res);
-            UpdateFlagsArithmetic(Rd, false, false); 
-            writeback = true; new_rd_val = Rd;
+            // O: upper product word is non-zero (result exceeds 27 trits)
+            bool overflow = false;
+            int64_t res = RegArith::Multiply(Rs1.ToInt64(), op2, overflow);
+            UpdateFlagsArithmetic(res, 0, overflow);
+            WriteRegInt((int)rd_idx, res);
             break;
         }
         case Opcode::DIV: {
             metrics.active_cycles++;
-            int64_t d = Op2.ToInt64();
-            if (d == 0) { Trap(Cpu::VECTOR_ILLEGAL); break; }
-            int64_t res = Rs1.ToInt64() / d;
-            Rd = TernaryWord::FromInt64(res);
-            UpdateFlagsArithmetic(Rd, false, false);
-            writeback = true; new_rd_val = Rd;
+            int64_t quot = 0, rem = 0;
+            if (!RegArith::DivMod(Rs1.ToInt64(), op2, quot, rem)) { Trap(Cpu::VECTOR_ILLEGAL); break; }
+            UpdateFlagsArithmetic(quot, 0, false);
+            WriteRegInt((int)rd_idx, quot);
             break;
         }
         case Opcode::MOD: {
             metrics.active_cycles++;
-            int64_t d = Op2.ToInt64();
-            if (d == 0) { Trap(Cpu::VECTOR_ILLEGAL); break; }
-            int64_t res = Rs1.ToInt64() % d;
-            Rd = TernaryWord::FromInt64(res);
-            UpdateFlags(Rd);
-            writeback = true; new_rd_val = Rd;
+            int64_t quot = 0, rem = 0;
+            if (!RegArith::DivMod(Rs1.ToInt64(), op2, quot, rem)) { Trap(Cpu::VECTOR_ILLEGAL); break; }
+            UpdateFlags(rem);
+            WriteRegInt((int)rd_idx, rem);
             break;
         }
 
         // Logic
-        case Opcode::AND: metrics.active_cycles++; Rd = Rs1.Min(Op2); UpdateFlags(Rd); writeback = true; new_rd_val = Rd; break;
-        case Opcode::OR:  metrics.active_cycles++; Rd = Rs1.Max(Op2); UpdateFlags(Rd); writeback = true; new_rd_val = Rd; break;
-        case Opcode::XOR: metrics.active_cycles++; Rd = Rs1.XOR(Op2); UpdateFlags(Rd); writeback = true; new_rd_val = Rd; break;
+        case Opcode::AND: { metrics.active_cycles++; TernaryWord res = Rs1.Word().Min(Op2); UpdateFlags(res); WriteReg((int)rd_idx, res); break; }
+        case Opcode::OR:  { metrics.active_cycles++; TernaryWord res = Rs1.Word().Max(Op2); UpdateFlags(res); WriteReg((int)rd_idx, res); break; }
+        case Opcode::XOR: { metrics.active_cycles++; TernaryWord res = Rs1.Word().XOR(Op2); UpdateFlags(res); WriteReg((int)rd_idx, res); break; }
         
-        case Opcode::LSL: metrics.active_cycles++; Rd = Rs1.ShiftLeft(); UpdateFlags(Rd); writeback = true; new_rd_val = Rd; break;
-        case Opcode::LSR: metrics.active_cycles++; Rd = Rs1.ShiftRight(); UpdateFlags(Rd); writeback = true; new_rd_val = Rd; break;
+        case Opcode::LSL: { metrics.active_cycles++; TernaryWord res = Rs1.Word().ShiftLeft(); UpdateFlags(res); WriteReg((int)rd_idx, res); break; }
+        case Opcode::LSR: { metrics.active_cycles++; TernaryWord res = Rs1.Word().ShiftRight(); UpdateFlags(res); WriteReg((int)rd_idx, res); break; }
         
         // Data
         case Opcode::LDW: {
             metrics.active_cycles++;
-            TernaryWord addr = Rs1.Add(Imm);
-            TernaryWord raw_addr = addr;
+            int64_t addr = RegArith::Wrap(Rs1.ToInt64() + imm_val);
             
             // Cognitive Mode Protection (Bit 6)
             if (status.GetTrit(Cpu::BIT_COG) == 1) {
-                int64_t a = addr.ToInt64();
-                if (a < 0x3000 || a > 0x7FFF) {
+                if (addr < 0x3000 || addr > 0x7FFF) {
                     Trap(Cpu::VECTOR_SECURE_FAULT);
                     break;
                 }
-                int64_t base = Rs1.ToInt64();
-                int64_t effective = (base & ~0xFF) | (a & 0xFF);
-                addr = TernaryWord::FromInt64(effective);
+                addr = (Rs1.ToInt64() & ~0xFF) | (addr & 0xFF);
             }
 
-            Rd = mem.Read(addr);
-            writeback = true; new_rd_val = Rd;
+            WriteReg((int)rd_idx, mem.Read(addr));
             break;
         }
         case Opcode::STW: {
             metrics.active_cycles++;
             metrics.energy_proxy++; 
-            TernaryWord addr = Rs1.Add(Imm);
+            int64_t addr = RegArith::Wrap(Rs1.ToInt64() + imm_val);
 
              // Cognitive Mode Protection (Bit 6)
             if (status.GetTrit(Cpu::BIT_COG) == 1) {
-                int64_t a = addr.ToInt64();
-                if (a < 0x3000 || a > 0x7FFF) {
+                if (addr < 0x3000 || addr > 0x7FFF) {
                     Trap(Cpu::VECTOR_SECURE_FAULT);
                     break;
                 }
-                int64_t base = Rs1.ToInt64();
-                int64_t effective = (base & ~0xFF) | (a & 0xFF);
-                addr = TernaryWord::FromInt64(effective);
+                addr = (Rs1.ToInt64() & ~0xFF) | (addr & 0xFF);
             }
 
-            mem.Write(addr, regs[rd_idx]); 
+            mem.Write(addr, regs[rd_idx].Word()); 
             break;
         }
-        case Opcode::MOV: metrics.active_cycles++; Rd = Rs1; writeback = true; new_rd_val = Rd; break;
-        case Opcode::LDI: metrics.active_cycles++; Rd = Imm; writeback = true; new_rd_val = Rd; break;
+        case Opcode::MOV: metrics.active_cycles++; WriteReg((int)rd_idx, Rs1); break;
+        case Opcode::LDI: metrics.active_cycles++; WriteRegInt((int)rd_idx, imm_val); break;
 
         // Control
         case Opcode::JMP: {
             metrics.active_cycles++;
-            TernaryWord base = (mode == 4) ? pc : Rs1;
-            pc = base.Add(Imm); 
+            int64_t base = (mode == 4) ? pc.ToInt64() : Rs1.ToInt64();
+            pc.SetInt(RegArith::Wrap(base + imm_val)); 
             break; 
         }
         case Opcode::BEQ: {
             metrics.active_cycles++;
             if (status.GetTrit(0) == 1) {
-                TernaryWord base = (mode == 4) ? pc : Rs1;
-                pc = base.Add(Imm);
+                int64_t base = (mode == 4) ? pc.ToInt64() : Rs1.ToInt64();
+                pc.SetInt(RegArith::Wrap(base + imm_val));
             }
             break; 
         }
         case Opcode::BNE: {
             metrics.active_cycles++;
             if (status.GetTrit(0) == 0) {
-                TernaryWord base = (mode == 4) ? pc : Rs1;
-                pc = base.Add(Imm);
+                int64_t base = (mode == 4) ? pc.ToInt64() : Rs1.ToInt64();
+                pc.SetInt(RegArith::Wrap(base + imm_val));
             }
             break;
         }
         case Opcode::BGT: {
             metrics.active_cycles++;
             if (status.GetTrit(1) == 1) {
-                TernaryWord base = (mode == 4) ? pc : Rs1;
-                pc = base.Add(Imm);
+                int64_t base = (mode == 4) ? pc.ToInt64() : Rs1.ToInt64();
+                pc.SetInt(RegArith::Wrap(base + imm_val));
             }
             break;
         }
         case Opcode::BLT: {
             metrics.active_cycles++;
             if (status.GetTrit(2) == 1) {
-                TernaryWord base = (mode == 4) ? pc : Rs1;
-                pc = base.Add(Imm);
+                int64_t base = (mode == 4) ? pc.ToInt64() : Rs1.ToInt64();
+                pc.SetInt(RegArith::Wrap(base + imm_val));
             }
             break;
         }
         case Opcode::CALL: {
              metrics.active_cycles++;
              regs[14] = pc; // Store LR
-             TernaryWord base = (mode == 4) ? pc : Rs1;
-             pc = base.Add(Imm); 
+             int64_t base = (mode == 4) ? pc.ToInt64() : Rs1.ToInt64();
+             pc.SetInt(RegArith::Wrap(base + imm_val)); 
              // Reg write to LR (R14) happened. Should calculate flips for LR too? 
              // For PoC, ignore implicit LR flips.
              break;
@@ -259,40 +307,40 @@ uint64_t Cpu::Step(uint64_t max_cycles) {
         case Opcode::CMP: {
              metrics.active_cycles++;
              // Fix: Use Op2 (resolved based on mode) instead of Rs2 (raw register)
-             TernaryWord neg_op2 = Op2.Negate();
-             TernaryWord res = Rs1.Add(neg_op2);
-             UpdateFlagsArithmetic(res, false, false);
+             int8_t carry = 0;
+             int64_t res = RegArith::Add(Rs1.ToInt64(), -op2, carry);
+             UpdateFlagsArithmetic(res, carry, carry != 0);
              break;
         }
 
         // Cognitive (Phase 6)
         case Opcode::CNS: {
             metrics.active_cycles++;
-            Rd = Rs1.Consensus(Op2);
-            UpdateFlags(Rd);
-            writeback = true; new_rd_val = Rd;
+            TernaryWord res = Rs1.Word().Consensus(Op2);
+            UpdateFlags(res);
+            WriteReg((int)rd_idx, res);
             break;
         }
         case Opcode::DEC: {
             metrics.active_cycles++;
-            Rd = Rs1.Decay(Op2); 
-            UpdateFlags(Rd);
-            writeback = true; new_rd_val = Rd;
+            TernaryWord res = Rs1.Word().Decay(Op2); 
+            UpdateFlags(res);
+            WriteReg((int)rd_idx, res);
             break;
         }
         case Opcode::POP: {
             metrics.active_cycles++;
-            int count = Rs1.PopCount();
-            Rd = TernaryWord::FromInt64(count);
-            UpdateFlags(Rd);
-            writeback = true; new_rd_val = Rd;
+            int count = Rs1.Word().PopCount();
+            UpdateFlags((int64_t)count);
+            WriteRegInt((int)rd_idx, count);
             break;
         }
         case Opcode::SAT: {
             metrics.active_cycles++;
-            Rd = Rs1.SaturatingAdd(Op2);
-            UpdateFlagsArithmetic(Rd, false, false);
-            writeback = true; new_rd_val = Rd;
+            int8_t carry = 0;
+            int64_t res = RegArith::SaturatingAdd(Rs1.ToInt64(), op2, carry);
+            UpdateFlagsArithmetic(res, carry, carry != 0);
+            WriteRegInt((int)rd_idx, res);
             break;
         }
 
@@ -307,49 +355,61 @@ uint64_t Cpu::Step(uint64_t max_cycles) {
             metrics.total_cycles += 255;
             vec_unit.PopCount(rd_idx, rs1_idx);
             break;
+        case Opcode::VEC_DEC:
+            metrics.active_cycles += 256;
+            metrics.total_cycles += 255;
+            vec_unit.DecayMask(rd_idx, rs1_idx, rs2_idx);
+            break;
+        case Opcode::VEC_MAC:
+            metrics.active_cycles += 256;
+            metrics.total_cycles += 255;
+            vec_unit.SatMAC(rd_idx, rs1_idx, rs2_idx);
+            break;
         // --- Vector Unit (Phase 8) ---
         case Opcode::VLDR: {
             // VLDR Vd, Op2 (Load Vector from Mem[Op2])
             int v_dest = rd_idx % 4; // Map 16 regs to 4 V-Regs
-            int64_t base_addr = Op2.ToInt64();
+            int64_t base_addr = op2;
+            int vl = ActiveLength();
             
             metrics.active_cycles += vector_length;
-            vec_regs[v_dest].resize(vector_length);
-            for(int i=0; i<vector_length; ++i) {
-                // Phase 9: Use Stride
-                vec_regs[v_dest][i] = mem.Read(TernaryWord::FromInt64(base_addr + (i * stride)));
-            }
+            vec_regs.SetLength(v_dest, vl);
+            mem.ReadStrided(base_addr, stride, vector_transfer, vl); // Phase 9: Use Stride
+            for(int i=0; i<vl; ++i) vec_regs.Set(v_dest, i, vector_transfer[i]);
             if (trace_enabled) std::cout << "  VLDR V" << v_dest << " loaded from " << base_addr << " (stride=" << stride << ")" << std::endl;
             break;
         }
         case Opcode::VSTR: {
             // VSTR Vs (Rd), Base (Op2)
             int v_src = rd_idx % 4;
-            int64_t base_addr = Op2.ToInt64();
+            int64_t base_addr = op2;
+            int n = std::min(ActiveLength(), vec_regs.length[v_src]);
             
             metrics.active_cycles += vector_length;
-            if (v_src < 4 && !vec_regs[v_src].empty()) {
-                for(int i=0; i<vector_length && i < vec_regs[v_src].size(); ++i) {
-                    // VSTR currently assumes compact (stride=1) for simplicity
-                    mem.Write(TernaryWord::FromInt64(base_addr + i), vec_regs[v_src][i]);
-                }
+            if (n > 0) {
+                // VSTR currently assumes compact (stride=1) for simplicity
+                for(int i=0; i<n; ++i) vector_transfer[i] = vec_regs.Get(v_src, i);
+                mem.WriteBlock(base_addr, vector_transfer, n);
                  if (trace_enabled) std::cout << "  VSTR V" << v_src << " stored to " << base_addr << std::endl;
             }
             break;
         }
         case Opcode::VADD: {
-            // VADD Vd, Vs1, Vs2
+            // VADD Vd, Vs1, Vs2 (lane-wise word add, carries dropped)
             int v_d  = rd_idx % 4;
             int v_s1 = rs1_idx % 4;
             int v_s2 = rs2_idx % 4; 
+            int vl = ActiveLength();
             
             metrics.active_cycles += vector_length;
-            vec_regs[v_d].resize(vector_length);
-            for(int i=0; i<vector_length; ++i) {
-                TernaryWord val1 = (i < vec_regs[v_s1].size()) ? vec_regs[v_s1][i] : TernaryWord();
-                TernaryWord val2 = (i < vec_regs[v_s2].size()) ? vec_regs[v_s2][i] : TernaryWord();
-                // Vector ADD on Trits (Integer Add)
-                vec_regs[v_d][i] = val1.Add(val2);
+            vec_regs.SetLength(v_d, vl);
+            const uint32_t *p1 = vec_regs.pos[v_s1], *n1 = vec_regs.neg[v_s1];
+            const uint32_t *p2 = vec_regs.pos[v_s2], *n2 = vec_regs.neg[v_s2];
+            uint32_t *pd = vec_regs.pos[v_d], *nd = vec_regs.neg[v_d];
+            for(int i=0; i<vl; ++i) {
+                TernaryWord sum = TernaryWord(p1[i], n1[i]).Add(TernaryWord(p2[i], n2[i]));
+                pd[i] = sum.pos;
+                nd[i] = sum.neg;
             }
             break;
         }
@@ -357,137 +417,61 @@ uint64_t Cpu::Step(uint64_t max_cycles) {
             // VDOT Rd, Vs1, Vs2
             int v_s1 = rs1_idx % 4;
             int v_s2 = rs2_idx % 4;
+            int vl = ActiveLength();
             
             metrics.active_cycles += vector_length;
             int64_t sum = 0;
-            for(int i=0; i<vector_length; ++i) {
-                 int64_t v1 = (i < vec_regs[v_s1].size()) ? vec_regs[v_s1][i].ToInt64() : 0;
-                 int64_t v2 = (i < vec_regs[v_s2].size()) ? vec_regs[v_s2][i].ToInt64() : 0;
-                 sum += v1 * v2; 
+            // Single-trit operands: popcounts over bitplanes
+            const int BLOCKS = VectorRegisterFile::LANES / 64;
+            uint64_t p1[BLOCKS], n1[BLOCKS], p2[BLOCKS], n2[BLOCKS];
+            if (TritKernels::PackSingleTrit(TritSpan(vec_regs.pos[v_s1], vec_regs.neg[v_s1], vl), p1, n1) &&
+                TritKernels::PackSingleTrit(TritSpan(vec_regs.pos[v_s2], vec_regs.neg[v_s2], vl), p2, n2)) {
+                sum = TritKernels::BitplaneDot(p1, n1, p2, n2, TritKernels::BitplaneBlocks(vl));
+            } else {
+                for(int i=0; i<vl; ++i) {
+                     sum += vec_regs.Get(v_s1, i).ToInt64() * vec_regs.Get(v_s2, i).ToInt64(); 
+                }
             }
-            Rd = TernaryWord::FromInt64(sum);
-            writeback = true; new_rd_val = Rd;
+            WriteRegInt((int)rd_idx, sum);
             break;
         }
         case Opcode::VMMSGN:
         case Opcode::VMMUL: {
              int v_d = rd_idx % 4;
              int v_s = rs1_idx % 4; 
-             int64_t matrix_base = Op2.ToInt64();
+             int64_t matrix_base = op2;
+             int vl = ActiveLength();
              
              metrics.active_cycles += (vector_length * vector_length);
-             vec_regs[v_d].resize(vector_length);
              
-             // Extract source vector to fast array for caching
-             std::vector<int64_t> src_vec(vector_length, 0);
-             for(int j = 0; j < vector_length; ++j) {
-                 src_vec[j] = (j < vec_regs[v_s].size()) ? vec_regs[v_s][j].ToInt64() : 0;
-             }
-             
-             // Register Blocking: Process 4 rows at a time
-             int i = 0;
-             for(; i <= vector_length - 4; i += 4) {
-                 int64_t base0 = matrix_base + ((i+0) * vector_length);
-                 int64_t base1 = matrix_base + ((i+1) * vector_length);
-                 int64_t base2 = matrix_base + ((i+2) * vector_length);
-                 int64_t base3 = matrix_base + ((i+3) * vector_length);
-                 
-                 TernaryWord* ptr0 = mem.GetRawPointer(TernaryWord::FromInt64(base0), vector_length);
-                 TernaryWord* ptr1 = mem.GetRawPointer(TernaryWord::FromInt64(base1), vector_length);
-                 TernaryWord* ptr2 = mem.GetRawPointer(TernaryWord::FromInt64(base2), vector_length);
-                 TernaryWord* ptr3 = mem.GetRawPointer(TernaryWord::FromInt64(base3), vector_length);
-                 
-                 int64_t sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
-                 
-                 if (ptr0 && ptr1 && ptr2 && ptr3) {
-                     // Fast Path: Loop Unrolling & Raw Memory
-                     int j = 0;
-                     for(; j <= vector_length - 4; j += 4) {
-                         sum0 += src_vec[j+0] * ptr0[j+0].ToInt64();
-                         sum1 += src_vec[j+0] * ptr1[j+0].ToInt64();
-                         sum2 += src_vec[j+0] * ptr2[j+0].ToInt64();
-                         sum3 += src_vec[j+0] * ptr3[j+0].ToInt64();
-
-                         sum0 += src_vec[j+1] * ptr0[j+1].ToInt64();
-                         sum1 += src_vec[j+1] * ptr1[j+1].ToInt64();
-                         sum2 += src_vec[j+1] * ptr2[j+1].ToInt64();
-                         sum3 += src_vec[j+1] * ptr3[j+1].ToInt64();
-
-                         sum0 += src_vec[j+2] * ptr0[j+2].ToInt64();
-                         sum1 += src_vec[j+2] * ptr1[j+2].ToInt64();
-                         sum2 += src_vec[j+2] * ptr2[j+2].ToInt64();
-                         sum3 += src_vec[j+2] * ptr3[j+2].ToInt64();
-
-                         sum0 += src_vec[j+3] * ptr0[j+3].ToInt64();
-                         sum1 += src_vec[j+3] * ptr1[j+3].ToInt64();
-                         sum2 += src_vec[j+3] * ptr2[j+3].ToInt64();
-                         sum3 += src_vec[j+3] * ptr3[j+3].ToInt64();
-                     }
-                     // Remainder columns
-                     for(; j < vector_length; ++j) {
-                         sum0 += src_vec[j] * ptr0[j].ToInt64();
-                         sum1 += src_vec[j] * ptr1[j].ToInt64();
-                         sum2 += src_vec[j] * ptr2[j].ToInt64();
-                         sum3 += src_vec[j] * ptr3[j].ToInt64();
-                     }
-                 } else {
-                     // Slow Path (Page Boundaries / Unaligned)
-                     for(int j = 0; j < vector_length; ++j) {
-                         sum0 += src_vec[j] * mem.Read(TernaryWord::FromInt64(base0 + j)).ToInt64();
-                         sum1 += src_vec[j] * mem.Read(TernaryWord::FromInt64(base1 + j)).ToInt64();
-                         sum2 += src_vec[j] * mem.Read(TernaryWord::FromInt64(base2 + j)).ToInt64();
-                         sum3 += src_vec[j] * mem.Read(TernaryWord::FromInt64(base3 + j)).ToInt64();
-                     }
-                 }
-                 
-                 // Instruction Fusion: Apply Activation Immediately
-                 if (op_val == (int64_t)Opcode::VMMSGN) {
-                     sum0 = (sum0 > 0) ? 1 : ((sum0 < 0) ? -1 : 0);
-                     sum1 = (sum1 > 0) ? 1 : ((sum1 < 0) ? -1 : 0);
-                     sum2 = (sum2 > 0) ? 1 : ((sum2 < 0) ? -1 : 0);
-                     sum3 = (sum3 > 0) ? 1 : ((sum3 < 0) ? -1 : 0);
-                 }
-                 
-                 vec_regs[v_d][i+0] = TernaryWord::FromInt64(sum0);
-                 vec_regs[v_d][i+1] = TernaryWord::FromInt64(sum1);
-                 vec_regs[v_d][i+2] = TernaryWord::FromInt64(sum2);
-                 vec_regs[v_d][i+3] = TernaryWord::FromInt64(sum3);
-             }
+             // Sums go here first: Vd may be Vs
+             alignas(64) int64_t out[VectorRegisterFile::LANES];
+             MatVec(v_s, matrix_base, vl, out);
              
-             // Remainder rows
-             for(; i < vector_length; ++i) {
-                 int64_t sum = 0;
-                 int64_t row_base = matrix_base + (i * vector_length);
-                 TernaryWord* ptr = mem.GetRawPointer(TernaryWord::FromInt64(row_base), vector_length);
-                 
-                 if (ptr) {
-                     for(int j = 0; j < vector_length; ++j) {
-                         sum += src_vec[j] * ptr[j].ToInt64();
-                     }
-                 } else {
-                     for(int j = 0; j < vector_length; ++j) {
-                         sum += src_vec[j] * mem.Read(TernaryWord::FromInt64(row_base + j)).ToInt64();
-                     }
-                 }
-                 
-                 if (op_val == (int64_t)Opcode::VMMSGN) {
-                     sum = (sum > 0) ? 1 : ((sum < 0) ? -1 : 0);
-                 }
-                 vec_regs[v_d][i] = TernaryWord::FromInt64(sum);
+             // Instruction Fusion: Apply Activation Immediately
+             if (op_val == (int64_t)Opcode::VMMSGN) {
+                 for(int k = 0; k < vl; ++k) out[k] = (out[k] > 0) - (out[k] < 0);
              }
+             vec_regs.SetLength(v_d, vl);
+             for(int k = 0; k < vl; ++k) vec_regs.Set(v_d, k, TernaryWord::FromInt64(out[k]));
              break;
         }
         case Opcode::VSIGN: {
-            // VSIGN Vd, Vs
+            // VSIGN Vd, Vs: the sign of a balanced ternary word is that of its
+            // top non-zero trit, so comparing the clean planes as integers gives it
             int v_d = rd_idx % 4;
             int v_s = rs1_idx % 4;
+            int vl = ActiveLength();
             
             metrics.active_cycles += vector_length;
-            vec_regs[v_d].resize(vector_length);
-            for(int i=0; i<vector_length; ++i) {
-                int64_t val = (i < vec_regs[v_s].size()) ? vec_regs[v_s][i].ToInt64() : 0;
-                int64_t sign = (val > 0) ? 1 : ((val < 0) ? -1 : 0);
-                vec_regs[v_d][i] = TernaryWord::FromInt64(sign);
+            vec_regs.SetLength(v_d, vl);
+            const uint32_t *ps = vec_regs.pos[v_s], *ns = vec_regs.neg[v_s];
+            uint32_t *pd = vec_regs.pos[v_d], *nd = vec_regs.neg[v_d];
+            for(int i=0; i<vl; ++i) {
+                uint32_t p = ps[i] & ~ns[i] & (uint32_t)TernaryWord::TRIT_MASK;
+                uint32_t n = ns[i] & ~ps[i] & (uint32_t)TernaryWord::TRIT_MASK;
+                pd[i] = p > n;
+                nd[i] = n > p;
             }
             break;
         }
@@ -496,20 +480,21 @@ uint64_t Cpu::Step(uint64_t max_cycles) {
              int v_d = rd_idx % 4;
              int v_s = rs1_idx % 4;
              int64_t limit = imm_val; // From Op2/Imm slice, usually small like 1 or 2.
+             int vl = ActiveLength();
              
              metrics.active_cycles += vector_length;
-             vec_regs[v_d].resize(vector_length);
-             for(int i=0; i<vector_length; ++i) {
-                 int64_t val = (i < vec_regs[v_s].size()) ? vec_regs[v_s][i].ToInt64() : 0;
+             vec_regs.SetLength(v_d, vl);
+             for(int i=0; i<vl; ++i) {
+                 int64_t val = vec_regs.Get(v_s, i).ToInt64();
                  if (val > limit) val = limit;
                  if (val < -limit) val = -limit;
-                 vec_regs[v_d][i] = TernaryWord::FromInt64(val);
+                 vec_regs.Set(v_d, i, TernaryWord::FromInt64(val));
              }
              break;
         }
         case Opcode::VSTRI: {
              // VSTRI Op2 (Imm or Reg)
-             stride = (int)Op2.ToInt64();
+             stride = (int)op2;
              if (stride < 1) stride = 1; // Minimum stride 1
              if (trace_enabled) std::cout << "  VSTRI stride=" << stride << std::endl;
              break;
@@ -520,48 +505,56 @@ uint64_t Cpu::Step(uint64_t max_cycles) {
             Trap(Cpu::VECTOR_ILLEGAL);
             break;
     }
-
-    // Calculate Trit Flips
-    if (writeback) {
-        // XOR gives differences. PopCount gives magnitude of difference.
-        // Wait, XOR logic: (-1,-1)->-1. (+1,+1)->+1.
-        // We want changes.
-        // If A != B -> flip.
-        // Bitwise: packed A XOR packed B?
-        // 01 (+1) vs 01 (+1) -> 00.
-        // 01 (+1) vs 10 (-1) -> 11 (2 bits flip). Is this 1 trit flip or 2?
-        // Conceptually 1 trit changed state.
-        // 01 (+1) vs 00 (0) -> 01 (1 bit flip).
-        
-        // Simpler: Compare raw trits.
-        // Or use Bitwise XOR of packed 2-bit?
-        // metrics.trit_flips += PopCount(PackedA ^ PackedB)
-        // If 01->10 (Flip +to-): 01^10 = 11 (2 bits).
-        // If 00->01 (Flip 0to+): 00^01 = 01 (1 bit).
-        // If 00->10 (Flip 0to-): 00^10 = 10 (1 bit).
-        // So +to- counts as 2 "bit flips" but 1 "trit flip"?
-        // Energy Proxy usually counts physical bit switching events.
-        // So counting bit flips is physically accurate for "Energy".
-        
-        // Let's use XOR of Pos and Neg masks.
-        uint64_t diff_p = old_rd_val.pos ^ new_rd_val.pos;
-        uint64_t diff_n = old_rd_val.neg ^ new_rd_val.neg;
-        int flips = std::bitset<64>(diff_p).count() + std::bitset<64>(diff_n).count();
-        metrics.trit_flips += flips;
-        metrics.energy_proxy += flips;
-    }
-    
-    cycles_executed++;
-    } // End While Loop
-    return cycles_executed;
 }
 
 
-void Cpu::Run(int max_cycles) {
-    uint64_t total = 0;
-    while(total < (uint64_t)max_cycles && !halted) {
-        total += Step(1);
+void Cpu::SetBreakpoints(const std::vector<int64_t>& addrs) {
+    std::unordered_set<int64_t> wanted(addrs.begin(), addrs.end());
+    if (wanted == breakpoints) return;
+    breakpoints.swap(wanted);
+    // Flags live in predecoded instructions and translated blocks
+    FlushDecodeCache();
+    FlushBlockCache();
+}
+
+Cpu::RunResult Cpu::RunUntil(const StopConditions& stop) {
+    SetBreakpoints(stop.breakpoints);
+    if (stop.watches != mem.Watches()) mem.SetWatches(stop.watches);
+
+    RunResult result;
+    uint64_t since_callback = 0;
+    bool callbacks = stop.callback && stop.callback_interval > 0;
+    while (!halted && result.cycles < stop.max_cycles) {
+        // One countdown per Step: the rest of the budget, cut at the next callback
+        uint64_t budget = stop.max_cycles - result.cycles;
+        if (callbacks && budget > stop.callback_interval - since_callback) {
+            budget = stop.callback_interval - since_callback;
+        }
+        uint64_t executed = Step(budget);
+        result.cycles += executed;
+        since_callback += executed;
+
+        if (mem.WatchHit()) {
+            result.reason = StopReason::Watchpoint;
+            result.address = mem.WatchAddress();
+            return result;
+        }
+        if (callbacks && since_callback >= stop.callback_interval) {
+            since_callback = 0;
+            if (!stop.callback(*this)) {
+                result.reason = StopReason::Callback;
+                return result;
+            }
+        }
+        // Stopped in front of a breakpoint (or a Step boundary landed on one)
+        if (!halted && IsBreakpoint(pc.ToInt64()) && executed > 0) {
+            result.reason = StopReason::Breakpoint;
+            result.address = pc.ToInt64();
+            return result;
+        }
     }
+    result.reason = halted ? StopReason::Halted : StopReason::CycleLimit;
+    return result;
 }
 
 void Cpu::DumpRegisters() {
@@ -584,106 +577,101 @@ void Cpu::DumpMetrics() {
               << " Active: " << metrics.active_cycles
               << " Energy: " << metrics.energy_proxy 
               << " Flips: " << metrics.trit_flips << std::endl;
+    if (host_profile) host_profile->Print(std::cout);
 }
 
 // Phase 7: Vector Unit Implementations
-void Cpu::VectorUnit::Consensus(int64_t pd_idx, int64_t ps1_idx, int64_t ps2_idx) {
-    int64_t pd_base = cpu.regs[pd_idx].ToInt64() & ~0xFF;
-    int64_t ps1_base = cpu.regs[ps1_idx].ToInt64() & ~0xFF;
-    int64_t ps2_base = cpu.regs[ps2_idx].ToInt64() & ~0xFF;
+// The ops run on the source pages' words in place (TernaryMemory::ReadPage,
+// null = reads as zeros) with the interleaved-word TritKernels, build the
+// result page in cpu.vector_transfer and store it with one WriteBlock, so
+// allocation, permissions and code versions behave as 256 Writes would.
+// Pages are selected by the register value rounded down to a page boundary.
+// A source page that is not an allocated cognitive page takes the zero-page
+// shortcut: the op does not read it.
+namespace {
+inline int64_t PageBase(const Cpu& cpu, int64_t idx) { return cpu.regs[idx].ToInt64() & ~(PAGE_SIZE - 1); }
+}
 
-    int64_t page_pd = pd_base / 256;
-    int64_t page_ps1 = ps1_base / 256;
-    int64_t page_ps2 = ps2_base / 256;
+void Cpu::VectorUnit::Consensus(int64_t pd_idx, int64_t ps1_idx, int64_t ps2_idx) {
+    int64_t pd_base = PageBase(cpu, pd_idx);
+    int64_t ps1_base = PageBase(cpu, ps1_idx);
+    int64_t ps2_base = PageBase(cpu, ps2_idx);
 
-    bool p1_exists = cpu.mem.IsPageAllocated(page_ps1);
-    bool p2_exists = cpu.mem.IsPageAllocated(page_ps2);
+    bool p1_exists = cpu.mem.IsPageAllocated(ps1_base / PAGE_SIZE);
+    bool p2_exists = cpu.mem.IsPageAllocated(ps2_base / PAGE_SIZE);
+    TernaryWord* out = cpu.vector_transfer;
 
     // Optimization: If both sources null, result is null (Consensus(0,0)=0).
     if (!p1_exists && !p2_exists) {
-         // If Dest is allocated, we must clear it.
-         // If Dest is NOT allocated, writing 0s is a no-op (handled by Write).
-         // So we only need to loop if Dest exists.
-         if (cpu.mem.IsPageAllocated(page_pd)) {
-             for (int i = 0; i < 256; ++i) {
-                 cpu.mem.Write(TernaryWord::FromInt64(pd_base + i), TernaryWord::FromInt64(0));
-             }
+         // Only an allocated Dest needs clearing: writing 0s elsewhere is a no-op
+         if (cpu.mem.IsPageAllocated(pd_base / PAGE_SIZE)) {
+             std::fill(out, out + PAGE_SIZE, TernaryWord());
+             cpu.mem.WriteBlock(pd_base, out, PAGE_SIZE);
          }
          return; 
     }
 
-    for (int i = 0; i < 256; ++i) {
-        TernaryWord s1 = cpu.mem.Read(TernaryWord::FromInt64(ps1_base + i));
-        TernaryWord s2 = cpu.mem.Read(TernaryWord::FromInt64(ps2_base + i));
-        TernaryWord res = s1.Consensus(s2);
-        cpu.mem.Write(TernaryWord::FromInt64(pd_base + i), res);
-    }
+    const TernaryWord* s1 = cpu.mem.ReadPage(ps1_base / PAGE_SIZE);
+    const TernaryWord* s2 = cpu.mem.ReadPage(ps2_base / PAGE_SIZE);
+    if (s1 && s2) TritKernels::Consensus(out, s1, s2, PAGE_SIZE);
+    else if (s1 || s2) std::copy(s1 ? s1 : s2, (s1 ? s1 : s2) + PAGE_SIZE, out); // Consensus with 0 is identity
+    else std::fill(out, out + PAGE_SIZE, TernaryWord());
+    cpu.mem.WriteBlock(pd_base, out, PAGE_SIZE);
 }
 
 void Cpu::VectorUnit::PopCount(int64_t rd_idx, int64_t ps1_idx) {
-     int64_t ps1_base = cpu.regs[ps1_idx].ToInt64() & ~0xFF;
-     int64_t page_ps1 = ps1_base / 256;
-     
-     if (!cpu.mem.IsPageAllocated(page_ps1)) {
-         cpu.regs[rd_idx] = TernaryWord::FromInt64(0);
-         cpu.UpdateFlags(cpu.regs[rd_idx]);
-         return;
-     }
-
-     int64_t total = 0;
-     for (int i = 0; i < 256; ++i) {
-         TernaryWord val = cpu.mem.Read(TernaryWord::FromInt64(ps1_base + i));
-         total += val.PopCount();
-     }
-     cpu.regs[rd_idx] = TernaryWord::FromInt64(total);
-     cpu.UpdateFlags(cpu.regs[rd_idx]);
+     int64_t page_ps1 = PageBase(cpu, ps1_idx) / PAGE_SIZE;
+     const TernaryWord* s1 = cpu.mem.IsPageAllocated(page_ps1) ? cpu.mem.ReadPage(page_ps1) : nullptr;
+     int64_t total = s1 ? TritKernels::PopCount(s1, PAGE_SIZE) : 0; // At most 27 * 256
+     cpu.regs[rd_idx].SetInt(total);
+     cpu.UpdateFlags(total);
 }
 
 void Cpu::VectorUnit::DecayMask(int64_t pd_idx, int64_t ps1_idx, int64_t ps2_idx) {
-    int64_t pd_base = cpu.regs[pd_idx].ToInt64() & ~0xFF;
-    int64_t ps1_base = cpu.regs[ps1_idx].ToInt64() & ~0xFF;
-    int64_t ps2_base = cpu.regs[ps2_idx].ToInt64() & ~0xFF;
+    int64_t pd_base = PageBase(cpu, pd_idx);
+    int64_t ps1_base = PageBase(cpu, ps1_idx);
+    int64_t ps2_base = PageBase(cpu, ps2_idx);
+    TernaryWord* out = cpu.vector_transfer;
     
-    int64_t page_ps1 = ps1_base / 256;
-    if (!cpu.mem.IsPageAllocated(page_ps1)) {
+    if (!cpu.mem.IsPageAllocated(ps1_base / PAGE_SIZE)) {
         // Source is 0 -> Result is 0.
-        int64_t page_pd = pd_base / 256;
-        if (cpu.mem.IsPageAllocated(page_pd)) {
-             for (int i = 0; i < 256; ++i) {
-                 cpu.mem.Write(TernaryWord::FromInt64(pd_base + i), TernaryWord::FromInt64(0));
-             }
+        if (cpu.mem.IsPageAllocated(pd_base / PAGE_SIZE)) {
+             std::fill(out, out + PAGE_SIZE, TernaryWord());
+             cpu.mem.WriteBlock(pd_base, out, PAGE_SIZE);
         }
         return; 
     }
 
-    for (int i = 0; i < 256; ++i) {
-        TernaryWord s1 = cpu.mem.Read(TernaryWord::FromInt64(ps1_base + i));
-        TernaryWord mask = cpu.mem.Read(TernaryWord::FromInt64(ps2_base + i));
-        TernaryWord res = s1.Decay(mask);
-        cpu.mem.Write(TernaryWord::FromInt64(pd_base + i), res);
-    }
+    const TernaryWord* s1 = cpu.mem.ReadPage(ps1_base / PAGE_SIZE);
+    const TernaryWord* mask = cpu.mem.ReadPage(ps2_base / PAGE_SIZE);
+    if (s1 && mask) TritKernels::Decay(out, s1, mask, PAGE_SIZE);
+    else std::fill(out, out + PAGE_SIZE, TernaryWord()); // A zero mask clears every trit
+    cpu.mem.WriteBlock(pd_base, out, PAGE_SIZE);
 }
 
 void Cpu::VectorUnit::SatMAC(int64_t rd_idx, int64_t ps1_idx, int64_t ps2_idx) {
-    int64_t ps1_base = cpu.regs[ps1_idx].ToInt64() & ~0xFF;
-    int64_t ps2_base = cpu.regs[ps2_idx].ToInt64() & ~0xFF;
+    int64_t ps1_base = PageBase(cpu, ps1_idx);
+    int64_t ps2_base = PageBase(cpu, ps2_idx);
     
-    bool p1_exists = cpu.mem.IsPageAllocated(ps1_base / 256);
-    bool p2_exists = cpu.mem.IsPageAllocated(ps2_base / 256);
+    bool p1_exists = cpu.mem.IsPageAllocated(ps1_base / PAGE_SIZE);
+    bool p2_exists = cpu.mem.IsPageAllocated(ps2_base / PAGE_SIZE);
     
-    if (!p1_exists || !p2_exists) {
-        // 0 * X = 0.
-        cpu.regs[rd_idx] = TernaryWord::FromInt64(0);
-        cpu.UpdateFlags(cpu.regs[rd_idx]);
-        return;
-    }
-
-    int64_t acc = 0;
-    for (int i = 0; i < 256; ++i) {
-        int64_t v1 = cpu.mem.Read(TernaryWord::FromInt64(ps1_base + i)).ToInt64();
-        int64_t v2 = cpu.mem.Read(TernaryWord::FromInt64(ps2_base + i)).ToInt64();
-        acc += v1 * v2; 
+    int64_t acc = 0; // 0 * X = 0
+    const TernaryWord* s1 = p1_exists && p2_exists ? cpu.mem.ReadPage(ps1_base / PAGE_SIZE) : nullptr;
+    const TernaryWord* s2 = p1_exists && p2_exists ? cpu.mem.ReadPage(ps2_base / PAGE_SIZE) : nullptr;
+    if (s1 && s2) {
+        const size_t blocks = PAGE_SIZE / 64;
+        uint64_t p1[blocks], n1[blocks], p2[blocks], n2[blocks];
+        if (TritKernels::PackSingleTrit(s1, PAGE_SIZE, p1, n1) && TritKernels::PackSingleTrit(s2, PAGE_SIZE, p2, n2)) {
+            acc = TritKernels::BitplaneDot(p1, n1, p2, n2, blocks); // |acc| <= 256: never saturates
+        } else {
+            // Word 0 -> 255, each product and each partial sum saturated to the word range
+            for (int i = 0; i < PAGE_SIZE; ++i) {
+                int8_t carry = 0;
+                acc = RegArith::SaturatingAdd(acc, RegArith::SaturatingMultiply(s1[i].ToInt64(), s2[i].ToInt64()), carry);
+            }
+        }
     }
-    cpu.regs[rd_idx] = TernaryWord::FromInt64(acc);
-    cpu.UpdateFlags(cpu.regs[rd_idx]);
+    cpu.regs[rd_idx].SetInt(acc);
+    cpu.UpdateFlags(acc);
 }
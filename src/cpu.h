@@ -1,7 +1,206 @@
 #pragma once
 #include "trit_word.h"
 #include "memory.h"
+#include "isa.h"
 #include <vector>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <string>
+
+struct JitCode;
+class JitX64;
+class WorkerPool;
+namespace ExecTrace { class Recorder; }
+class GuestProfiler;
+
+// Native Register Arithmetic
+// Integer forms of the word-level ALU ops for register values (|v| <= WORD_MAX).
+// Results, carries and overflow match TernaryWord::Add / SaturatingAdd /
+// Multiply / DivMod on the ternary forms, which read (1,1) trits as 0 exactly
+// like ToInt64 does.
+namespace RegArith {
+
+constexpr int64_t WORD_RANGE = TritDetail::Pow3(TernaryWord::NUM_TRITS);
+constexpr int64_t WORD_MAX = (WORD_RANGE - 1) / 2;
+
+// Low 27 balanced trits of v (v mod 3^27), as TernaryWord::FromInt64 keeps
+inline int64_t Wrap(int64_t v) {
+    if (v >= -WORD_MAX && v <= WORD_MAX) return v;
+    return TernaryWord::FromInt64(v).ToInt64();
+}
+
+inline int64_t Add(int64_t a, int64_t b, int8_t& carry) {
+    int64_t s = a + b;
+    carry = (int8_t)((s > WORD_MAX) - (s < -WORD_MAX));
+    return s - carry * WORD_RANGE;
+}
+
+inline int64_t SaturatingAdd(int64_t a, int64_t b, int8_t& carry) {
+    int64_t s = Add(a, b, carry);
+    return carry ? carry * WORD_MAX : s;
+}
+
+// a * b clamped to the word range (a, b in the word range)
+inline int64_t SaturatingMultiply(int64_t a, int64_t b) {
+    double estimate = (double)a * (double)b; // Within 2^-52 of the product, relatively
+    if (estimate > 2.0 * WORD_MAX) return WORD_MAX;
+    if (estimate < -2.0 * WORD_MAX) return -WORD_MAX;
+    int64_t p = a * b; // |p| < 2^44: exact
+    return p > WORD_MAX ? WORD_MAX : (p < -WORD_MAX ? -WORD_MAX : p);
+}
+
+// overflow: the upper product word is non-zero
+inline int64_t Multiply(int64_t a, int64_t b, bool& overflow) {
+    const int64_t small = (int64_t)1 << 31; // |a|, |b| < 2^31: the product fits int64
+    if (a > -small && a < small && b > -small && b < small) {
+        int64_t p = a * b;
+        overflow = (p > WORD_MAX || p < -WORD_MAX);
+        return overflow ? Wrap(p) : p;
+    }
+    TernaryWord high;
+    int64_t low = TernaryWord::FromInt64(a).MultiplyPlanes(TernaryWord::FromInt64(b), high).ToInt64();
+    overflow = (high.pos | high.neg) != 0;
+    return low;
+}
+
+// Truncating division; false on a zero divisor
+inline bool DivMod(int64_t a, int64_t b, int64_t& quotient, int64_t& remainder) {
+    if (b == 0) return false;
+    quotient = a / b;
+    remainder = a % b;
+    return true;
+}
+
+} // namespace RegArith
+
+// Register Word
+// A TernaryWord with a native int64 shadow. The shadow is authoritative for
+// arithmetic, addressing and flags; integer results are stored as the shadow
+// alone and the ternary form is materialized on first use (trit-level ops,
+// flip accounting, callers reading the word). Words written as words keep
+// their exact planes, including non-canonical (1,1) trits.
+class RegisterWord {
+public:
+    RegisterWord() = default;
+    RegisterWord(const TernaryWord& w) { Set(w); }
+    RegisterWord& operator=(const TernaryWord& w) { Set(w); return *this; }
+
+    int64_t ToInt64() const { return value; }
+    const TernaryWord& Word() const {
+        if (!materialized) {
+            word = TernaryWord::FromInt64(value);
+            materialized = true;
+        }
+        return word;
+    }
+    operator const TernaryWord&() const { return Word(); }
+    std::string ToString() const { return Word().ToString(); }
+
+    // True when the word is exactly FromInt64(ToInt64())
+    bool Canonical() const { return canonical; }
+
+    void Set(const TernaryWord& w) {
+        word = w;
+        value = w.ToInt64();
+        materialized = true;
+        canonical = ((w.pos & w.neg) | ((w.pos | w.neg) & ~TernaryWord::TRIT_MASK)) == 0;
+    }
+    // v must be in the 27-trit range (see RegArith::Wrap)
+    void SetInt(int64_t v) {
+        value = v;
+        materialized = false;
+        canonical = true;
+    }
+    // Both forms already known (w == FromInt64(v))
+    void Set(int64_t v, const TernaryWord& w) {
+        value = v;
+        word = w;
+        materialized = true;
+        canonical = true;
+    }
+
+private:
+    int64_t value = 0;
+    mutable TernaryWord word;
+    mutable bool materialized = true;
+    bool canonical = true;
+};
+
+// Status Word
+// The status register with lazily evaluated condition flags. ALU ops record
+// their result (and carry/overflow) instead of writing Z/P/N/C/O; the flag
+// trits are computed when read (branches, MRS, context switches, tracing).
+// Trits 5 and up (IM, COG, ...) are always stored directly.
+class StatusWord {
+public:
+    StatusWord() = default;
+    StatusWord(const TernaryWord& w) : word(w) {}
+    StatusWord& operator=(const TernaryWord& w) {
+        word = w;
+        zpn_pending = co_pending = false;
+        return *this;
+    }
+
+    // Flag-producing results
+    void SetResult(int64_t v) {
+        result = v;
+        zpn_pending = true;
+    }
+    void SetArithmetic(int64_t v, int8_t c, bool o) {
+        result = v;
+        carry = c;
+        overflow = o;
+        zpn_pending = co_pending = true;
+    }
+
+    int8_t GetTrit(int index) const {
+        switch (index) {
+            case 0: if (zpn_pending) return result == 0; break;
+            case 1: if (zpn_pending) return result > 0; break;
+            case 2: if (zpn_pending) return result < 0; break;
+            case 3: if (co_pending) return carry; break;
+            case 4: if (co_pending) return overflow; break;
+            default: break;
+        }
+        return word.GetTrit(index);
+    }
+    void SetTrit(int index, int8_t val) {
+        Materialize();
+        word.SetTrit(index, val);
+    }
+
+    const TernaryWord& Word() const {
+        Materialize();
+        return word;
+    }
+    operator const TernaryWord&() const { return Word(); }
+    int64_t ToInt64() const { return Word().ToInt64(); }
+    std::string ToString() const { return Word().ToString(); }
+
+private:
+    void Materialize() const {
+        if (zpn_pending) {
+            word.SetTrit(0, result == 0 ? 1 : 0); // Z
+            word.SetTrit(1, result > 0 ? 1 : 0);  // P
+            word.SetTrit(2, result < 0 ? 1 : 0);  // N
+            zpn_pending = false;
+        }
+        if (co_pending) {
+            word.SetTrit(3, carry);               // C (Carry trit out of MSB: -1, 0, +1)
+            word.SetTrit(4, overflow ? 1 : 0);    // O
+            co_pending = false;
+        }
+    }
+
+    mutable TernaryWord word;
+    int64_t result = 0;
+    int8_t carry = 0;
+    bool overflow = false;
+    mutable bool zpn_pending = false; // Z/P/N not yet written to word
+    mutable bool co_pending = false;  // C/O not yet written to word
+};
 
 class Cpu {
 public:
@@ -11,22 +210,60 @@ public:
     // R13 = SP
     // R14 = LR
     // R15 = PC
-    TernaryWord regs[16];
+    // Integer shadow + lazily materialized ternary form (RegisterWord)
+    RegisterWord regs[16];
     
     // Program Counter
-    TernaryWord pc;
+    RegisterWord pc;
     
     // Status Register
     // [0]=Z, [1]=P, [2]=N, [3]=C, [4]=O, [5]=IM
     // [0]=Z, [1]=P, [2]=N, [3]=C, [4]=O, [5]=IM, [6]=COG
-    TernaryWord status; // COG=Cognitive Mode
+    StatusWord status; // COG=Cognitive Mode; flags evaluated on read
     static const int BIT_COG = 6;
 
     // Phase 8: Vector Unit
-    // 4 Vector Registers, dynamic length
-    std::vector<TernaryWord> vec_regs[4];
+    // 4 Vector Registers of up to LANES lanes, held as 64-byte aligned pos/neg
+    // planes (structure of arrays). An op writes lanes [0, VL) of its
+    // destination and clears whatever the register held beyond that, so lanes
+    // past a register's length always read as zero and loops need no bounds checks.
+    struct VectorRegisterFile {
+        static const int LANES = 1024;
+        alignas(64) uint32_t pos[4][LANES] = {};
+        alignas(64) uint32_t neg[4][LANES] = {};
+        int length[4] = {}; // Lanes written by the last op (VSTR stores at most these)
+
+        TernaryWord Get(int v, int i) const { return TernaryWord(pos[v][i], neg[v][i]); }
+        void Set(int v, int i, const TernaryWord& w) {
+            pos[v][i] = w.pos;
+            neg[v][i] = w.neg;
+        }
+        // Call before writing lanes [0, vl) of register v
+        void SetLength(int v, int vl) {
+            for (int i = vl; i < length[v]; ++i) pos[v][i] = neg[v][i] = 0;
+            length[v] = vl;
+        }
+    } vec_regs;
     int vector_length = 32; // Default VL
     int stride = 1;         // Vector Load Stride
+    TernaryWord vector_transfer[VectorRegisterFile::LANES]; // Scratch: VLDR/VSTR words
+    // VL the vector ops run with: vector_length clamped to the register file
+    int ActiveLength() const {
+        return vector_length < 0 ? 0 : (vector_length > VectorRegisterFile::LANES ? VectorRegisterFile::LANES : vector_length);
+    }
+
+    // Parallel VMMUL/VMMSGN (cpu_matvec.cpp)
+    // From VL = vector_parallel_threshold up, the output rows are split into
+    // contiguous ranges across a persistent worker pool of vector_threads
+    // threads, counting the CPU thread (0: one per host core). The pool is
+    // created on first use. Memory is resolved and metrics are accounted on
+    // the CPU thread, and every row is computed whole by one thread, so
+    // results and metrics do not depend on the thread count.
+    int vector_threads = 0;
+    int vector_parallel_threshold = 256;
+    std::unique_ptr<WorkerPool> vector_pool;
+    std::vector<const TernaryWord*> matvec_pages; // Scratch: the matrix's pages
+    void MatVec(int v_s, int64_t matrix_base, int vl, int64_t* out); // out[i] = row i . Vs
 
     
     TernaryMemory& mem;
@@ -47,16 +284,202 @@ public:
 
     bool trace_enabled = false;
 
+    // Binary execution trace (exec_trace.h): while set, Step runs the threaded
+    // core's tracing instantiation, which pushes one record per instruction
+    // instead of printing trace lines. The recorder is owned by the caller.
+    ExecTrace::Recorder* trace_recorder = nullptr;
+
+    // Guest profile (guest_profiler.h): same routing as trace_recorder; every
+    // instruction is counted there. Owned by the caller.
+    GuestProfiler* profiler = nullptr;
+
+    // Host cost attribution (host_profile.h): same routing again; host time per
+    // opcode and per memory path, printed by DumpMetrics. Owned by the caller.
+    HostProfile* host_profile = nullptr;
+    void SetHostProfile(HostProfile* p) {
+        host_profile = p;
+        mem.host_profile = p;
+    }
+
+    // Instrumentation Level
+    // Full: all metrics, including trit-flip accounting on register writeback.
+    // Basic: cycle/active/energy counters without flips (integer results then
+    // never need their ternary form). None: metrics are left untouched.
+    // The threaded core compiles the unused bookkeeping out (cpu_core.h);
+    // with None, Core::Switch runs on it too.
+    enum class Instrumentation { None, Basic, Full };
+    Instrumentation instrumentation = Instrumentation::Full;
+    bool CountsFlips() const { return instrumentation == Instrumentation::Full; }
+
+    // Predecoded Instruction Cache
+    // One entry per system memory address (code lives below 0x3000), allocated a
+    // page at a time on first fetch. An entry is valid while its tag matches the
+    // memory's page generation, so stores, loaders and self-modifying code
+    // invalidate it without Cpu involvement. Code fetched from cognitive pages
+    // is decoded on every fetch.
+    struct DecodedInst {
+        uint64_t version = 0;  // TernaryMemory::CodeVersion at decode time (0 = empty)
+        int64_t imm_val = 0;   // Rs2/Imm field as integer
+        TernaryWord imm;       // Same field, preconverted
+        int16_t op = 0;        // Opcode field (6 trits, may be outside the ISA)
+        uint8_t handler = 0;   // Dispatch slot: op, or OPCODE_SLOTS if op is out of range
+        int8_t mode = 0;
+        int8_t rd = 0;         // Register indices, already clamped to 0..15
+        int8_t rs1 = 0;
+        int8_t rs2 = 0;
+        bool breakpoint = false; // Address is in Cpu::breakpoints (set by Fetch)
+    };
+    std::vector<std::unique_ptr<DecodedInst[]>> decode_cache; // [page][offset]
+    bool decode_cache_enabled = true;
+
+    static const int OPCODE_SLOTS = OPCODE_COUNT; // Opcodes 0..OPCODE_COUNT-1 (isa.h)
+    static_assert(HostProfile::OP_SLOTS == OPCODE_SLOTS + 1, "HostProfile needs a slot per handler");
+
+    static void Decode(const TernaryWord& instruction_word, DecodedInst& out);
+    const DecodedInst& Fetch(DecodedInst& scratch);
+    void FlushDecodeCache() { decode_cache.clear(); }
+
+    // Interpreter Core
+    // Switch: one switch per instruction (reference, supports trace output).
+    // Threaded: per-opcode handlers chained by computed goto (handler table on
+    // compilers without it), instantiated per instrumentation/trace/cognitive
+    // policy (cpu_core.h). Also runs traced Block/Jit steps.
+    // Block: basic blocks of micro-ops cached by entry PC and chained to their
+    // successors; metrics are accounted once per executed block.
+    // Jit: Block, plus hot blocks compiled to x86-64 (jit/jit_x64.cpp). Falls
+    // back to Block when the host has no JIT support.
+    // Architectural state and metrics are identical across cores.
+    enum class Core { Switch, Threaded, Block, Jit };
+    Core core = Core::Switch;
+
+    // Basic-Block Translation Cache (Core::Block, cpu_blocks.cpp)
+    // A block is a straight-line run ending at JMP/BEQ/BNE/BGT/BLT/CALL/RET/HLT
+    // or at the end of its 256-word page, so a single page generation tags it.
+    struct MicroOp {
+        void (*exec)(Cpu&, const DecodedInst&) = nullptr;
+        DecodedInst inst;
+        int64_t next_pc = 0;       // Sequential PC after this op
+        uint32_t active = 0;       // Static active_cycles of ops [0..this]
+        uint32_t energy = 0;       // Static energy_proxy of ops [0..this]
+        bool may_exit = false;     // May trap or write memory: re-check after it
+    };
+    struct Block {
+        int64_t entry = -1;
+        uint64_t version = 0;      // TernaryMemory::CodeVersion at translation
+        std::vector<MicroOp> ops;
+        // Chaining: successor blocks keyed by the PC they start at.
+        // [0] = fall-through (entry + length), [1] = last other exit seen.
+        int64_t link_pc[2] = { -1, -1 };
+        Block* link[2] = { nullptr, nullptr };
+        // JIT: compiled once exec_count reaches jit_threshold
+        bool breakpoint = false;   // Entry is a breakpoint (no other op in the block is)
+        uint32_t exec_count = 0;
+        bool jit_tried = false;
+        const JitCode* jit = nullptr;
+    };
+    std::unordered_map<int64_t, std::unique_ptr<Block>> block_cache;
+    std::unique_ptr<JitX64> jit;
+    uint32_t jit_threshold = 16;
+
+    static const int MAX_BLOCK_OPS = 64;
+    Block* LookupBlock(int64_t addr);
+    void TranslateBlock(Block& block, int64_t addr);
+    uint64_t StepBlocks(uint64_t max_cycles);
+    void FlushBlockCache() { block_cache.clear(); }
+    void FlushJit(); // Drop all compiled code (blocks stay cached)
+
+    // Run Control (RunUntil)
+    // Breakpoints are flagged in predecoded instructions and at block entry
+    // (blocks end in front of one), so the cores test them only where they
+    // already look at the instruction. Watched addresses are checked by
+    // TernaryMemory::Write and tested by the cores after store-capable ops.
+    // A core stops in front of a breakpoint unless it is the first
+    // instruction of the Step, so a stopped run resumes where it stopped.
+    enum class StopReason { Halted, CycleLimit, Breakpoint, Watchpoint, Callback };
+    struct StopConditions {
+        StopConditions() = default;
+        explicit StopConditions(uint64_t budget) : max_cycles(budget) {} // Budget only
+        uint64_t max_cycles = UINT64_MAX;   // Instruction budget
+        std::vector<int64_t> breakpoints;   // Stop before executing these PCs
+        std::vector<int64_t> watches;       // Stop after a write to these addresses
+        uint64_t callback_interval = 0;     // Call back every N instructions (0 = never)
+        std::function<bool(Cpu&)> callback; // Return false to stop the run
+    };
+    struct RunResult {
+        StopReason reason = StopReason::CycleLimit;
+        uint64_t cycles = 0;   // Instructions executed by this call
+        int64_t address = 0;   // Breakpoint PC / watched address that stopped the run
+    };
+    std::unordered_set<int64_t> breakpoints; // Installed set (see SetBreakpoints)
+    void SetBreakpoints(const std::vector<int64_t>& addrs); // Flushes the caches if changed
+    bool IsBreakpoint(int64_t addr) const { return !breakpoints.empty() && breakpoints.count(addr); }
+
 public:
     Cpu(TernaryMemory& memory);
+    ~Cpu();
     
     uint64_t Step(uint64_t max_cycles = 1);
-    void Run(int max_cycles = 100);
+    // Runs until halted or a stop condition fires. The breakpoints and watches
+    // stay installed after it returns (plain Step honors them too) until the
+    // next RunUntil replaces them.
+    RunResult RunUntil(const StopConditions& stop);
+    void Run(int max_cycles = 100) { RunUntil(StopConditions((uint64_t)(max_cycles > 0 ? max_cycles : 0))); }
+
+    // Checkpoints (cpu_snapshot.cpp)
+    // Architectural state, metrics and a copy-on-write memory snapshot (see
+    // TernaryMemory::Snapshot), so taking, restoring and forking never copy
+    // memory words. Host-side settings (core, instrumentation, breakpoints,
+    // tracers, profilers) are not part of it.
+    struct Snapshot {
+        RegisterWord regs[16];
+        RegisterWord pc;
+        StatusWord status;
+        std::vector<TernaryWord> vec_regs[4]; // Written lanes of each register
+        int vector_length = 32;
+        int stride = 1;
+        bool halted = false;
+        Metrics metrics;
+        TernaryMemory::Snapshot memory;
+
+        // Binary file: all-zero system pages are left out, pages without
+        // non-canonical words are PackStream-coded
+        bool Save(const std::string& path) const;
+        bool Load(const std::string& path); // False if missing, truncated or not a snapshot
+    };
+    Snapshot TakeSnapshot();
+    void Restore(const Snapshot& snapshot);
+    // Continues this machine in 'child' (on its own TernaryMemory) from here,
+    // with the same core settings; the two share pages until either writes one.
+    void Fork(Cpu& child);
+
+    // Switch core: Execute accounts the cycle and runs ExecuteOp (pc already advanced)
+    uint64_t StepSwitch(uint64_t max_cycles);
+    void Execute(const DecodedInst& inst);
+    void ExecuteOp(const DecodedInst& inst);
+    uint64_t StepThreaded(uint64_t max_cycles); // Picks the CpuCore<Policy> instantiation
+    void TraceInst(const DecodedInst& inst);     // One [TRACE] line (pc already advanced)
     
     // Helpers
     void Trap(int64_t vector_addr);
+    // Flag updates are recorded in status and evaluated lazily
     void UpdateFlags(const TernaryWord& result);
-    void UpdateFlagsArithmetic(const TernaryWord& result, bool carry, bool overflow);
+    void UpdateFlags(int64_t result);
+    void UpdateFlagsArithmetic(const TernaryWord& result, int8_t carry, bool overflow);
+    void UpdateFlagsArithmetic(int64_t result, int8_t carry, bool overflow);
+
+    // Register writeback with flip accounting (flips: CountsFlips() unless the
+    // caller knows it at compile time)
+    void WriteReg(int r, const TernaryWord& w) { WriteReg(r, w, CountsFlips()); }
+    void WriteReg(int r, const RegisterWord& w) { WriteReg(r, w, CountsFlips()); }
+    void WriteRegInt(int r, int64_t v) { WriteRegInt(r, v, CountsFlips()); }
+    void WriteReg(int r, const TernaryWord& w, bool flips);  // Trit-level result
+    void WriteReg(int r, const RegisterWord& w, bool flips); // Register copy
+    void WriteRegInt(int r, int64_t v, bool flips);          // Integer result (wrapped to 27 trits)
+    void CountFlips(const TernaryWord& old_val, const TernaryWord& new_val) {
+        int flips = TritDetail::CountBits(old_val.pos ^ new_val.pos) + TritDetail::CountBits(old_val.neg ^ new_val.neg);
+        metrics.trit_flips += flips;
+        metrics.energy_proxy += flips;
+    }
 
     // Debug
     void DumpRegisters();
@@ -76,3 +499,31 @@ public:
     } vec_unit;
 };
 
+inline void Cpu::UpdateFlags(int64_t result) {
+    status.SetResult(result);
+}
+
+inline void Cpu::UpdateFlagsArithmetic(int64_t result, int8_t carry, bool overflow) {
+    status.SetArithmetic(result, carry, overflow);
+}
+
+inline void Cpu::WriteReg(int r, const TernaryWord& w, bool flips) {
+    if (flips) CountFlips(regs[r].Word(), w);
+    regs[r].Set(w);
+}
+
+inline void Cpu::WriteReg(int r, const RegisterWord& w, bool flips) {
+    if (flips) CountFlips(regs[r].Word(), w.Word());
+    regs[r] = w;
+}
+
+inline void Cpu::WriteRegInt(int r, int64_t v, bool flips) {
+    v = RegArith::Wrap(v);
+    if (flips) {
+        TernaryWord w = TernaryWord::FromInt64(v);
+        CountFlips(regs[r].Word(), w);
+        regs[r].Set(v, w);
+    } else {
+        regs[r].SetInt(v);
+    }
+}
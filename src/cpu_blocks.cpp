@@ -0,0 +1,152 @@
+#include "cpu.h"
+#include "cpu_handlers.h"
+#include "jit/jit_x64.h"
+
+// Block Core
+// Straight-line runs of predecoded instructions are translated once into
+// micro-op blocks (handler + operands + sequential PC), cached by entry PC and
+// linked to the blocks that follow them, so a hot loop runs block to block
+// without touching the cache map. Static costs are summed at translation time
+// and accounted once per executed block (or block prefix, when a trap, a store
+// into the block's own page or the cycle budget cuts it short).
+
+using namespace CpuHandlers;
+
+static bool EndsBlock(int16_t op) {
+    switch (static_cast<Opcode>(op)) {
+        case Opcode::JMP: case Opcode::BEQ: case Opcode::BNE: case Opcode::BGT: case Opcode::BLT:
+        case Opcode::CALL: case Opcode::RET: case Opcode::HLT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+Cpu::Block* Cpu::LookupBlock(int64_t addr) {
+    // Blocks cover system memory only; cognitive pages run per instruction
+    if (addr < 0 || addr >= TernaryMemory::SYSTEM_SIZE) return nullptr;
+    std::unique_ptr<Block>& slot = block_cache[addr];
+    if (!slot) slot.reset(new Block());
+    return slot.get();
+}
+
+void Cpu::TranslateBlock(Block& block, int64_t addr) {
+    block.entry = addr;
+    block.version = mem.CodeVersion(addr);
+    block.ops.clear();
+    block.link[0] = block.link[1] = nullptr;
+    block.link_pc[1] = -1;
+    block.exec_count = 0;
+    block.jit_tried = false;
+    block.jit = nullptr;
+    block.breakpoint = IsBreakpoint(addr);
+
+    int64_t page_end = (addr / PAGE_SIZE + 1) * PAGE_SIZE;
+    uint32_t active = 0, energy = 0;
+    for (int64_t a = addr; a < page_end && (int)block.ops.size() < MAX_BLOCK_OPS; ++a) {
+        if (a != addr && IsBreakpoint(a)) break; // Becomes the next block's entry
+        MicroOp op;
+        Decode(mem.Read(TernaryWord::FromInt64(a)), op.inst);
+        uint8_t h = op.inst.handler;
+        op.exec = kHandlers[h];
+        op.next_pc = a + 1;
+        active += kActive[h];
+        energy += kEnergy[h];
+        op.active = active;
+        op.energy = energy;
+        op.may_exit = (op.exec == &Op_LDW<CpuPolicy::Runtime> || op.exec == &Op_STW<CpuPolicy::Runtime> ||
+                      op.exec == &Op_Generic<CpuPolicy::Runtime>);
+        block.ops.push_back(op);
+        if (EndsBlock(op.inst.op)) break;
+    }
+    block.link_pc[0] = addr + (int64_t)block.ops.size();
+}
+
+void Cpu::FlushJit() {
+    for (auto& entry : block_cache) {
+        entry.second->exec_count = 0;
+        entry.second->jit_tried = false;
+        entry.second->jit = nullptr;
+    }
+    if (jit) jit->Reset();
+}
+
+uint64_t Cpu::StepBlocks(uint64_t max_cycles) {
+    uint64_t cycles_executed = 0;
+    Block* prev = nullptr;
+
+    // Core::Jit: create the compiler on first use (stays null if unsupported)
+    bool use_jit = (core == Core::Jit) && JitX64::Supported();
+    if (use_jit && !jit) jit.reset(new JitX64());
+    if (use_jit && !jit->Ok()) use_jit = false;
+
+    while (!halted && cycles_executed < max_cycles) {
+        int64_t addr = pc.ToInt64();
+
+        // Follow the previous block's link, else look up (and link) by PC
+        Block* block = nullptr;
+        int slot = -1;
+        if (prev) {
+            slot = (prev->link_pc[0] == addr) ? 0 : 1;
+            if (prev->link_pc[slot] == addr) block = prev->link[slot];
+        }
+        if (!block) {
+            block = LookupBlock(addr);
+            if (!block) {
+                if (cycles_executed > 0 && IsBreakpoint(addr)) break;
+                cycles_executed += StepThreaded(1);
+                if (mem.WatchHit()) break;
+                prev = nullptr;
+                continue;
+            }
+            if (prev) {
+                prev->link_pc[slot] = addr;
+                prev->link[slot] = block;
+            }
+        }
+        if (block->version != mem.CodeVersion(addr)) TranslateBlock(*block, addr);
+        if (block->breakpoint && cycles_executed > 0) break;
+
+        // Execute (at most the remaining budget)
+        size_t n = block->ops.size();
+        if (n > max_cycles - cycles_executed) n = (size_t)(max_cycles - cycles_executed);
+        const MicroOp* ops = block->ops.data();
+        size_t i = 0;
+
+        // Hot block: compile once, then run the native prefix when the whole
+        // block fits the budget. Guards hand the rest back to the loop below.
+        if (use_jit && n == block->ops.size()) {
+            if (!block->jit && !block->jit_tried && ++block->exec_count >= jit_threshold) {
+                block->jit = jit->Compile(*block);
+                if (!block->jit && jit->Full()) {
+                    FlushJit();
+                    block->jit = jit->Compile(*block);
+                }
+                block->jit_tried = true;
+            }
+            if (block->jit) {
+                i = (size_t)jit->Run(*this, *block->jit);
+                // The JIT sets PC only when it ran the block's terminator
+                if (i == n && !block->jit->terminates) pc.SetInt(ops[n - 1].next_pc);
+            }
+        }
+        while (i < n) {
+            const MicroOp& op = ops[i++];
+            pc.SetInt(op.next_pc);
+            op.exec(*this, op.inst);
+            // Trap, a store that rewrote this block's page or hit a watched
+            // address: stop after this op
+            if (op.may_exit && (halted || block->version != mem.CodeVersion(addr) || mem.WatchHit())) break;
+        }
+
+        // Per-block accounting for the executed prefix
+        const MicroOp& last = ops[i - 1];
+        metrics.total_cycles += i;
+        metrics.active_cycles += last.active;
+        metrics.energy_proxy += last.energy;
+        cycles_executed += i;
+        prev = block;
+        if (mem.WatchHit()) break;
+    }
+    return cycles_executed;
+}
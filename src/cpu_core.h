@@ -0,0 +1,42 @@
+#pragma once
+#include "cpu.h"
+
+// Instrumentation Policies
+// A policy fixes at compile time what the threaded core does besides
+// executing instructions:
+//   Level: Cpu::Instrumentation (None / Basic / Full metrics)
+//   Trace: per-instruction trace output (same lines as the switch core),
+//     binary records when Cpu::trace_recorder is set, guest profile counts
+//     when Cpu::profiler is set
+//   Protect: cognitive-mode semantics (saturating ADD, secure LDW/STW). The
+//     unprotected instantiations only run while COG is clear and return to
+//     Cpu::StepThreaded as soon as MSR sets it.
+// Handlers (cpu_handlers.h) ask the policy for Flips(c) and Cognitive(c);
+// Static answers with constants where it can, Runtime reads the Cpu (block
+// core).
+
+namespace CpuPolicy {
+
+struct Runtime {
+    static bool Flips(const Cpu& c) { return c.CountsFlips(); }
+    static bool Cognitive(const Cpu& c) { return c.status.GetTrit(Cpu::BIT_COG) == 1; }
+};
+
+template <Cpu::Instrumentation Level, bool Trace, bool Protect>
+struct Static {
+    static constexpr bool kMetrics = (Level != Cpu::Instrumentation::None);
+    static constexpr bool kTrace = Trace;
+    static constexpr bool kProtect = Protect;
+    static constexpr bool Flips(const Cpu&) { return Level == Cpu::Instrumentation::Full; }
+    static bool Cognitive(const Cpu& c) { return Protect && c.status.GetTrit(Cpu::BIT_COG) == 1; }
+};
+
+} // namespace CpuPolicy
+
+// Threaded core for one Static policy (cpu_threaded.cpp). Cpu::StepThreaded
+// is the runtime factory: it picks the instantiation from instrumentation,
+// trace_enabled and the COG trit.
+template <class Policy>
+struct CpuCore {
+    static uint64_t Step(Cpu& cpu, uint64_t max_cycles);
+};
@@ -0,0 +1,184 @@
+#pragma once
+#include "cpu.h"
+#include "cpu_core.h"
+#include "isa.h"
+#include <iostream>
+
+// Per-Opcode Handlers (internal to the threaded and block cores)
+// Handlers update architectural state and flip accounting only (register
+// writeback through Cpu::WriteReg / WriteRegInt), and are templated on the
+// instrumentation policy (cpu_core.h) that decides flip accounting and COG
+// checks. The static per-instruction costs (total_cycles, base + store
+// energy, active_cycles) are listed in the opcode table so that callers can
+// account them per instruction (threaded core) or once per executed block
+// prefix (block core).
+// DIV/MOD, vector ops and unknown opcodes go through the switch core's
+// ExecuteOp, which does its own active/latency accounting.
+
+#if defined(__GNUC__) || defined(__clang__)
+#define HELIX_HANDLER inline __attribute__((always_inline)) void
+#else
+#define HELIX_HANDLER inline void
+#endif
+
+namespace CpuHandlers {
+
+using Inst = Cpu::DecodedInst;
+
+// Second operand: integer shadow (arithmetic) or ternary form (trit-level ops)
+inline int64_t Op2(const Cpu& c, const Inst& in) {
+    return (in.mode == 1) ? in.imm_val : c.regs[in.rs2].ToInt64();
+}
+inline const TernaryWord& Op2Word(const Cpu& c, const Inst& in) {
+    return (in.mode == 1) ? in.imm : c.regs[in.rs2].Word();
+}
+
+inline void Branch(Cpu& c, const Inst& in) {
+    int64_t base = (in.mode == 4) ? c.pc.ToInt64() : c.regs[in.rs1].ToInt64();
+    c.pc.SetInt(RegArith::Wrap(base + in.imm_val));
+}
+
+// LDW/STW effective address, with the cognitive-mode remap. False -> the
+// address is outside the cognitive window (secure fault).
+template <class P>
+inline bool EffectiveAddress(const Cpu& c, const Inst& in, int64_t& addr) {
+    int64_t base = c.regs[in.rs1].ToInt64();
+    addr = RegArith::Wrap(base + in.imm_val);
+    if (P::Cognitive(c)) {
+        if (addr < 0x3000 || addr > 0x7FFF) return false;
+        addr = (base & ~0xFF) | (addr & 0xFF);
+    }
+    return true;
+}
+
+// Cognitive mode address check/remap for LDW/STW. False -> secure fault raised.
+template <class P>
+inline bool ResolveAddress(Cpu& c, const Inst& in, int64_t& addr) {
+    if (EffectiveAddress<P>(c, in, addr)) return true;
+    c.Trap(Cpu::VECTOR_SECURE_FAULT);
+    return false;
+}
+
+// --- Handlers ---
+
+template <class P> HELIX_HANDLER Op_NOP(Cpu&, const Inst&) {}
+template <class P> HELIX_HANDLER Op_HLT(Cpu& c, const Inst&) { c.halted = true; std::cout << "[CPU] Halted." << std::endl; }
+template <class P> HELIX_HANDLER Op_MSR(Cpu& c, const Inst& in) { c.status = c.regs[in.rs1].Word(); }
+template <class P> HELIX_HANDLER Op_MRS(Cpu& c, const Inst& in) { c.WriteReg(in.rd, c.status, P::Flips(c)); }
+
+template <class P> HELIX_HANDLER Op_ADD(Cpu& c, const Inst& in) {
+    int8_t carry = 0;
+    int64_t res = P::Cognitive(c)
+        ? RegArith::SaturatingAdd(c.regs[in.rs1].ToInt64(), Op2(c, in), carry)
+        : RegArith::Add(c.regs[in.rs1].ToInt64(), Op2(c, in), carry);
+    c.UpdateFlagsArithmetic(res, carry, carry != 0);
+    c.WriteRegInt(in.rd, res, P::Flips(c));
+}
+template <class P> HELIX_HANDLER Op_SUB(Cpu& c, const Inst& in) {
+    int8_t carry = 0;
+    int64_t res = RegArith::Add(c.regs[in.rs1].ToInt64(), -Op2(c, in), carry);
+    c.UpdateFlagsArithmetic(res, carry, carry != 0);
+    c.WriteRegInt(in.rd, res, P::Flips(c));
+}
+template <class P> HELIX_HANDLER Op_MUL(Cpu& c, const Inst& in) {
+    bool overflow = false;
+    int64_t res = RegArith::Multiply(c.regs[in.rs1].ToInt64(), Op2(c, in), overflow);
+    c.UpdateFlagsArithmetic(res, 0, overflow);
+    c.WriteRegInt(in.rd, res, P::Flips(c));
+}
+
+// Logic / Cognitive: Rd = f(Rs1, Op2) on the ternary forms, Z/P/N flags
+#define HELIX_BINARY_HANDLER(NAME, EXPR)                                 \
+    template <class P> HELIX_HANDLER Op_##NAME(Cpu& c, const Inst& in) { \
+        const TernaryWord& a = c.regs[in.rs1].Word();                    \
+        const TernaryWord& b = Op2Word(c, in);                           \
+        (void)b;                                                         \
+        TernaryWord res = (EXPR);                                        \
+        c.UpdateFlags(res);                                              \
+        c.WriteReg(in.rd, res, P::Flips(c));                             \
+    }
+
+HELIX_BINARY_HANDLER(AND, a.Min(b))
+HELIX_BINARY_HANDLER(OR,  a.Max(b))
+HELIX_BINARY_HANDLER(XOR, a.XOR(b))
+HELIX_BINARY_HANDLER(LSL, a.ShiftLeft())
+HELIX_BINARY_HANDLER(LSR, a.ShiftRight())
+HELIX_BINARY_HANDLER(CNS, a.Consensus(b))
+HELIX_BINARY_HANDLER(DEC, a.Decay(b))
+#undef HELIX_BINARY_HANDLER
+
+template <class P> HELIX_HANDLER Op_POP(Cpu& c, const Inst& in) {
+    int64_t count = c.regs[in.rs1].Word().PopCount();
+    c.UpdateFlags(count);
+    c.WriteRegInt(in.rd, count, P::Flips(c));
+}
+template <class P> HELIX_HANDLER Op_SAT(Cpu& c, const Inst& in) {
+    int8_t carry = 0;
+    int64_t res = RegArith::SaturatingAdd(c.regs[in.rs1].ToInt64(), Op2(c, in), carry);
+    c.UpdateFlagsArithmetic(res, carry, carry != 0);
+    c.WriteRegInt(in.rd, res, P::Flips(c));
+}
+
+template <class P> HELIX_HANDLER Op_LDW(Cpu& c, const Inst& in) {
+    int64_t addr;
+    if (!ResolveAddress<P>(c, in, addr)) return;
+    c.WriteReg(in.rd, c.mem.Read(addr), P::Flips(c));
+}
+template <class P> HELIX_HANDLER Op_STW(Cpu& c, const Inst& in) {
+    int64_t addr;
+    if (!ResolveAddress<P>(c, in, addr)) return;
+    c.mem.Write(addr, c.regs[in.rd].Word());
+}
+template <class P> HELIX_HANDLER Op_MOV(Cpu& c, const Inst& in) { c.WriteReg(in.rd, c.regs[in.rs1], P::Flips(c)); }
+template <class P> HELIX_HANDLER Op_LDI(Cpu& c, const Inst& in) { c.WriteRegInt(in.rd, in.imm_val, P::Flips(c)); }
+
+template <class P> HELIX_HANDLER Op_JMP(Cpu& c, const Inst& in) { Branch(c, in); }
+template <class P> HELIX_HANDLER Op_BEQ(Cpu& c, const Inst& in) { if (c.status.GetTrit(0) == 1) Branch(c, in); }
+template <class P> HELIX_HANDLER Op_BNE(Cpu& c, const Inst& in) { if (c.status.GetTrit(0) == 0) Branch(c, in); }
+template <class P> HELIX_HANDLER Op_BGT(Cpu& c, const Inst& in) { if (c.status.GetTrit(1) == 1) Branch(c, in); }
+template <class P> HELIX_HANDLER Op_BLT(Cpu& c, const Inst& in) { if (c.status.GetTrit(2) == 1) Branch(c, in); }
+template <class P> HELIX_HANDLER Op_CALL(Cpu& c, const Inst& in) {
+    c.regs[14] = c.pc; // LR (implicit, no flip accounting - see ExecuteOp)
+    Branch(c, in);
+}
+template <class P> HELIX_HANDLER Op_RET(Cpu& c, const Inst&) { c.pc = c.regs[14]; }
+template <class P> HELIX_HANDLER Op_CMP(Cpu& c, const Inst& in) {
+    int8_t carry = 0;
+    int64_t res = RegArith::Add(c.regs[in.rs1].ToInt64(), -Op2(c, in), carry);
+    c.UpdateFlagsArithmetic(res, carry, carry != 0);
+}
+
+// DIV/MOD (trap path), vector unit, unknown opcodes
+template <class P> HELIX_HANDLER Op_Generic(Cpu& c, const Inst& in) { c.ExecuteOp(in); }
+
+using Handler = void (*)(Cpu&, const Inst&);
+
+// Opcode table indexed by DecodedInst::handler (opcode value; last slot = unknown).
+// kHandlers holds the Runtime-policy handlers used by the block core.
+// X(handler, active_cycles, energy_proxy)
+#define HELIX_OPCODE_TABLE(X)                                                              \
+    X(HLT, 0, 1)     X(NOP, 0, 1)     X(ADD, 1, 1)     X(SUB, 1, 1)     X(MUL, 1, 1)       \
+    X(Generic, 0, 1) X(Generic, 0, 1) X(AND, 1, 1)     X(OR, 1, 1)      X(XOR, 1, 1)       \
+    X(LSL, 1, 1)     X(LSR, 1, 1)     X(MOV, 1, 1)     X(LDI, 1, 1)     X(LDW, 1, 1)       \
+    X(STW, 1, 2)     X(JMP, 1, 1)     X(BEQ, 1, 1)     X(BNE, 1, 1)     X(BGT, 1, 1)       \
+    X(BLT, 1, 1)     X(CALL, 1, 1)    X(RET, 1, 1)     X(MSR, 0, 1)     X(MRS, 0, 1)       \
+    X(CMP, 1, 1)     X(CNS, 1, 1)     X(DEC, 1, 1)     X(POP, 1, 1)     X(SAT, 1, 1)       \
+    X(Generic, 0, 1) X(Generic, 0, 1) X(Generic, 0, 1) X(Generic, 0, 1) X(Generic, 0, 1)   \
+    X(Generic, 0, 1) X(Generic, 0, 1) X(Generic, 0, 1) X(Generic, 0, 1) X(Generic, 0, 1)   \
+    X(Generic, 0, 1) X(Generic, 0, 1) X(Generic, 0, 1)                                      \
+    X(Generic, 0, 1)
+
+#define HELIX_HANDLER_ENTRY(NAME, ACTIVE, ENERGY) &Op_##NAME<CpuPolicy::Runtime>,
+#define HELIX_ACTIVE_ENTRY(NAME, ACTIVE, ENERGY) ACTIVE,
+#define HELIX_ENERGY_ENTRY(NAME, ACTIVE, ENERGY) ENERGY,
+#define HELIX_COUNT_ENTRY(NAME, ACTIVE, ENERGY) +1
+static_assert(0 HELIX_OPCODE_TABLE(HELIX_COUNT_ENTRY) == Cpu::OPCODE_SLOTS + 1, "HELIX_OPCODE_TABLE needs a row per opcode plus the unknown slot");
+inline const Handler kHandlers[Cpu::OPCODE_SLOTS + 1] = { HELIX_OPCODE_TABLE(HELIX_HANDLER_ENTRY) };
+inline const uint8_t kActive[Cpu::OPCODE_SLOTS + 1] = { HELIX_OPCODE_TABLE(HELIX_ACTIVE_ENTRY) };
+inline const uint8_t kEnergy[Cpu::OPCODE_SLOTS + 1] = { HELIX_OPCODE_TABLE(HELIX_ENERGY_ENTRY) };
+#undef HELIX_HANDLER_ENTRY
+#undef HELIX_ACTIVE_ENTRY
+#undef HELIX_ENERGY_ENTRY
+#undef HELIX_COUNT_ENTRY
+
+} // namespace CpuHandlers
@@ -0,0 +1,115 @@
+#include "cpu.h"
+#include "trit_span.h"
+#include "worker_pool.h"
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+const int BLOCKS = Cpu::VectorRegisterFile::LANES / 64;
+const TernaryWord ZERO_PAGE[PAGE_SIZE] = {}; // Pages that read as zeros
+
+// Page holding addr (negative addresses get pages of their own, which read as zero)
+int64_t PageOf(int64_t addr) {
+    return (addr >= 0 ? addr : addr - (PAGE_SIZE - 1)) / PAGE_SIZE;
+}
+
+// The vl words at addr, given the page table from first_page on: in place
+// when their pages lie back to back, else copied into buf
+const TernaryWord* Row(int64_t addr, int vl, int64_t first_page, const TernaryWord* const* pages, TernaryWord* buf) {
+    int64_t page = PageOf(addr);
+    int64_t span = PageOf(addr + vl - 1) - page;
+    int64_t offset = addr - page * PAGE_SIZE;
+    const TernaryWord* const* p = pages + (page - first_page);
+    bool contiguous = true;
+    for (int64_t k = 1; k <= span; ++k) contiguous &= p[k] == p[k - 1] + PAGE_SIZE;
+    if (contiguous) return p[0] + offset;
+
+    int copied = 0;
+    for (int64_t k = 0; copied < vl; ++k) {
+        int64_t from = k == 0 ? offset : 0;
+        int n = (int)std::min<int64_t>(PAGE_SIZE - from, vl - copied);
+        std::copy(p[k] + from, p[k] + from + n, buf + copied);
+        copied += n;
+    }
+    return buf;
+}
+
+} // namespace
+
+void Cpu::MatVec(int v_s, int64_t matrix_base, int vl, int64_t* out) {
+    if (vl <= 0) return;
+
+    // Source, as bitplanes when it is single-trit and as integers for wider rows
+    uint64_t src_p[BLOCKS], src_n[BLOCKS];
+    bool src_bitplane = TritKernels::PackSingleTrit(TritSpan(vec_regs.pos[v_s], vec_regs.neg[v_s], vl), src_p, src_n);
+    size_t blocks = TritKernels::BitplaneBlocks(vl);
+    alignas(64) int64_t src_vec[VectorRegisterFile::LANES];
+    for (int j = 0; j < vl; ++j) src_vec[j] = vec_regs.Get(v_s, j).ToInt64();
+
+    // Page Table
+    // Every page the matrix touches, resolved on this thread through the
+    // read-only page view: weights are never written, so their pages keep
+    // their code generation and stay shared with snapshots. Pages that read
+    // as zeros (unallocated or foreign pages, negative addresses) point at
+    // ZERO_PAGE, so rows see exactly what Read returns and the workers touch
+    // no memory state.
+    int64_t first_page = PageOf(matrix_base);
+    int64_t page_count = PageOf(matrix_base + (int64_t)vl * vl - 1) - first_page + 1;
+    matvec_pages.resize((size_t)page_count);
+    for (int64_t k = 0; k < page_count; ++k) {
+        const TernaryWord* words = mem.ReadPage(first_page + k);
+        matvec_pages[k] = words ? words : ZERO_PAGE;
+    }
+    const TernaryWord* const* pages = matvec_pages.data();
+
+    // Rows [begin, end): popcounts over bitplanes while the weights are
+    // single-trit, int64 multiply-adds from the first wider row on
+    auto rows = [&](int begin, int end_row) {
+        alignas(64) TernaryWord buf[4][VectorRegisterFile::LANES];
+        auto row = [&](int i, int slot) { return Row(matrix_base + (int64_t)i * vl, vl, first_page, pages, buf[slot]); };
+        int i = begin;
+        if (src_bitplane) {
+            uint64_t row_p[BLOCKS], row_n[BLOCKS];
+            for (; i < end_row; ++i) {
+                if (!TritKernels::PackSingleTrit(row(i, 0), vl, row_p, row_n)) break;
+                out[i] = TritKernels::BitplaneDot(src_p, src_n, row_p, row_n, blocks);
+            }
+        }
+        // Register Blocking: 4 rows share each source element
+        for (; i + 4 <= end_row; i += 4) {
+            const TernaryWord *r0 = row(i, 0), *r1 = row(i + 1, 1), *r2 = row(i + 2, 2), *r3 = row(i + 3, 3);
+            int64_t sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+            for (int j = 0; j < vl; ++j) {
+                int64_t x = src_vec[j];
+                sum0 += x * r0[j].ToInt64();
+                sum1 += x * r1[j].ToInt64();
+                sum2 += x * r2[j].ToInt64();
+                sum3 += x * r3[j].ToInt64();
+            }
+            out[i] = sum0;
+            out[i + 1] = sum1;
+            out[i + 2] = sum2;
+            out[i + 3] = sum3;
+        }
+        for (; i < end_row; ++i) {
+            const TernaryWord* r = row(i, 0);
+            int64_t sum = 0;
+            for (int j = 0; j < vl; ++j) sum += src_vec[j] * r[j].ToInt64();
+            out[i] = sum;
+        }
+    };
+
+    if (vl < vector_parallel_threshold) {
+        rows(0, vl);
+        return;
+    }
+    // (hardware_concurrency is not free: only asked for layers this size)
+    int threads = vector_threads > 0 ? vector_threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    if (threads == 1) {
+        rows(0, vl);
+        return;
+    }
+    if (!vector_pool || vector_pool->Threads() != threads) vector_pool.reset(new WorkerPool(threads));
+    vector_pool->ParallelFor(vl, rows);
+}
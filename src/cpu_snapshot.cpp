@@ -0,0 +1,195 @@
+#include "cpu.h"
+#include <algorithm>
+#include <fstream>
+
+Cpu::Snapshot Cpu::TakeSnapshot() {
+    Snapshot s;
+    for (int i = 0; i < 16; ++i) s.regs[i] = regs[i];
+    s.pc = pc;
+    s.status = status;
+    for (int v = 0; v < 4; ++v) {
+        s.vec_regs[v].resize(vec_regs.length[v]);
+        for (int i = 0; i < vec_regs.length[v]; ++i) s.vec_regs[v][i] = vec_regs.Get(v, i);
+    }
+    s.vector_length = vector_length;
+    s.stride = stride;
+    s.halted = halted;
+    s.metrics = metrics;
+    s.memory = mem.TakeSnapshot();
+    return s;
+}
+
+void Cpu::Restore(const Snapshot& s) {
+    for (int i = 0; i < 16; ++i) regs[i] = s.regs[i];
+    pc = s.pc;
+    status = s.status;
+    for (int v = 0; v < 4; ++v) {
+        int length = (int)std::min(s.vec_regs[v].size(), (size_t)VectorRegisterFile::LANES);
+        vec_regs.SetLength(v, length);
+        for (int i = 0; i < length; ++i) vec_regs.Set(v, i, s.vec_regs[v][i]);
+    }
+    vector_length = s.vector_length;
+    stride = s.stride;
+    halted = s.halted;
+    metrics = s.metrics;
+    mem.Restore(s.memory); // Decoded code of replaced pages goes stale with their generation
+}
+
+void Cpu::Fork(Cpu& child) {
+    child.Restore(TakeSnapshot());
+    child.core = core;
+    child.instrumentation = instrumentation;
+    child.decode_cache_enabled = decode_cache_enabled;
+    child.jit_threshold = jit_threshold;
+    child.vector_threads = vector_threads;
+    child.vector_parallel_threshold = vector_parallel_threshold;
+}
+
+// --- Snapshot File ---
+//   "HXSN" + uint32 version
+//   pc, status, R0..R15 (word blocks), halted, vector_length, stride, metrics
+//   4 x (uint32 length + word block)              vector registers
+//   uint32 context, uint32 count + count x (uint32 page, word block)   system pages
+//   uint32 count + count x (int64 page, uint32 owner, uint8 perms, word block)
+// Word block: uint8 encoding, then PackStream bytes (0) or raw pos/neg planes (1).
+// Native byte order, like the execution trace.
+namespace {
+
+const char MAGIC[4] = { 'H', 'X', 'S', 'N' };
+const uint32_t VERSION = 1;
+
+template <class T> void Put(std::ostream& out, const T& v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+template <class T> bool Get(std::istream& in, T& v) {
+    return (bool)in.read(reinterpret_cast<char*>(&v), sizeof(T));
+}
+
+void PutWords(std::ostream& out, const TernaryWord* words, size_t count) {
+    bool canonical = true;
+    for (size_t i = 0; i < count && canonical; ++i) {
+        canonical = ((words[i].pos & words[i].neg) | ((words[i].pos | words[i].neg) & ~TernaryWord::TRIT_MASK)) == 0;
+    }
+    Put<uint8_t>(out, canonical ? 0 : 1);
+    if (canonical) {
+        std::vector<uint8_t> bytes(TernaryWord::PackedStreamBytes(count));
+        TernaryWord::PackStream(words, count, bytes.data());
+        out.write(reinterpret_cast<const char*>(bytes.data()), (std::streamsize)bytes.size());
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            Put(out, words[i].pos);
+            Put(out, words[i].neg);
+        }
+    }
+}
+
+bool GetWords(std::istream& in, TernaryWord* words, size_t count) {
+    uint8_t encoding;
+    if (!Get(in, encoding)) return false;
+    if (encoding == 0) {
+        std::vector<uint8_t> bytes(TernaryWord::PackedStreamBytes(count));
+        if (!in.read(reinterpret_cast<char*>(bytes.data()), (std::streamsize)bytes.size())) return false;
+        TernaryWord::UnpackStream(bytes.data(), count, words);
+        return true;
+    }
+    if (encoding != 1) return false;
+    for (size_t i = 0; i < count; ++i) {
+        if (!Get(in, words[i].pos) || !Get(in, words[i].neg)) return false;
+    }
+    return true;
+}
+
+bool AllZero(const TernaryWord* words, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (words[i].pos | words[i].neg) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool Cpu::Snapshot::Save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(MAGIC, 4);
+    Put(out, VERSION);
+
+    TernaryWord words[18] = { pc.Word(), status.Word() };
+    for (int i = 0; i < 16; ++i) words[2 + i] = regs[i].Word();
+    PutWords(out, words, 18);
+    Put<uint8_t>(out, halted);
+    Put<int32_t>(out, vector_length);
+    Put<int32_t>(out, stride);
+    Put(out, metrics);
+    for (int v = 0; v < 4; ++v) {
+        Put<uint32_t>(out, (uint32_t)vec_regs[v].size());
+        PutWords(out, vec_regs[v].data(), vec_regs[v].size());
+    }
+
+    Put(out, memory.context_id);
+    uint32_t used = 0;
+    for (int p = 0; p < TernaryMemory::SYSTEM_PAGES; ++p) used += !AllZero(memory.system_pages[p].get(), PAGE_SIZE);
+    Put(out, used);
+    for (uint32_t p = 0; p < (uint32_t)TernaryMemory::SYSTEM_PAGES; ++p) {
+        if (AllZero(memory.system_pages[p].get(), PAGE_SIZE)) continue;
+        Put(out, p);
+        PutWords(out, memory.system_pages[p].get(), PAGE_SIZE);
+    }
+    Put<uint32_t>(out, (uint32_t)memory.pages.size());
+    for (const auto& entry : memory.pages) {
+        Put(out, entry.first);
+        Put(out, entry.second->owner_id);
+        Put(out, entry.second->permissions);
+        PutWords(out, entry.second->words.data(), PAGE_SIZE);
+    }
+    return (bool)out;
+}
+
+bool Cpu::Snapshot::Load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[4];
+    uint32_t version;
+    if (!in.read(magic, 4) || !std::equal(magic, magic + 4, MAGIC) || !Get(in, version) || version != VERSION) return false;
+
+    TernaryWord words[18];
+    if (!GetWords(in, words, 18)) return false;
+    pc = words[0];
+    status = words[1];
+    for (int i = 0; i < 16; ++i) regs[i] = words[2 + i];
+    uint8_t halted_byte;
+    int32_t vl, st;
+    if (!Get(in, halted_byte) || !Get(in, vl) || !Get(in, st) || !Get(in, metrics)) return false;
+    halted = halted_byte != 0;
+    vector_length = vl;
+    stride = st;
+    for (int v = 0; v < 4; ++v) {
+        uint32_t length;
+        if (!Get(in, length) || length > (uint32_t)VectorRegisterFile::LANES) return false;
+        vec_regs[v].assign(length, TernaryWord());
+        if (!GetWords(in, vec_regs[v].data(), length)) return false;
+    }
+
+    // System pages share one zeroed block, as in a fresh TernaryMemory
+    std::shared_ptr<TernaryWord> block(new TernaryWord[TernaryMemory::SYSTEM_SIZE], std::default_delete<TernaryWord[]>());
+    for (int p = 0; p < TernaryMemory::SYSTEM_PAGES; ++p) {
+        memory.system_pages[p] = std::shared_ptr<TernaryWord>(block, block.get() + p * PAGE_SIZE);
+    }
+    uint32_t count;
+    if (!Get(in, memory.context_id) || !Get(in, count)) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t p;
+        if (!Get(in, p) || p >= (uint32_t)TernaryMemory::SYSTEM_PAGES) return false;
+        if (!GetWords(in, memory.system_pages[p].get(), PAGE_SIZE)) return false;
+    }
+    memory.pages.clear();
+    if (!Get(in, count)) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        int64_t id;
+        auto page = std::make_shared<Page>();
+        if (!Get(in, id) || !Get(in, page->owner_id) || !Get(in, page->permissions)) return false;
+        if (!GetWords(in, page->words.data(), PAGE_SIZE)) return false;
+        page->shared = true;
+        memory.pages[id] = page;
+    }
+    return true;
+}
@@ -0,0 +1,162 @@
+#include "cpu.h"
+#include "cpu_handlers.h"
+#include "exec_trace.h"
+#include "guest_profiler.h"
+
+// Threaded Interpreter Core
+// Each opcode has its own handler (cpu_handlers.h); the dispatch loop jumps
+// straight from one handler to the next over the predecoded stream instead of
+// funnelling every instruction through Execute's switch. Per-instruction
+// bookkeeping is reduced to the opcode table's static costs plus flip
+// accounting on register writeback, and each CpuCore<Policy> instantiation
+// keeps only the parts its policy enables (cpu_core.h).
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(HELIX_NO_COMPUTED_GOTO)
+#define HELIX_COMPUTED_GOTO 1
+#else
+#define HELIX_COMPUTED_GOTO 0
+#endif
+
+using namespace CpuHandlers;
+
+// Trace policy, before execution: profiler count, then a text line or the
+// pre-execution half of a binary record (PC already advanced); the host
+// profile clock starts last
+template <class Policy>
+static inline void TraceIssue(Cpu& cpu, const Inst& in, ExecTrace::Record& rec) {
+    if (cpu.profiler) cpu.profiler->Issue(RegArith::Wrap(cpu.pc.ToInt64() - 1), in.op);
+    if (cpu.trace_recorder) {
+        rec.cycle = cpu.metrics.total_cycles;
+        rec.pc = RegArith::Wrap(cpu.pc.ToInt64() - 1);
+        rec.op = in.op;
+        rec.rd = in.rd;
+        rec.flags = 0;
+        if (in.handler == (uint8_t)Opcode::LDW || in.handler == (uint8_t)Opcode::STW) {
+            EffectiveAddress<Policy>(cpu, in, rec.mem_addr);
+            rec.flags = ExecTrace::HAS_MEM;
+        }
+    } else if (cpu.trace_enabled) {
+        cpu.TraceInst(in);
+    }
+    if (cpu.host_profile) cpu.host_profile->BeginOp(in.handler);
+}
+
+// Trace policy, after execution: host time, call tracking, complete and push
+// the binary record
+static inline void TraceRetire(Cpu& cpu, ExecTrace::Record& rec) {
+    if (cpu.host_profile) cpu.host_profile->EndOp();
+    if (cpu.profiler) cpu.profiler->Retire(cpu);
+    if (!cpu.trace_recorder) return;
+    rec.rd_value = cpu.regs[rec.rd].ToInt64();
+    cpu.trace_recorder->Push(rec);
+}
+
+template <class Policy>
+uint64_t CpuCore<Policy>::Step(Cpu& cpu, uint64_t max_cycles) {
+    uint64_t cycles_executed = 0;
+    Cpu::DecodedInst scratch;
+    const Cpu::DecodedInst* inst = nullptr;
+    ExecTrace::Record record; // Binary trace: instruction in flight
+
+    // Fetch (stop in front of a breakpoint), advance PC, trace, account the cycle
+    #define ISSUE()                                                      \
+        inst = &cpu.Fetch(scratch);                                      \
+        if (inst->breakpoint && cycles_executed > 0) goto done;          \
+        cpu.pc.SetInt(RegArith::Wrap(cpu.pc.ToInt64() + 1));             \
+        if (Policy::kTrace) TraceIssue<Policy>(cpu, *inst, record);      \
+        if (Policy::kMetrics) {                                          \
+            cpu.metrics.total_cycles++;                                  \
+            cpu.metrics.active_cycles += kActive[inst->handler];         \
+            cpu.metrics.energy_proxy += kEnergy[inst->handler];          \
+        }                                                                \
+        cycles_executed++
+    // Retire the previous instruction (binary trace)
+    #define RETIRE() if (Policy::kTrace && inst) TraceRetire(cpu, record)
+    // Unprotected policy: hand back to the factory once MSR sets COG
+    #define COG_ENTERED() (!Policy::kProtect && cpu.status.GetTrit(Cpu::BIT_COG) == 1)
+
+#if HELIX_COMPUTED_GOTO
+    #define HELIX_LABEL_ENTRY(NAME, ACTIVE, ENERGY) &&L_##NAME,
+    static const void* labels[Cpu::OPCODE_SLOTS + 1] = { HELIX_OPCODE_TABLE(HELIX_LABEL_ENTRY) };
+    #undef HELIX_LABEL_ENTRY
+
+    // Issue the next instruction and jump to its handler
+    #define DISPATCH()                                              \
+        RETIRE();                                                   \
+        if (cpu.halted || cycles_executed >= max_cycles) goto done; \
+        ISSUE();                                                    \
+        goto *labels[inst->handler]
+
+    #define HELIX_LABEL_BODY(NAME) L_##NAME: Op_##NAME<Policy>(cpu, *inst); DISPATCH();
+    // Ops that write memory: stop after one that hit a watched address
+    #define HELIX_STORE_BODY(NAME)                  \
+        L_##NAME:                                   \
+        Op_##NAME<Policy>(cpu, *inst);              \
+        if (cpu.mem.WatchHit()) {                   \
+            RETIRE();                               \
+            goto done;                              \
+        }                                           \
+        DISPATCH();
+
+    DISPATCH();
+    HELIX_LABEL_BODY(HLT) HELIX_LABEL_BODY(NOP) HELIX_LABEL_BODY(MRS)
+    HELIX_LABEL_BODY(ADD) HELIX_LABEL_BODY(SUB) HELIX_LABEL_BODY(MUL)
+    HELIX_LABEL_BODY(AND) HELIX_LABEL_BODY(OR) HELIX_LABEL_BODY(XOR)
+    HELIX_LABEL_BODY(LSL) HELIX_LABEL_BODY(LSR)
+    HELIX_LABEL_BODY(MOV) HELIX_LABEL_BODY(LDI) HELIX_LABEL_BODY(LDW) HELIX_STORE_BODY(STW)
+    HELIX_LABEL_BODY(JMP) HELIX_LABEL_BODY(BEQ) HELIX_LABEL_BODY(BNE) HELIX_LABEL_BODY(BGT)
+    HELIX_LABEL_BODY(BLT) HELIX_LABEL_BODY(CALL) HELIX_LABEL_BODY(RET) HELIX_LABEL_BODY(CMP)
+    HELIX_LABEL_BODY(CNS) HELIX_LABEL_BODY(DEC) HELIX_LABEL_BODY(POP) HELIX_LABEL_BODY(SAT)
+    HELIX_STORE_BODY(Generic)
+L_MSR:
+    Op_MSR<Policy>(cpu, *inst);
+    if (COG_ENTERED()) {
+        RETIRE();
+        goto done;
+    }
+    DISPATCH();
+
+    #undef HELIX_STORE_BODY
+    #undef HELIX_LABEL_BODY
+    #undef DISPATCH
+#else
+    #define HELIX_POLICY_ENTRY(NAME, ACTIVE, ENERGY) &Op_##NAME<Policy>,
+    static const Handler handlers[Cpu::OPCODE_SLOTS + 1] = { HELIX_OPCODE_TABLE(HELIX_POLICY_ENTRY) };
+    #undef HELIX_POLICY_ENTRY
+    while (!cpu.halted && cycles_executed < max_cycles) {
+        ISSUE();
+        handlers[inst->handler](cpu, *inst);
+        RETIRE();
+        if (cpu.mem.WatchHit()) break;
+        if (inst->handler == (uint8_t)Opcode::MSR && COG_ENTERED()) break;
+    }
+#endif
+done:
+    #undef COG_ENTERED
+    #undef RETIRE
+    #undef ISSUE
+    return cycles_executed;
+}
+
+uint64_t Cpu::StepThreaded(uint64_t max_cycles) {
+    // [instrumentation][trace][cognitive protection]
+    using StepFn = uint64_t (*)(Cpu&, uint64_t);
+    #define HELIX_CORE(LEVEL, TRACE, PROTECT) \
+        &CpuCore<CpuPolicy::Static<Instrumentation::LEVEL, TRACE, PROTECT>>::Step
+    #define HELIX_CORES(LEVEL) \
+        { { HELIX_CORE(LEVEL, false, false), HELIX_CORE(LEVEL, false, true) }, \
+          { HELIX_CORE(LEVEL, true, false), HELIX_CORE(LEVEL, true, true) } }
+    static const StepFn cores[3][2][2] = { HELIX_CORES(None), HELIX_CORES(Basic), HELIX_CORES(Full) };
+    #undef HELIX_CORES
+    #undef HELIX_CORE
+
+    // Re-selected when an unprotected core returns early (COG set by MSR)
+    uint64_t cycles_executed = 0;
+    while (!halted && cycles_executed < max_cycles) {
+        if (cycles_executed > 0 && (mem.WatchHit() || IsBreakpoint(pc.ToInt64()))) break;
+        bool trace = trace_enabled || trace_recorder || profiler || host_profile;
+        bool cognitive = status.GetTrit(BIT_COG) == 1;
+        cycles_executed += cores[(int)instrumentation][trace][cognitive](*this, max_cycles - cycles_executed);
+    }
+    return cycles_executed;
+}
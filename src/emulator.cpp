@@ -3,22 +3,69 @@
 #include <vector>
 #include "cpu.h"
 #include "memory.h"
+#include "jit/jit_x64.h"
+#include "exec_trace.h"
+#include "guest_profiler.h"
+#include <fstream>
 
 int main(int argc, char** argv) {
     if (argc < 2) {
-        std::cerr << "Usage: helix_emu <executable.hx> [max_cycles]" << std::endl;
+        std::cerr << "Usage: helix_emu <executable.hx> [max_cycles] [--trace] [--trace-file=<out.htr>] [--jit] [--metrics=none|basic|full]"
+                  << " [--break=ADDR]... [--watch=ADDR]..." << std::endl;
+        std::cerr << "  Profiling: --prof [--prof-folded=<out.folded>] [--symbols=<file.ht|.hx>] (default: symbols of the executable)"
+                  << std::endl;
+        std::cerr << "  Checkpoints: --restore=<in.hxs> (resume instead of loading the executable) --save-snapshot=<out.hxs>"
+                  << std::endl;
         return 1;
     }
 
     std::string execFile = argv[1];
 
     int maxCycles = 50000;
+    Cpu::StopConditions stop;
     bool trace = false;
+    std::string traceFile; // Binary trace (helix_trace decodes it)
+    bool prof = false;
+    std::string foldedFile;  // Folded stacks (flamegraph input)
+    std::string symbolFile;
+    std::string restoreFile; // Machine snapshots (Cpu::Snapshot)
+    std::string snapshotFile;
+    bool jit = false;
+    Cpu::Instrumentation metrics = Cpu::Instrumentation::Full;
     
     for(int i=2; i<argc; ++i) {
         std::string arg = argv[i];
         if (arg == "--trace" || arg == "-t") {
             trace = true;
+        } else if (arg.rfind("--trace-file=", 0) == 0) {
+            traceFile = arg.substr(13);
+        } else if (arg == "--prof") {
+            prof = true;
+        } else if (arg.rfind("--prof-folded=", 0) == 0) {
+            prof = true;
+            foldedFile = arg.substr(14);
+        } else if (arg.rfind("--symbols=", 0) == 0) {
+            symbolFile = arg.substr(10);
+        } else if (arg.rfind("--restore=", 0) == 0) {
+            restoreFile = arg.substr(10);
+        } else if (arg.rfind("--save-snapshot=", 0) == 0) {
+            snapshotFile = arg.substr(16);
+        } else if (arg == "--jit") {
+            jit = true;
+        } else if (arg == "--metrics=none") {
+            metrics = Cpu::Instrumentation::None;
+        } else if (arg == "--metrics=basic") {
+            metrics = Cpu::Instrumentation::Basic;
+        } else if (arg == "--metrics=full") {
+            metrics = Cpu::Instrumentation::Full;
+        } else if (arg.rfind("--break=", 0) == 0 || arg.rfind("--watch=", 0) == 0) {
+            try {
+                int64_t addr = std::stoll(arg.substr(8), nullptr, 0);
+                (arg[2] == 'b' ? stop.breakpoints : stop.watches).push_back(addr);
+            } catch(...) {
+                std::cerr << "Bad address: " << arg << std::endl;
+                return 1;
+            }
         } else {
              try {
                 maxCycles = std::stoi(arg);
@@ -28,21 +75,86 @@ int main(int argc, char** argv) {
 
     // Initialize System
     TernaryMemory memory;
-    if (!memory.LoadExecutable(execFile)) {
+    Cpu cpu(memory);
+    if (!restoreFile.empty()) {
+        Cpu::Snapshot snapshot;
+        if (!snapshot.Load(restoreFile)) {
+            std::cerr << "Failed to load snapshot " << restoreFile << std::endl;
+            return 1;
+        }
+        cpu.Restore(snapshot);
+        std::cout << "[Snapshot] Resumed from " << restoreFile << " at pc=" << cpu.pc.ToInt64() << std::endl;
+    } else if (!memory.LoadExecutable(execFile)) {
         std::cerr << "Failed to load executable." << std::endl;
         return 1;
     }
 
-    Cpu cpu(memory);
     if (trace) cpu.ToggleTrace(true);
+    cpu.instrumentation = metrics;
+    ExecTrace::Recorder recorder;
+    if (!traceFile.empty()) {
+        if (!recorder.Open(traceFile)) {
+            std::cerr << "Failed to open trace file " << traceFile << std::endl;
+            return 1;
+        }
+        cpu.trace_recorder = &recorder;
+    }
+    // helix_prof mode: symbols from the object/executable's SYMBOLS table
+    std::unique_ptr<GuestProfiler> profiler;
+    if (prof) {
+        std::vector<Symbol> symbols;
+        Linker::LoadSymbols(symbolFile.empty() ? execFile : symbolFile, symbols);
+        profiler.reset(new GuestProfiler(symbols));
+        cpu.profiler = profiler.get();
+    }
+    if (jit) {
+        cpu.core = Cpu::Core::Jit;
+        if (!JitX64::Supported()) std::cout << "[JIT] Not supported on this host; using the block core." << std::endl;
+    }
     
     std::cout << "Starting Emulation..." << std::endl;
     
-    // Execution Loop
-    int cycle = 0;
-    while (cycle < maxCycles && !cpu.halted) {
-        cpu.Step();
-        cycle++;
+    // Execution (one countdown, so the block/JIT cores can run whole blocks).
+    // A breakpoint or watch stop reports and resumes until the budget is spent.
+    uint64_t cycle = 0;
+    while (cycle < (uint64_t)maxCycles && !cpu.halted) {
+        stop.max_cycles = (uint64_t)maxCycles - cycle;
+        Cpu::RunResult run = cpu.RunUntil(stop);
+        cycle += run.cycles;
+        if (run.reason == Cpu::StopReason::Breakpoint) {
+            std::cout << "[Break] pc=" << run.address << " after " << cycle << " cycles" << std::endl;
+            cpu.DumpRegisters();
+        } else if (run.reason == Cpu::StopReason::Watchpoint) {
+            std::cout << "[Watch] write to " << run.address << " (pc=" << cpu.pc.ToInt64() << ") = "
+                      << memory.Read(run.address).ToInt64() << " after " << cycle << " cycles" << std::endl;
+        } else {
+            break;
+        }
+    }
+
+    if (!snapshotFile.empty()) {
+        if (cpu.TakeSnapshot().Save(snapshotFile)) {
+            std::cout << "[Snapshot] pc=" << cpu.pc.ToInt64() << " -> " << snapshotFile << std::endl;
+        } else {
+            std::cerr << "Failed to write snapshot " << snapshotFile << std::endl;
+        }
+    }
+
+    if (profiler) {
+        cpu.profiler = nullptr;
+        profiler->Report(std::cout);
+        if (!foldedFile.empty()) {
+            std::ofstream folded(foldedFile);
+            profiler->WriteFolded(folded);
+            std::cout << "[Prof] Folded stacks -> " << foldedFile << std::endl;
+        }
+    }
+
+    if (recorder.IsOpen()) {
+        cpu.trace_recorder = nullptr;
+        recorder.Close();
+        std::cout << "[Trace] " << recorder.Records() << " records, " << recorder.BytesWritten()
+                  << " bytes -> " << traceFile << std::endl;
     }
     
     /*
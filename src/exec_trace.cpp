@@ -0,0 +1,232 @@
+#include "exec_trace.h"
+#include <chrono>
+#include <cstring>
+
+namespace ExecTrace {
+
+static const char MAGIC[4] = { 'H', 'X', 'T', 'R' };
+static const uint32_t VERSION = 1;
+
+// Tag byte
+enum : uint8_t {
+    TAG_MEM = 1,        // mem_addr follows
+    TAG_CYCLE_NEXT = 2, // cycle == prev.cycle + 1
+    TAG_PC_NEXT = 4,    // pc == prev.pc + 1
+    TAG_VALUE_SAME = 8, // rd_value == last value of rd
+};
+
+// --- Varints ---
+
+static inline uint8_t* PutVarint(uint8_t* out, uint64_t v) {
+    while (v >= 0x80) {
+        *out++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *out++ = (uint8_t)v;
+    return out;
+}
+
+static inline uint8_t* PutSigned(uint8_t* out, int64_t v) {
+    return PutVarint(out, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63)); // Zigzag
+}
+
+static bool GetVarint(const std::vector<uint8_t>& in, size_t& pos, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= in.size()) return false;
+        uint8_t b = in[pos++];
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static bool GetSigned(const std::vector<uint8_t>& in, size_t& pos, int64_t& v) {
+    uint64_t z;
+    if (!GetVarint(in, pos, z)) return false;
+    v = (int64_t)(z >> 1) ^ -(int64_t)(z & 1);
+    return true;
+}
+
+// --- RingBuffer ---
+
+RingBuffer::RingBuffer(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    slots.resize(size);
+    mask = size - 1;
+}
+
+size_t RingBuffer::Pop(Record* out, size_t max) {
+    uint64_t t = tail.load(std::memory_order_relaxed);
+    uint64_t h = head.load(std::memory_order_acquire);
+    size_t n = (size_t)(h - t);
+    if (n > max) n = max;
+    for (size_t i = 0; i < n; ++i) out[i] = slots[(t + i) & mask];
+    tail.store(t + n, std::memory_order_release);
+    return n;
+}
+
+// --- Encoder ---
+
+Encoder::Encoder() : bytes(CHUNK_RECORDS * MAX_RECORD_BYTES) {}
+
+void Encoder::Add(const Record& r) {
+    int rd = r.rd & 15;
+    uint8_t tag = 0;
+    if (r.flags & HAS_MEM) tag |= TAG_MEM;
+    if (r.cycle == prev.cycle + 1) tag |= TAG_CYCLE_NEXT;
+    if (r.pc == prev.pc + 1) tag |= TAG_PC_NEXT;
+    if (r.rd_value == last_value[rd]) tag |= TAG_VALUE_SAME;
+
+    uint8_t* out = bytes.data() + used;
+    *out++ = tag;
+    out = PutSigned(out, r.op);
+    *out++ = (uint8_t)rd;
+    if (!(tag & TAG_CYCLE_NEXT)) out = PutSigned(out, (int64_t)(r.cycle - prev.cycle));
+    if (!(tag & TAG_PC_NEXT)) out = PutSigned(out, r.pc - prev.pc);
+    if (!(tag & TAG_VALUE_SAME)) out = PutSigned(out, r.rd_value - last_value[rd]);
+    if (tag & TAG_MEM) out = PutSigned(out, r.mem_addr - prev.mem_addr);
+    used = (size_t)(out - bytes.data());
+
+    int64_t mem_addr = (tag & TAG_MEM) ? r.mem_addr : prev.mem_addr;
+    prev = r;
+    prev.mem_addr = mem_addr;
+    last_value[rd] = r.rd_value;
+    count++;
+}
+
+void Encoder::Reset() {
+    used = 0;
+    count = 0;
+    prev = Record();
+    for (int64_t& v : last_value) v = 0;
+}
+
+// --- Reader ---
+
+bool Reader::Open(const std::string& path) {
+    in.open(path, std::ios::binary);
+    if (!in) return false;
+    char magic[4];
+    uint32_t version = 0;
+    in.read(magic, 4);
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    return in && std::memcmp(magic, MAGIC, 4) == 0 && version == VERSION;
+}
+
+bool Reader::LoadChunk() {
+    uint32_t header[2];
+    if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) return false;
+    chunk.resize(header[1]);
+    if (!in.read(reinterpret_cast<char*>(chunk.data()), header[1])) return false;
+    remaining = header[0];
+    pos = 0;
+    prev = Record();
+    for (int64_t& v : last_value) v = 0;
+    return true;
+}
+
+bool Reader::Next(Record& r) {
+    while (remaining == 0) {
+        if (!LoadChunk()) return false;
+    }
+    if (pos + 2 > chunk.size()) return false;
+    uint8_t tag = chunk[pos++];
+    int64_t op, delta;
+    if (!GetSigned(chunk, pos, op) || pos >= chunk.size()) return false;
+    int rd = chunk[pos++] & 15;
+
+    r = Record();
+    r.op = (int16_t)op;
+    r.rd = (int8_t)rd;
+    r.flags = (tag & TAG_MEM) ? HAS_MEM : 0;
+    r.cycle = prev.cycle + 1;
+    if (!(tag & TAG_CYCLE_NEXT)) {
+        if (!GetSigned(chunk, pos, delta)) return false;
+        r.cycle = prev.cycle + (uint64_t)delta;
+    }
+    r.pc = prev.pc + 1;
+    if (!(tag & TAG_PC_NEXT)) {
+        if (!GetSigned(chunk, pos, delta)) return false;
+        r.pc = prev.pc + delta;
+    }
+    r.rd_value = last_value[rd];
+    if (!(tag & TAG_VALUE_SAME)) {
+        if (!GetSigned(chunk, pos, delta)) return false;
+        r.rd_value = last_value[rd] + delta;
+    }
+    r.mem_addr = 0;
+    int64_t mem_addr = prev.mem_addr;
+    if (tag & TAG_MEM) {
+        if (!GetSigned(chunk, pos, delta)) return false;
+        mem_addr = prev.mem_addr + delta;
+        r.mem_addr = mem_addr;
+    }
+
+    prev = r;
+    prev.mem_addr = mem_addr;
+    last_value[rd] = r.rd_value;
+    remaining--;
+    return true;
+}
+
+// --- Recorder ---
+
+Recorder::Recorder(size_t ring_capacity) : ring(ring_capacity) {}
+
+Recorder::~Recorder() {
+    Close();
+}
+
+bool Recorder::Open(const std::string& path) {
+    Close();
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(MAGIC, 4);
+    out.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    bytes_written = 4 + sizeof(VERSION);
+    pushed = stalls = 0;
+    encoder.Reset();
+    stop = false;
+    running = true;
+    drain = std::thread(&Recorder::Drain, this);
+    return true;
+}
+
+void Recorder::Close() {
+    if (!running) return;
+    stop = true;
+    drain.join();
+    FlushChunk();
+    out.close();
+    running = false;
+}
+
+void Recorder::FlushChunk() {
+    if (encoder.Count() == 0) return;
+    uint32_t header[2] = { (uint32_t)encoder.Count(), (uint32_t)encoder.Size() };
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(encoder.Data()), (std::streamsize)encoder.Size());
+    bytes_written += sizeof(header) + encoder.Size();
+    encoder.Reset();
+}
+
+void Recorder::Drain() {
+    std::vector<Record> batch(1024);
+    while (true) {
+        // Read stop before popping: once set, an empty pop means all pushes are in
+        bool stopping = stop.load(std::memory_order_acquire);
+        size_t n = ring.Pop(batch.data(), batch.size());
+        for (size_t i = 0; i < n; ++i) {
+            encoder.Add(batch[i]);
+            if (encoder.Count() == Encoder::CHUNK_RECORDS) FlushChunk();
+        }
+        if (n == 0) {
+            if (stopping) break;
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
+} // namespace ExecTrace
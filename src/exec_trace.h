@@ -0,0 +1,142 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Binary Execution Trace
+// Fixed-size records (one per executed instruction) go from the CPU thread
+// into a lock-free single-producer/single-consumer ring; a background thread
+// drains the ring, delta/varint-encodes the records in chunks and appends them
+// to the trace file. helix_trace decodes, filters and summarizes the file.
+//
+// File: "HXTR" + uint32 version, then chunks of
+//   uint32 record count, uint32 payload bytes, payload
+// Each chunk is encoded independently (delta state starts from zero), so a
+// truncated file still decodes up to its last complete chunk.
+namespace ExecTrace {
+
+struct Record {
+    uint64_t cycle = 0;    // metrics.total_cycles when issued
+    int64_t pc = 0;        // Instruction address
+    int64_t rd_value = 0;  // Rd after execution (integer form)
+    int64_t mem_addr = 0;  // LDW/STW effective address (flags & HAS_MEM)
+    int16_t op = 0;        // Opcode field
+    int8_t rd = 0;         // Destination register index (0..15)
+    uint8_t flags = 0;
+};
+static_assert(sizeof(Record) == 40, "Record layout changed");
+
+enum : uint8_t { HAS_MEM = 1 };
+
+// Lock-free SPSC ring of Records. Capacity is rounded up to a power of two.
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity);
+
+    // Producer side; false when the ring is full
+    bool TryPush(const Record& r) {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - cached_tail > mask) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h - cached_tail > mask) return false;
+        }
+        slots[h & mask] = r;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; copies up to max records, returns how many
+    size_t Pop(Record* out, size_t max);
+
+    size_t Capacity() const { return mask + 1; }
+
+private:
+    std::vector<Record> slots;
+    uint64_t mask = 0;
+    alignas(64) std::atomic<uint64_t> head{0}; // Next slot to write (producer)
+    alignas(64) uint64_t cached_tail = 0;      // Producer's last view of tail
+    alignas(64) std::atomic<uint64_t> tail{0}; // Next slot to read (consumer)
+};
+
+// Chunk encoder: per-record tag byte, then only the fields that differ from
+// the obvious prediction (cycle + 1, pc + 1, last value of the same register,
+// last memory address), as zigzag varints.
+class Encoder {
+public:
+    static const size_t CHUNK_RECORDS = 4096;
+    static const size_t MAX_RECORD_BYTES = 3 + 10 + 4 * 10; // Tag, rd, op + 4 varints
+
+    Encoder();
+    void Add(const Record& r); // At most CHUNK_RECORDS per chunk
+    size_t Count() const { return count; }
+    const uint8_t* Data() const { return bytes.data(); }
+    size_t Size() const { return used; }
+    void Reset();
+
+private:
+    std::vector<uint8_t> bytes; // Preallocated for a full chunk
+    size_t used = 0;
+    size_t count = 0;
+    Record prev;
+    int64_t last_value[16] = {};
+};
+
+// Decodes a trace file record by record
+class Reader {
+public:
+    bool Open(const std::string& path); // False if missing or not a trace file
+    bool Next(Record& r);                // False at end of file (or truncation)
+
+private:
+    bool LoadChunk();
+
+    std::ifstream in;
+    std::vector<uint8_t> chunk;
+    size_t pos = 0;
+    uint32_t remaining = 0;
+    Record prev;
+    int64_t last_value[16] = {};
+};
+
+// Ring + drain thread + trace file. Push never drops a record: when the ring
+// is full the CPU thread yields until the drain catches up (counted in Stalls).
+class Recorder {
+public:
+    explicit Recorder(size_t ring_capacity = 1 << 16);
+    ~Recorder();
+
+    bool Open(const std::string& path); // Starts the drain thread
+    void Close();                       // Drains everything, finishes the file
+    bool IsOpen() const { return running; }
+
+    void Push(const Record& r) {
+        while (!ring.TryPush(r)) {
+            stalls++;
+            std::this_thread::yield();
+        }
+        pushed++;
+    }
+
+    uint64_t Records() const { return pushed; }
+    uint64_t Stalls() const { return stalls; }
+    uint64_t BytesWritten() const { return bytes_written; } // Valid after Close
+
+private:
+    void Drain();
+    void FlushChunk();
+
+    RingBuffer ring;
+    Encoder encoder;
+    std::ofstream out;
+    std::thread drain;
+    std::atomic<bool> stop{false};
+    bool running = false;
+    uint64_t pushed = 0;
+    uint64_t stalls = 0;
+    uint64_t bytes_written = 0;
+};
+
+} // namespace ExecTrace
@@ -0,0 +1,148 @@
+#include "guest_profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <map>
+
+GuestProfiler::GuestProfiler(std::vector<Symbol> syms)
+    : pc_counts(TernaryMemory::SYSTEM_SIZE, 0), nodes(1), symbols(std::move(syms)) {
+    std::stable_sort(symbols.begin(), symbols.end(),
+                     [](const Symbol& a, const Symbol& b) { return a.finalAddress < b.finalAddress; });
+    stack.reserve(MAX_DEPTH);
+}
+
+void GuestProfiler::EnterCall(int64_t target, int64_t return_addr) {
+    if ((int)stack.size() >= MAX_DEPTH) return;
+    int child = -1;
+    for (int c : nodes[current].children) {
+        if (nodes[c].func == target) { child = c; break; }
+    }
+    if (child < 0) {
+        child = (int)nodes.size();
+        Node n;
+        n.func = target;
+        n.parent = current;
+        nodes.push_back(n);
+        nodes[current].children.push_back(child);
+    }
+    nodes[child].calls++;
+    stack.push_back({ current, return_addr });
+    current = child;
+}
+
+void GuestProfiler::ExitCall(int64_t target) {
+    for (size_t i = stack.size(); i-- > 0;) {
+        if (stack[i].return_addr == target) {
+            current = stack[i].caller;
+            stack.resize(i);
+            return;
+        }
+    }
+    unmatched_returns++;
+}
+
+uint64_t GuestProfiler::Count(int64_t pc) const {
+    if (pc >= 0 && pc < (int64_t)pc_counts.size()) return pc_counts[pc];
+    auto it = other_pc_counts.find(pc);
+    return it == other_pc_counts.end() ? 0 : it->second;
+}
+
+std::string GuestProfiler::Symbolize(int64_t addr) const {
+    // Nearest symbol at or below addr
+    auto it = std::upper_bound(symbols.begin(), symbols.end(), addr,
+                               [](int64_t a, const Symbol& s) { return a < s.finalAddress; });
+    if (it == symbols.begin()) return std::to_string(addr);
+    --it;
+    int64_t off = addr - it->finalAddress;
+    return off == 0 ? it->name : it->name + "+" + std::to_string(off);
+}
+
+std::string GuestProfiler::FrameName(int64_t func, bool root) const {
+    std::string name = func < 0 ? std::string() : Symbolize(func);
+    // The root is named only by a symbol exactly at the entry point
+    if (root && (name.empty() || name.find('+') != std::string::npos || name == std::to_string(func))) return "[root]";
+    return name;
+}
+
+void GuestProfiler::Report(std::ostream& out, size_t top) const {
+    out << "[Prof] " << instructions << " instructions";
+    if (unmatched_returns) out << ", " << unmatched_returns << " unmatched RET";
+    out << std::endl;
+    if (instructions == 0) return;
+    auto pct = [&](uint64_t n) { return 100.0 * n / instructions; };
+    out << std::fixed << std::setprecision(1);
+
+    std::vector<std::pair<uint64_t, int64_t>> pcs;
+    for (size_t pc = 0; pc < pc_counts.size(); ++pc) {
+        if (pc_counts[pc]) pcs.push_back({ pc_counts[pc], (int64_t)pc });
+    }
+    for (const auto& entry : other_pc_counts) pcs.push_back({ entry.second, entry.first });
+    std::sort(pcs.rbegin(), pcs.rend());
+    out << "\nHottest PCs:" << std::endl;
+    for (size_t i = 0; i < pcs.size() && i < top; ++i) {
+        out << "  pc=" << std::left << std::setw(8) << pcs[i].second << std::setw(24) << Symbolize(pcs[i].second)
+            << std::right << std::setw(12) << pcs[i].first << std::setw(8) << pct(pcs[i].first) << "%" << std::endl;
+    }
+
+    std::vector<std::pair<uint64_t, int>> ops;
+    for (int op = 0; op <= Cpu::OPCODE_SLOTS; ++op) {
+        if (op_counts[op]) ops.push_back({ op_counts[op], op });
+    }
+    std::sort(ops.rbegin(), ops.rend());
+    out << "\nOpcode histogram:" << std::endl;
+    for (const auto& entry : ops) {
+        out << "  " << std::left << std::setw(8) << (entry.second < Cpu::OPCODE_SLOTS ? OpcodeName(entry.second) : "?")
+            << std::right << std::setw(12) << entry.first << std::setw(8) << pct(entry.first) << "%" << std::endl;
+    }
+
+    // Call graph (doubles as the flat profile: self = instructions executed in
+    // the function's own contexts). Per function, contexts merged. Inclusive time counts each
+    // context once even under recursion (only outermost contexts of f).
+    std::vector<uint64_t> total(nodes.size(), 0);
+    for (size_t i = nodes.size(); i-- > 0;) { // Children are created after their parents
+        total[i] += nodes[i].self;
+        if (nodes[i].parent >= 0) total[nodes[i].parent] += total[i];
+    }
+    struct FuncStats { uint64_t calls = 0, self = 0, inclusive = 0; };
+    std::map<int64_t, FuncStats> funcs;
+    std::map<std::pair<int64_t, int64_t>, uint64_t> edges; // (caller, callee) -> calls
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const Node& n = nodes[i];
+        FuncStats& f = funcs[n.func];
+        f.calls += n.calls;
+        f.self += n.self;
+        bool outermost = true;
+        for (int p = n.parent; p >= 0 && outermost; p = nodes[p].parent) outermost = nodes[p].func != n.func;
+        if (outermost) f.inclusive += total[i];
+        if (n.parent >= 0) edges[{ nodes[n.parent].func, n.func }] += n.calls;
+    }
+    std::vector<std::pair<uint64_t, int64_t>> order;
+    for (const auto& entry : funcs) order.push_back({ entry.second.inclusive, entry.first });
+    std::sort(order.rbegin(), order.rend());
+    out << "\nCall graph:" << std::endl;
+    out << "  " << std::left << std::setw(24) << "function" << std::right << std::setw(10) << "calls"
+        << std::setw(12) << "self" << std::setw(12) << "inclusive" << std::setw(8) << "incl%" << std::endl;
+    for (size_t i = 0; i < order.size() && i < top; ++i) {
+        int64_t func = order[i].second;
+        const FuncStats& f = funcs[func];
+        out << "  " << std::left << std::setw(24) << FrameName(func, func == nodes[0].func) << std::right << std::setw(10) << f.calls
+            << std::setw(12) << f.self << std::setw(12) << f.inclusive << std::setw(7) << pct(f.inclusive) << "%" << std::endl;
+        for (const auto& edge : edges) {
+            if (edge.first.first != func) continue;
+            out << "      -> " << std::left << std::setw(24) << FrameName(edge.first.second) << std::right << std::setw(10)
+                << edge.second << std::endl;
+        }
+    }
+    out.unsetf(std::ios::floatfield);
+}
+
+void GuestProfiler::WriteFolded(std::ostream& out) const {
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].self == 0) continue;
+        std::vector<int> path;
+        for (int n = (int)i; n >= 0; n = nodes[n].parent) path.push_back(n);
+        for (size_t k = path.size(); k-- > 0;) {
+            out << FrameName(nodes[path[k]].func, path[k] == 0) << (k ? ";" : "");
+        }
+        out << " " << nodes[i].self << "\n";
+    }
+}
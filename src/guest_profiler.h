@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "cpu.h"
+#include "isa.h"
+#include "linker/Linker.h"
+
+// Guest Profiler (helix_emu --prof)
+// Exact per-instruction profile of guest code: execution count per PC, an
+// opcode histogram and a calling-context tree. CALL enters a child context
+// (keyed by the call target) and remembers the return address it left in
+// R14; RET pops back to the frame whose return address it jumped to, so
+// callees that save and restore R14 themselves are followed correctly, and
+// RETs that match no frame (computed jumps through R14) are only counted.
+// While attached (Cpu::profiler), Step runs the threaded core's tracing
+// instantiation, which reports every instruction here.
+class GuestProfiler {
+public:
+    explicit GuestProfiler(std::vector<Symbol> symbols = {});
+
+    // Core hooks: before execution (pc of the instruction), after execution
+    void Issue(int64_t pc, int16_t op) {
+        if (pc >= 0 && pc < (int64_t)pc_counts.size()) pc_counts[pc]++;
+        else other_pc_counts[pc]++;
+        op_counts[(op >= 0 && op < Cpu::OPCODE_SLOTS) ? op : Cpu::OPCODE_SLOTS]++;
+        if (nodes[current].func < 0) nodes[current].func = pc; // Root: entry point
+        nodes[current].self++;
+        instructions++;
+        pending_op = op;
+    }
+    void Retire(const Cpu& cpu) {
+        if (pending_op == (int16_t)Opcode::CALL) EnterCall(cpu.pc.ToInt64(), cpu.regs[14].ToInt64());
+        else if (pending_op == (int16_t)Opcode::RET) ExitCall(cpu.pc.ToInt64());
+    }
+
+    // Results
+    uint64_t Instructions() const { return instructions; }
+    uint64_t Count(int64_t pc) const;
+    uint64_t OpcodeCount(int op) const { return op_counts[(op >= 0 && op < Cpu::OPCODE_SLOTS) ? op : Cpu::OPCODE_SLOTS]; }
+    uint64_t UnmatchedReturns() const { return unmatched_returns; }
+    std::string Symbolize(int64_t addr) const; // "name", "name+off" or the address
+
+    // Hottest PCs, opcode histogram and call graph (top: rows per table)
+    void Report(std::ostream& out, size_t top = 20) const;
+    // One line per calling context: "root;caller;callee <instructions>"
+    // (flamegraph.pl / speedscope folded format)
+    void WriteFolded(std::ostream& out) const;
+
+    static const int MAX_DEPTH = 256; // Deeper calls are charged to the deepest frame
+
+private:
+    struct Node {
+        int64_t func = -1; // Call target (root: first PC executed)
+        int parent = -1;
+        uint64_t self = 0;  // Instructions executed in this context
+        uint64_t calls = 0; // Times this context was entered
+        std::vector<int> children;
+    };
+    struct Frame {
+        int caller; // Context to return to
+        int64_t return_addr;
+    };
+
+    void EnterCall(int64_t target, int64_t return_addr);
+    void ExitCall(int64_t target);
+    std::string FrameName(int64_t func, bool root = false) const; // Symbolized call target
+
+    std::vector<uint64_t> pc_counts; // System memory, indexed by PC
+    std::unordered_map<int64_t, uint64_t> other_pc_counts;
+    uint64_t op_counts[Cpu::OPCODE_SLOTS + 1] = {};
+    std::vector<Node> nodes; // [0] = root
+    std::vector<Frame> stack;
+    int current = 0;
+    int16_t pending_op = -1;
+    uint64_t instructions = 0;
+    uint64_t unmatched_returns = 0;
+    std::vector<Symbol> symbols; // Sorted by finalAddress
+};
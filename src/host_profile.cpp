@@ -0,0 +1,80 @@
+#include "host_profile.h"
+#include "isa.h"
+#include <algorithm>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+void HostProfile::Reset() {
+    for (Counter& c : ops) c = Counter();
+    for (Counter& c : mem) c = Counter();
+    op_slot = -1;
+
+    // Cheapest of a few back-to-back pairs: what a timed region costs when empty
+    timer_ticks = UINT64_MAX;
+    for (int i = 0; i < 1000; ++i) {
+        uint64_t t0 = Ticks();
+        uint64_t t1 = Ticks();
+        timer_ticks = std::min(timer_ticks, t1 - t0);
+    }
+    start_ticks = Ticks();
+    start_time = std::chrono::steady_clock::now();
+}
+
+double HostProfile::NsPerTick() const {
+#if HELIX_HOST_TSC
+    // Make sure there is something to calibrate against
+    if (std::chrono::steady_clock::now() - start_time < std::chrono::milliseconds(1)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start_time).count();
+    uint64_t ticks = Ticks() - start_ticks;
+    return ticks ? ns / ticks : 0.0;
+#else
+    return 1.0;
+#endif
+}
+
+const char* HostProfile::MemPathName(int path) {
+    static const char* const names[MEM_PATHS] = {
+        "system", "cognitive page", "unallocated page", "device", "raw pointer", "raw pointer miss"
+    };
+    return (path >= 0 && path < MEM_PATHS) ? names[path] : "?";
+}
+
+void HostProfile::Print(std::ostream& out) const {
+    double ns_per_tick = NsPerTick();
+    auto net_ns = [&](const Counter& c) {
+        uint64_t overhead = c.count * timer_ticks;
+        return (c.ticks > overhead ? c.ticks - overhead : 0) * ns_per_tick;
+    };
+    auto table = [&](const char* title, const Counter* counters, int n, const char* (*name)(int)) {
+        std::vector<std::pair<double, int>> rows;
+        double total = 0;
+        for (int i = 0; i < n; ++i) {
+            if (!counters[i].count) continue;
+            double ns = net_ns(counters[i]);
+            rows.push_back({ ns, i });
+            total += ns;
+        }
+        std::sort(rows.rbegin(), rows.rend());
+        out << title << std::endl;
+        out << "  " << std::left << std::setw(18) << "" << std::right << std::setw(12) << "count" << std::setw(14)
+            << "total (us)" << std::setw(10) << "ns/each" << std::setw(8) << "%" << std::endl;
+        for (const auto& row : rows) {
+            const Counter& c = counters[row.second];
+            out << "  " << std::left << std::setw(18) << name(row.second) << std::right << std::setw(12) << c.count
+                << std::setw(14) << std::fixed << std::setprecision(1) << row.first / 1000.0 << std::setw(10)
+                << row.first / c.count << std::setw(7) << (total > 0 ? 100.0 * row.first / total : 0.0) << "%"
+                << std::endl;
+        }
+        out.unsetf(std::ios::floatfield);
+    };
+
+    out << "[Host] Cost per emulated opcode (" << std::fixed << std::setprecision(1)
+        << timer_ticks * ns_per_tick << " ns timer overhead subtracted)" << std::endl;
+    out.unsetf(std::ios::floatfield);
+    table("  Opcodes:", ops, OP_SLOTS,
+          [](int op) { return op < OP_SLOTS - 1 ? OpcodeName(op) : "(invalid)"; });
+    table("  Memory paths:", mem, MEM_PATHS, &MemPathName);
+}
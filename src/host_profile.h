@@ -0,0 +1,79 @@
+#pragma once
+#include "isa.h"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#define HELIX_HOST_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <x86intrin.h>
+#define HELIX_HOST_TSC 1
+#else
+#define HELIX_HOST_TSC 0
+#endif
+
+// Host Cost Attribution (interpreter self-profiling)
+// Host time spent per emulated opcode and per memory path, in TSC ticks
+// (steady_clock nanoseconds on hosts without a TSC), converted to ns against
+// steady_clock when printed. The cost of a timer pair is measured at Reset
+// and subtracted. Opcode times include the memory accesses they make.
+// Attach with Cpu::SetHostProfile; this measures the host, not the guest
+// (see GuestProfiler for that).
+struct HostProfile {
+    // Memory path outcomes (TernaryMemory::Read / Write / GetRawPointer)
+    enum MemPath {
+        MEM_SYSTEM,      // Flat system memory (< 0x3000)
+        MEM_COGNITIVE,   // Allocated cognitive page (page hash lookup)
+        MEM_UNALLOCATED, // Cognitive address on an unallocated page
+        MEM_DEVICE,      // Memory-mapped device (UART)
+        MEM_RAW_HIT,     // GetRawPointer returned a pointer
+        MEM_RAW_MISS,    // GetRawPointer refused (page crossing, unallocated, denied)
+        MEM_PATHS
+    };
+    static const int OP_SLOTS = OPCODE_COUNT + 1; // Cpu::OPCODE_SLOTS + out-of-range opcodes
+
+    struct Counter {
+        uint64_t count = 0;
+        uint64_t ticks = 0;
+        void Add(uint64_t t) { count++; ticks += t; }
+    };
+    Counter ops[OP_SLOTS];
+    Counter mem[MEM_PATHS];
+
+    HostProfile() { Reset(); }
+    void Reset(); // Clears the counters, recalibrates
+
+    static uint64_t Ticks() {
+#if HELIX_HOST_TSC
+        return __rdtsc();
+#else
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    // Core hooks around one instruction's handler
+    void BeginOp(int slot) {
+        op_slot = slot;
+        op_start = Ticks();
+    }
+    void EndOp() {
+        if (op_slot < 0) return;
+        ops[op_slot].Add(Ticks() - op_start);
+        op_slot = -1;
+    }
+
+    double NsPerTick() const; // From steady_clock over the time since Reset
+    static const char* MemPathName(int path);
+    // Opcode and memory-path tables, most expensive first
+    void Print(std::ostream& out) const;
+
+private:
+    int op_slot = -1;
+    uint64_t op_start = 0;
+    uint64_t timer_ticks = 0; // Cost of an empty Ticks() pair
+    uint64_t start_ticks = 0;
+    std::chrono::steady_clock::time_point start_time;
+};
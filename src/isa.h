@@ -78,6 +78,27 @@ enum class Opcode {
     VSTRI = 39, // Set Vector Stride
     VMMSGN = 40, // Vector-Matrix Multiply with Sign Activation
     
+    // Page ops (Phase 7 Vector Unit, cont.)
+    VEC_DEC = 41, // Page Decay with Mask
+    VEC_MAC = 42, // Page Saturating Multiply-Accumulate
+    
     UNKNOWN = 99
 };
 
+// Number of ISA opcodes (0..OPCODE_COUNT-1); UNKNOWN is not one of them
+const int OPCODE_COUNT = (int)Opcode::VEC_MAC + 1;
+
+// Mnemonic for an opcode field value ("?" outside the ISA)
+inline const char* OpcodeName(int64_t op) {
+    static const char* const names[] = {
+        "HLT", "NOP", "ADD", "SUB", "MUL", "DIV", "MOD", "AND", "OR", "XOR", "LSL", "LSR",
+        "MOV", "LDI", "LDW", "STW", "JMP", "BEQ", "BNE", "BGT", "BLT", "CALL", "RET", "MSR", "MRS",
+        "CMP", "CNS", "DEC", "POP", "SAT", "VEC_CNS", "VEC_POP",
+        "VLDR", "VSTR", "VADD", "VDOT", "VMMUL", "VSIGN", "VCLIP", "VSTRI", "VMMSGN",
+        "VEC_DEC", "VEC_MAC"
+    };
+    const int64_t count = (int64_t)(sizeof(names) / sizeof(names[0]));
+    static_assert(sizeof(names) / sizeof(names[0]) == OPCODE_COUNT, "OpcodeName needs a mnemonic per opcode");
+    return (op >= 0 && op < count) ? names[op] : "?";
+}
+
@@ -0,0 +1,328 @@
+#include "jit_x64.h"
+#include "../isa.h"
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) && !defined(_WIN32) && (defined(__linux__) || defined(__APPLE__) || defined(__unix__))
+#define HELIX_JIT_X64 1
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define HELIX_JIT_X64 0
+#endif
+
+namespace {
+
+// Largest magnitude of a 27-trit word: (3^27 - 1) / 2
+const int64_t MAX_WORD = (TritDetail::Pow3(TernaryWord::NUM_TRITS) - 1) / 2;
+const size_t ARENA_BYTES = 4 << 20;
+
+uint64_t PackPlanes(const TernaryWord& w) {
+    return (uint64_t)w.pos | ((uint64_t)w.neg << 32);
+}
+
+// Index of the lowest set bit of a register mask
+int LowestReg(uint32_t mask) {
+    return TritDetail::CountBits((mask & (0u - mask)) - 1);
+}
+
+// Writeback from native code: refresh the ternary mirror and count flips
+void JitRetire(JitState* st, int64_t r, int64_t value) {
+    if (!st->count_flips) return;
+    uint64_t planes = PackPlanes(TernaryWord::FromInt64(value));
+    int flips = TritDetail::CountBits(planes ^ st->planes[r]);
+    st->flips += flips;
+    st->planes[r] = planes;
+}
+
+// CALL's link register write (not flip-accounted, as in ExecuteOp)
+void JitSetLink(JitState* st, int64_t r, int64_t value) {
+    if (!st->count_flips) return;
+    st->planes[r] = PackPlanes(TernaryWord::FromInt64(value));
+}
+
+bool IsArithmetic(Opcode op) {
+    return op == Opcode::ADD || op == Opcode::SUB || op == Opcode::MUL || op == Opcode::CMP;
+}
+
+bool IsTerminator(const Cpu::DecodedInst& in) {
+    switch (static_cast<Opcode>(in.op)) {
+        case Opcode::JMP: case Opcode::BEQ: case Opcode::BNE: case Opcode::BGT: case Opcode::BLT:
+        case Opcode::CALL:
+            return in.mode == 4; // PC-relative targets are static
+        case Opcode::RET:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool IsSupported(const Cpu::DecodedInst& in) {
+    Opcode op = static_cast<Opcode>(in.op);
+    return op == Opcode::NOP || op == Opcode::LDI || op == Opcode::MOV || IsArithmetic(op) || IsTerminator(in);
+}
+
+// Minimal x86-64 encoder. rbx holds the JitState pointer; rax/rcx/rdx are
+// scratch and are reloaded from JitState after every helper call.
+class Emitter {
+public:
+    std::vector<uint8_t> code;
+    std::vector<size_t> exit_fixups; // rel32 slots that jump to the epilogue
+
+    void U8(uint8_t v) { code.push_back(v); }
+    void U32(uint32_t v) { for (int i = 0; i < 4; ++i) U8((uint8_t)(v >> (8 * i))); }
+    void U64(uint64_t v) { for (int i = 0; i < 8; ++i) U8((uint8_t)(v >> (8 * i))); }
+    void Bytes(std::initializer_list<uint8_t> bytes) { for (uint8_t b : bytes) U8(b); }
+
+    static int32_t Reg(int r) { return (int32_t)(offsetof(JitState, regs) + 8 * r); }
+    static int32_t Flag(int f) { return (int32_t)(offsetof(JitState, flags) + 8 * f); }
+
+    void LoadRax(int32_t disp) { Bytes({0x48, 0x8B, 0x83}); U32(disp); }        // mov rax, [rbx+disp]
+    void LoadRcx(int32_t disp) { Bytes({0x48, 0x8B, 0x8B}); U32(disp); }        // mov rcx, [rbx+disp]
+    void StoreRax(int32_t disp) { Bytes({0x48, 0x89, 0x83}); U32(disp); }       // mov [rbx+disp], rax
+    void StoreRcx(int32_t disp) { Bytes({0x48, 0x89, 0x8B}); U32(disp); }       // mov [rbx+disp], rcx
+    void StoreRdx(int32_t disp) { Bytes({0x48, 0x89, 0x93}); U32(disp); }       // mov [rbx+disp], rdx
+    void StoreImm(int32_t disp, int32_t v) { Bytes({0x48, 0xC7, 0x83}); U32(disp); U32((uint32_t)v); }
+    void MovRaxImm(int64_t v) { Bytes({0x48, 0xB8}); U64((uint64_t)v); }
+    void MovRcxImm(int64_t v) { Bytes({0x48, 0xB9}); U64((uint64_t)v); }
+
+    // Leave native code reporting 'completed' ops
+    void Exit(int completed) {
+        U8(0xB8); U32((uint32_t)completed);   // mov eax, completed
+        U8(0xE9); exit_fixups.push_back(code.size()); U32(0); // jmp epilogue
+    }
+    // Exit unless the condition (short jcc opcode) holds
+    void ExitUnless(uint8_t jcc8, int completed) {
+        U8(jcc8); U8(10); // skip the 10-byte Exit
+        Exit(completed);
+    }
+
+    // Guard: rax must be a valid 27-trit value (clobbers rcx)
+    void GuardRange(int completed) {
+        MovRcxImm(MAX_WORD);
+        Bytes({0x48, 0x39, 0xC8});  // cmp rax, rcx
+        ExitUnless(0x7E, completed); // jle
+        MovRcxImm(-MAX_WORD);
+        Bytes({0x48, 0x39, 0xC8});
+        ExitUnless(0x7D, completed); // jge
+    }
+
+    // Z/P/N from rax, C = O = 0 (in-range arithmetic has no carry out)
+    void Flags() {
+        Bytes({0x31, 0xC9});             // xor ecx, ecx
+        Bytes({0x31, 0xD2});             // xor edx, edx
+        Bytes({0x48, 0x85, 0xC0});       // test rax, rax
+        Bytes({0x0F, 0x94, 0xC1});       // sete cl
+        Bytes({0x0F, 0x9F, 0xC2});       // setg dl
+        StoreRcx(Flag(0));
+        StoreRdx(Flag(1));
+        Bytes({0x31, 0xC9});
+        Bytes({0x48, 0x85, 0xC0});
+        Bytes({0x0F, 0x9C, 0xC1});       // setl cl
+        StoreRcx(Flag(2));
+        StoreImm(Flag(3), 0);
+        StoreImm(Flag(4), 0);
+        StoreImm((int32_t)offsetof(JitState, flags_dirty), 1);
+    }
+
+    // helper(st, r, rax)
+    void CallHelper(void (*helper)(JitState*, int64_t, int64_t), int r) {
+        Bytes({0x48, 0x89, 0xC2});       // mov rdx, rax
+        Bytes({0x48, 0x89, 0xDF});       // mov rdi, rbx
+        U8(0xBE); U32((uint32_t)r);      // mov esi, r
+        MovRaxImm((int64_t)(intptr_t)helper);
+        Bytes({0xFF, 0xD0});             // call rax
+    }
+};
+
+} // namespace
+
+bool JitX64::Supported() {
+    return HELIX_JIT_X64 != 0;
+}
+
+JitX64::JitX64() {
+#if HELIX_JIT_X64
+    void* p = mmap(nullptr, ARENA_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return;
+    // Hosts that refuse executable mappings (W^X policies) get no JIT
+    if (mprotect(p, ARENA_BYTES, PROT_READ | PROT_EXEC) != 0) {
+        munmap(p, ARENA_BYTES);
+        return;
+    }
+    arena = static_cast<uint8_t*>(p);
+    arena_size = ARENA_BYTES;
+    page_bytes = (size_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+JitX64::~JitX64() {
+#if HELIX_JIT_X64
+    if (arena) munmap(arena, arena_size);
+#endif
+}
+
+bool JitX64::CopyIn(uint8_t* dst, const std::vector<uint8_t>& code) {
+#if HELIX_JIT_X64
+    // Blocks already on these pages are not running: Compile never runs from native code
+    uint8_t* first = arena + ((size_t)(dst - arena) & ~(page_bytes - 1));
+    size_t span = (size_t)(dst + code.size() - first);
+    if (mprotect(first, span, PROT_READ | PROT_WRITE) != 0) return false;
+    std::memcpy(dst, code.data(), code.size());
+    return mprotect(first, span, PROT_READ | PROT_EXEC) == 0;
+#else
+    (void)dst;
+    (void)code;
+    return false;
+#endif
+}
+
+void JitX64::Reset() {
+    codes.clear();
+    arena_used = 0;
+    full = false;
+}
+
+const JitCode* JitX64::Compile(const Cpu::Block& block) {
+    if (!arena || block.ops.empty() || !IsSupported(block.ops[0].inst)) return nullptr;
+
+    std::unique_ptr<JitCode> jc(new JitCode());
+    Emitter e;
+    e.U8(0x53);                          // push rbx
+    e.Bytes({0x48, 0x89, 0xFB});         // mov rbx, rdi
+
+    int k = 0;
+    for (; k < (int)block.ops.size(); ++k) {
+        const Cpu::DecodedInst& in = block.ops[k].inst;
+        if (!IsSupported(in)) break;
+        Opcode op = static_cast<Opcode>(in.op);
+        int64_t next_pc = block.entry + k + 1;
+        int64_t target = next_pc + in.imm_val;
+
+        if (IsArithmetic(op)) {
+            jc->read_mask |= (uint16_t)(1u << in.rs1);
+            e.LoadRax(Emitter::Reg(in.rs1));
+            if (in.mode == 1) {
+                e.MovRcxImm(in.imm_val);
+            } else {
+                jc->read_mask |= (uint16_t)(1u << in.rs2);
+                e.LoadRcx(Emitter::Reg(in.rs2));
+            }
+            if (op == Opcode::ADD) e.Bytes({0x48, 0x01, 0xC8});      // add rax, rcx
+            else if (op == Opcode::MUL) {
+                e.Bytes({0x48, 0x0F, 0xAF, 0xC1});                   // imul rax, rcx
+                e.ExitUnless(0x71, k);                               // jno
+            } else e.Bytes({0x48, 0x29, 0xC8});                      // sub rax, rcx (SUB, CMP)
+            e.GuardRange(k);
+            if (op != Opcode::CMP) e.StoreRax(Emitter::Reg(in.rd));
+            e.Flags();
+            if (op != Opcode::CMP) {
+                jc->write_mask |= (uint16_t)(1u << in.rd);
+                e.CallHelper(&JitRetire, in.rd);
+            }
+        } else if (op == Opcode::LDI || op == Opcode::MOV) {
+            if (op == Opcode::LDI) {
+                e.MovRaxImm(in.imm_val);
+            } else {
+                jc->read_mask |= (uint16_t)(1u << in.rs1);
+                e.LoadRax(Emitter::Reg(in.rs1));
+            }
+            e.StoreRax(Emitter::Reg(in.rd));
+            jc->write_mask |= (uint16_t)(1u << in.rd);
+            e.CallHelper(&JitRetire, in.rd);
+        } else if (op == Opcode::NOP) {
+            // Passive cycle
+        } else {
+            // Terminator: write next_pc, then leave with the whole prefix done
+            const int32_t npc = (int32_t)offsetof(JitState, next_pc);
+            if (op == Opcode::RET) {
+                jc->read_mask |= (uint16_t)(1u << 14);
+                e.LoadRax(Emitter::Reg(14));
+                e.StoreRax(npc);
+            } else if (op == Opcode::JMP || op == Opcode::CALL) {
+                if (op == Opcode::CALL) {
+                    jc->write_mask |= (uint16_t)(1u << 14);
+                    e.MovRaxImm(next_pc);
+                    e.StoreRax(Emitter::Reg(14));
+                    e.CallHelper(&JitSetLink, 14);
+                }
+                e.MovRaxImm(target);
+                e.StoreRax(npc);
+            } else {
+                // Conditional: next_pc = fall-through, overwritten when taken
+                int flag = (op == Opcode::BGT) ? 1 : (op == Opcode::BLT) ? 2 : 0;
+                int64_t taken_value = (op == Opcode::BNE) ? 0 : 1;
+                e.MovRaxImm(next_pc);
+                e.StoreRax(npc);
+                e.LoadRcx(Emitter::Flag(flag));
+                e.Bytes({0x48, 0x83, 0xF9, (uint8_t)taken_value}); // cmp rcx, imm8
+                e.U8(0x75); e.U8(17);                              // jne over the 17-byte store
+                e.MovRaxImm(target);
+                e.StoreRax(npc);
+            }
+            jc->terminates = true;
+            ++k;
+            break;
+        }
+    }
+    jc->ops = k;
+    e.U8(0xB8); e.U32((uint32_t)k);      // mov eax, k
+
+    // Epilogue
+    size_t epilogue = e.code.size();
+    e.U8(0x5B);                          // pop rbx
+    e.U8(0xC3);                          // ret
+    for (size_t slot : e.exit_fixups) {
+        int32_t rel = (int32_t)(epilogue - (slot + 4));
+        std::memcpy(&e.code[slot], &rel, 4);
+    }
+
+    if (arena_used + e.code.size() > arena_size) {
+        full = true;
+        return nullptr;
+    }
+    uint8_t* dst = arena + arena_used;
+    if (!CopyIn(dst, e.code)) return nullptr;
+    arena_used += (e.code.size() + 15) & ~(size_t)15;
+    jc->fn = reinterpret_cast<int (*)(JitState*)>(dst);
+    codes.push_back(std::move(jc));
+    return codes.back().get();
+}
+
+int JitX64::Run(Cpu& cpu, const JitCode& code) {
+    // Entry conditions: interpreter-only semantics must not apply
+    if (cpu.status.GetTrit(Cpu::BIT_COG) == 1) return 0; // Saturating ADD
+    // MOV and RET copy words exactly, and registers are written back from their
+    // integer form: compiled code only handles canonical words
+    const uint32_t used = code.read_mask | code.write_mask;
+    for (uint32_t m = used; m; m &= m - 1) {
+        if (!cpu.regs[LowestReg(m)].Canonical()) return 0;
+    }
+    state.count_flips = cpu.CountsFlips() ? 1 : 0;
+    for (uint32_t m = used; m; m &= m - 1) {
+        int r = LowestReg(m);
+        state.regs[r] = cpu.regs[r].ToInt64();
+        if (state.count_flips) state.planes[r] = PackPlanes(cpu.regs[r].Word());
+    }
+    for (int f = 0; f < 5; ++f) state.flags[f] = cpu.status.GetTrit(f);
+    state.flags_dirty = 0;
+    state.flips = 0;
+
+    int completed = code.fn(&state);
+
+    for (uint32_t m = code.write_mask; m; m &= m - 1) {
+        int r = LowestReg(m);
+        if (state.count_flips) {
+            cpu.regs[r].Set(state.regs[r], TernaryWord(state.planes[r] & 0xFFFFFFFFu, state.planes[r] >> 32));
+        } else {
+            cpu.regs[r].SetInt(state.regs[r]);
+        }
+    }
+    if (state.flags_dirty) {
+        for (int f = 0; f < 5; ++f) cpu.status.SetTrit(f, (int8_t)state.flags[f]);
+    }
+    cpu.metrics.trit_flips += state.flips;
+    cpu.metrics.energy_proxy += state.flips;
+    if (code.terminates && completed == code.ops) cpu.pc.SetInt(state.next_pc);
+    return completed;
+}
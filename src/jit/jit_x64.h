@@ -0,0 +1,72 @@
+#pragma once
+#include "../cpu.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// x86-64 JIT for hot basic blocks (Core::Jit)
+// Compiles the longest supported prefix of a block to native code in an
+// mmap'd arena. The arena is never writable and executable at once: its pages
+// are read/execute, and the ones a block lands on are switched to read/write
+// only while it is copied in. While native code runs, the registers it touches
+// are held as int64 in a JitState; on exit they are written back to the
+// registers' integer shadows (plus ternary planes when flips are counted).
+// Every op that could leave the 27-trit range (ADD/SUB/CMP/MUL overflow) is
+// guarded: the guard exits before the op, and the block core finishes the
+// block in the interpreter.
+//
+// Compiled: NOP, LDI, MOV, ADD, SUB, MUL, CMP, and as terminators
+// PC-relative JMP/BEQ/BNE/BGT/BLT/CALL plus RET. Anything else (memory ops,
+// vector ops, cognitive mode) ends the compiled prefix.
+
+// Native code state. Layout is used by the emitter (offsetof).
+struct JitState {
+    int64_t regs[16];      // Integer form of the registers in use
+    uint64_t planes[16];   // Ternary form: pos | (neg << 32), kept in sync on writeback
+    int64_t flags[5];      // Z, P, N, C, O trits
+    int64_t flags_dirty;   // Set by flag-writing ops
+    int64_t next_pc;       // Set by a compiled terminator
+    uint64_t flips;        // Trit flips of all writebacks
+    int64_t count_flips;   // Cpu::CountsFlips() (planes/flips are skipped when 0)
+};
+
+struct JitCode {
+    int (*fn)(JitState*) = nullptr; // Returns the number of ops completed
+    int ops = 0;                    // Length of the compiled prefix
+    bool terminates = false;        // Prefix includes the block's terminator
+    uint16_t read_mask = 0;         // Registers read (must be canonical on entry)
+    uint16_t write_mask = 0;        // Registers written (canonical on entry, copied back on exit)
+};
+
+class JitX64 {
+public:
+    JitX64();
+    ~JitX64();
+
+    // True when this build/host can run native code (x86-64, executable mmap)
+    static bool Supported();
+    bool Ok() const { return arena != nullptr; } // False too when pages cannot be made executable
+
+    // Compile the block's leading run of supported ops. nullptr when the first
+    // op is unsupported or the arena is full (check Full()).
+    const JitCode* Compile(const Cpu::Block& block);
+    bool Full() const { return full; }
+    void Reset(); // Discard all compiled code
+
+    // Run compiled code on the Cpu. Returns the number of block ops completed
+    // (0 if entry conditions fail); PC is set when the terminator ran.
+    int Run(Cpu& cpu, const JitCode& code);
+
+    size_t CompiledBlocks() const { return codes.size(); }
+
+private:
+    bool CopyIn(uint8_t* dst, const std::vector<uint8_t>& code); // Unprotect, copy, reprotect
+
+    uint8_t* arena = nullptr;
+    size_t arena_size = 0;
+    size_t arena_used = 0;
+    size_t page_bytes = 0;
+    bool full = false;
+    std::vector<std::unique_ptr<JitCode>> codes;
+    JitState state;
+};
@@ -171,6 +171,19 @@ bool Linker::Link() {
         }
     }
     
+    // Output symbol table (globals and locals, for debuggers/profilers)
+    outputSymbols.clear();
+    for(const auto& file : inputs) {
+        for(const auto& sym : file.symbols) {
+            int64_t fileOffset = 0;
+            for(const auto& fo : fileOffsets) {if (fo.filename == file.filename && fo.sectionName == sym.section) { fileOffset = fo.startOffset; break; }}
+            Symbol out = sym;
+            out.offset = fileOffset + sym.offset;
+            out.finalAddress = sectionMap[sym.section].startAddress + out.offset;
+            outputSymbols.push_back(out);
+        }
+    }
+    
     // 5. Apply Relocations
     for(const auto& file : inputs) {
         for(const auto& reloc : file.relocations) {
@@ -258,7 +271,28 @@ bool Linker::WriteOutput(const std::string& path) {
         }
         out << "\n";
     }
+
+    // Same layout as the assembler's object files (offsets into the sections above)
+    out << "SYMBOLS " << outputSymbols.size() << "\n";
+    for(const auto& sym : outputSymbols) {
+        out << sym.name << " " << sym.section << " " << sym.offset << " " << (sym.isGlobal ? "G" : "L") << "\n";
+    }
     
     out.close();
     return true;
 }
+
+bool Linker::LoadSymbols(const std::string& path, std::vector<Symbol>& symbols) {
+    Linker reader;
+    if (!reader.LoadObjectFile(path)) return false;
+    const ObjectFile& file = reader.inputs.back();
+    for(Symbol sym : file.symbols) {
+        int64_t base = 0;
+        for(const auto& sec : file.sections) {
+            if (sec.name == sym.section) { base = sec.baseAddress; break; }
+        }
+        sym.finalAddress = base + sym.offset;
+        symbols.push_back(sym);
+    }
+    return true;
+}
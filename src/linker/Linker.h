@@ -52,6 +52,10 @@ public:
     // Write Output Executable (.hx)
     bool WriteOutput(const std::string& path);
 
+    // Symbol table of an object (.ht) or linked executable (.hx), with
+    // finalAddress = section base + offset (profiler symbolization)
+    static bool LoadSymbols(const std::string& path, std::vector<Symbol>& symbols);
+
 private:
     std::vector<ObjectFile> inputs;
     
@@ -64,6 +68,7 @@ private:
     std::vector<ExecutableSection> outputSections;
     
     std::map<std::string, int64_t> globalSymbolTable; // Symbol -> Absolute Address
+    std::vector<Symbol> outputSymbols; // All symbols, offsets relative to their output section
     
     // Helpers
     void MergeSections();
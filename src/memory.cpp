@@ -1,11 +1,82 @@
 #include "memory.h"
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
 TernaryMemory::TernaryMemory() : current_context_id(0) {
     // System Memory: 3*243*9 (~12K words). Spec sets Reserved up to 0x2FFF.
     // 0x3000 = 12288 decimal.
-    system_memory.resize(12288, TernaryWord::FromInt64(0));
+    // Every page starts out as the shared zero page; the block is allocated by the first write
+    static TernaryWord zero_page[PAGE_SIZE];
+    for (int p = 0; p < SYSTEM_PAGES; ++p) {
+        system_pages[p] = std::shared_ptr<TernaryWord>(std::shared_ptr<TernaryWord>(), zero_page); // Not owning
+        system_words[p] = zero_page;
+        system_owned[p] = false;
+    }
+    system_versions.resize(SYSTEM_PAGES, 1); // 0 is reserved for "never decoded"
+}
+
+void TernaryMemory::MakeSystemWritable(int64_t first_page, int64_t last_page) {
+    for (int64_t p = first_page; p <= last_page; ++p) {
+        if (system_owned[p]) continue;
+        if (!system_block) {
+            // Uninitialized: a page is only used once copied home
+            std::allocator<TernaryWord> alloc;
+            system_block.reset(alloc.allocate(SYSTEM_SIZE), [](TernaryWord* words) {
+                std::allocator<TernaryWord>().deallocate(words, SYSTEM_SIZE);
+            });
+        }
+        TernaryWord* home = system_block.get() + p * PAGE_SIZE;
+        std::uninitialized_copy(system_words[p], system_words[p] + PAGE_SIZE, home);
+        system_pages[p] = std::shared_ptr<TernaryWord>(system_block, home);
+        system_words[p] = home;
+        system_owned[p] = true;
+    }
+}
+
+Page& TernaryMemory::WritablePage(std::shared_ptr<Page>& page) {
+    if (page->shared) {
+        page = std::make_shared<Page>(*page);
+        page->shared = false;
+    }
+    return *page;
+}
+
+TernaryMemory::Snapshot TernaryMemory::TakeSnapshot() {
+    Snapshot snapshot;
+    for (int p = 0; p < SYSTEM_PAGES; ++p) {
+        snapshot.system_pages[p] = system_pages[p];
+        system_owned[p] = false;
+    }
+    system_block.reset(); // Now (partly) the snapshot's: writes start a new block
+    for (auto& entry : cognitive_pages) {
+        if (!entry.second->shared) entry.second->shared = true;
+    }
+    snapshot.pages = cognitive_pages;
+    snapshot.context_id = current_context_id;
+    return snapshot;
+}
+
+void TernaryMemory::Restore(const Snapshot& snapshot) {
+    for (int p = 0; p < SYSTEM_PAGES; ++p) {
+        if (system_words[p] == snapshot.system_pages[p].get()) continue; // Unchanged since taken
+        system_pages[p] = snapshot.system_pages[p];
+        system_words[p] = system_pages[p].get();
+        system_owned[p] = false;
+        system_versions[p]++;
+    }
+    cognitive_pages = snapshot.pages;
+    current_context_id = snapshot.context_id;
+}
+
+void TernaryMemory::InvalidateCode(int64_t addr, int64_t length) {
+    if (length <= 0) return;
+    int64_t first = addr < 0 ? 0 : addr;
+    int64_t last = addr + length - 1;
+    if (last >= SYSTEM_SIZE) last = SYSTEM_SIZE - 1;
+    for (int64_t page = first / PAGE_SIZE; page <= last / PAGE_SIZE && first <= last; ++page) {
+        system_versions[page]++;
+    }
 }
 
 // ... DecodeAddress ...
@@ -24,8 +95,7 @@ void TernaryMemory::AllocatePage(int64_t page_id) {
     AllocatePage(page_id, 0, PERM_OWNER_READ | PERM_OWNER_WRITE);
 }
 
-std::pair<int64_t, int64_t> TernaryMemory::DecodeAddress(const TernaryWord& address) {
-    int64_t addr = address.ToInt64();
+std::pair<int64_t, int64_t> TernaryMemory::DecodeAddress(int64_t addr) {
     if (addr < 0) addr = 0; // Clamp negative?
     
     // Page ID for Cognitive Memory
@@ -38,6 +108,13 @@ bool TernaryMemory::IsPageAllocated(int64_t page_id) const {
     return cognitive_pages.find(page_id) != cognitive_pages.end();
 }
 
+size_t TernaryMemory::FootprintBytes() const {
+    size_t bytes = SYSTEM_SIZE * sizeof(TernaryWord);
+    for (const auto& entry : cognitive_pages) {
+        bytes += sizeof(Page) + entry.second->words.capacity() * sizeof(TernaryWord);
+    }
+    return bytes;
+}
 
 void TernaryMemory::OptimizePage(int64_t page_id) {
     if (!IsPageAllocated(page_id)) return;
@@ -57,17 +134,16 @@ void TernaryMemory::OptimizePage(int64_t page_id) {
     }
 }
 
-TernaryWord TernaryMemory::Read(const TernaryWord& address) {
-    int64_t addr = address.ToInt64();
+TernaryWord TernaryMemory::ReadWord(int64_t addr) {
     
     // 1. System Memory (Fast Path)
     if (addr < 0x3000) {
-        if (addr < 0 || addr >= (int64_t)system_memory.size()) return TernaryWord::FromInt64(0);
-        return system_memory[addr];
+        if (addr < 0) return TernaryWord::FromInt64(0);
+        return system_words[addr / PAGE_SIZE][addr % PAGE_SIZE];
     }
     
     // 2. Cognitive Memory (Sparse)
-    auto pair = DecodeAddress(address);
+    auto pair = DecodeAddress(addr);
     int64_t page_id = pair.first;
     int64_t offset = pair.second;
     
@@ -88,20 +164,21 @@ TernaryWord TernaryMemory::Read(const TernaryWord& address) {
     return TernaryWord::FromInt64(0);
 }
 
-TernaryWord* TernaryMemory::GetRawPointer(const TernaryWord& address, int length) {
-    int64_t addr = address.ToInt64();
+TernaryWord* TernaryMemory::RawPointer(int64_t addr, int length) {
     if (length <= 0) return nullptr;
     
     // 1. System Memory fast-path (Flat)
     if (addr < 0x3000) {
-        if (addr >= 0 && (addr + length) <= (int64_t)system_memory.size()) {
-            return &system_memory[addr];
+        if (addr >= 0 && (addr + length) <= SYSTEM_SIZE) {
+            InvalidateCode(addr, length); // Caller may write through the pointer
+            MakeSystemWritable(addr / PAGE_SIZE, (addr + length - 1) / PAGE_SIZE);
+            return system_words[addr / PAGE_SIZE] + addr % PAGE_SIZE; // Owned pages are contiguous
         }
         return nullptr;
     }
     
     // 2. Cognitive Memory (Paged)
-    auto pair = DecodeAddress(address);
+    auto pair = DecodeAddress(addr);
     int64_t page_id = pair.first;
     int64_t offset = pair.second;
     
@@ -111,26 +188,52 @@ TernaryWord* TernaryMemory::GetRawPointer(const TernaryWord& address, int length
         return nullptr; // Caller must fallback to safe Read()
     }
     
-    if (IsPageAllocated(page_id)) {
-        auto& p = cognitive_pages[page_id];
+    auto it = cognitive_pages.find(page_id);
+    if (it != cognitive_pages.end()) {
+        auto& p = it->second;
         // Permission Check (Read)
         if (current_context_id != 0 && current_context_id != p->owner_id) {
             return nullptr; // Denied (Caller should use Read() to get access violation error print)
         }
-        return &p->words[offset];
+        return &WritablePage(p).words[offset];
     }
     
     return nullptr; // Unallocated
 }
 
 
-void TernaryMemory::Write(const TernaryWord& address, const TernaryWord& value) {
-    int64_t addr = address.ToInt64();
+void TernaryMemory::SetWatches(const std::vector<int64_t>& addrs) {
+    watches = addrs;
+    std::sort(watches.begin(), watches.end());
+    watches.erase(std::unique(watches.begin(), watches.end()), watches.end());
+    watch_hit = false;
+}
+
+void TernaryMemory::CheckWatch(int64_t addr) {
+    if (!watch_hit && std::binary_search(watches.begin(), watches.end(), addr)) {
+        watch_hit = true;
+        watch_addr = addr;
+    }
+}
+
+HostProfile::MemPath TernaryMemory::Classify(int64_t addr) const {
+    if (addr < 0x3000) return HostProfile::MEM_SYSTEM;
+    return IsPageAllocated(DecodeAddress(addr).first) ? HostProfile::MEM_COGNITIVE : HostProfile::MEM_UNALLOCATED;
+}
+
+void TernaryMemory::WriteWord(int64_t addr, const TernaryWord& value) {
+    if (!watches.empty()) CheckWatch(addr);
     
     // 1. System Memory
     if (addr < 0x3000) {
-        if (addr >= 0 && addr < (int64_t)system_memory.size()) {
-            system_memory[addr] = value;
+        if (addr >= 0) {
+            int64_t page = addr / PAGE_SIZE;
+            TernaryWord& slot = system_words[page][addr % PAGE_SIZE];
+            if (slot.pos != value.pos || slot.neg != value.neg) {
+                system_versions[page]++;
+                if (!system_owned[page]) MakeSystemWritable(page, page);
+                system_words[page][addr % PAGE_SIZE] = value;
+            }
         }
         return;
     }
@@ -147,7 +250,7 @@ void TernaryMemory::Write(const TernaryWord& address, const TernaryWord& value)
     }
     
     // 2. Cognitive Memory
-    auto pair = DecodeAddress(address);
+    auto pair = DecodeAddress(addr);
     int64_t page_id = pair.first;
     int64_t offset = pair.second;
     
@@ -175,8 +278,208 @@ void TernaryMemory::Write(const TernaryWord& address, const TernaryWord& value)
              return;
         }
 
-        p->words[offset] = value;
+        WritablePage(p).words[offset] = value;
+    }
+}
+
+// --- Span Transfers ---
+
+const TernaryWord* TernaryMemory::ReadablePage(int64_t page_id, HostProfile::MemPath& path) {
+    if (page_id < SYSTEM_PAGES) {
+        path = HostProfile::MEM_SYSTEM;
+        return system_words[page_id];
+    }
+    auto it = cognitive_pages.find(page_id);
+    if (it == cognitive_pages.end()) {
+        path = HostProfile::MEM_UNALLOCATED;
+        return nullptr;
+    }
+    path = HostProfile::MEM_COGNITIVE;
+    const Page& p = *it->second;
+    if (current_context_id != 0 && current_context_id != p.owner_id) {
+        std::cerr << "[MMU] Access Violation: Agent " << current_context_id
+                  << " cannot Read Page " << page_id << " (Owner " << p.owner_id << ")" << std::endl;
+        return nullptr;
+    }
+    return p.words.data();
+}
+
+TernaryWord* TernaryMemory::WritableCognitivePage(int64_t page_id) {
+    auto& p = cognitive_pages.find(page_id)->second;
+    bool is_system = (current_context_id == 0);
+    bool is_owner = (current_context_id == p->owner_id);
+    if (!is_system && !is_owner) {
+        std::cerr << "[MMU] Access Violation: Agent " << current_context_id
+                  << " cannot Write Page " << page_id << " (Owner " << p->owner_id << ")" << std::endl;
+        return nullptr;
+    }
+    if (is_owner && !(p->permissions & PERM_OWNER_WRITE)) {
+        std::cerr << "[MMU] Write Fault: Page " << page_id << " is Read-Only for Owner." << std::endl;
+        return nullptr;
+    }
+    return WritablePage(p).words.data();
+}
+
+void TernaryMemory::ReadBlock(int64_t addr, TernaryWord* out, size_t n) {
+    while (n) {
+        uint64_t t0 = host_profile ? HostProfile::Ticks() : 0;
+        HostProfile::MemPath path = HostProfile::MEM_SYSTEM;
+        size_t count;
+        if (addr < 0) {
+            count = (size_t)std::min<uint64_t>(n, (uint64_t)-addr);
+            std::fill(out, out + count, TernaryWord());
+        } else {
+            int64_t offset = addr % PAGE_SIZE;
+            count = (size_t)std::min<int64_t>((int64_t)n, PAGE_SIZE - offset);
+            const TernaryWord* words = ReadablePage(addr / PAGE_SIZE, path);
+            if (words) std::copy(words + offset, words + offset + count, out);
+            else std::fill(out, out + count, TernaryWord());
+        }
+        if (host_profile) host_profile->mem[path].Add(HostProfile::Ticks() - t0);
+        addr += (int64_t)count;
+        out += count;
+        n -= count;
+    }
+}
+
+void TernaryMemory::WriteBlock(int64_t addr, const TernaryWord* in, size_t n) {
+    if (!watches.empty() && n) {
+        // The first watched address written is the lowest one in the span
+        auto it = std::lower_bound(watches.begin(), watches.end(), addr);
+        if (it != watches.end() && (uint64_t)(*it - addr) < n) CheckWatch(*it);
+    }
+    while (n) {
+        uint64_t t0 = host_profile ? HostProfile::Ticks() : 0;
+        HostProfile::MemPath path = HostProfile::MEM_SYSTEM;
+        size_t count;
+        if (addr < 0) {
+            count = (size_t)std::min<uint64_t>(n, (uint64_t)-addr); // Dropped
+        } else if (addr == 0x8000) {
+            path = HostProfile::MEM_DEVICE;
+            count = 1;
+            std::cout << (char)in[0].ToInt64();
+            std::cout.flush();
+        } else {
+            int64_t page = addr / PAGE_SIZE;
+            int64_t offset = addr % PAGE_SIZE;
+            count = (size_t)std::min<int64_t>((int64_t)n, PAGE_SIZE - offset);
+            if (addr < 0x8000 && addr + (int64_t)count > 0x8000) count = (size_t)(0x8000 - addr); // UART is its own span
+            if (page < SYSTEM_PAGES) {
+                TernaryWord* slot = system_words[page] + offset;
+                size_t i = 0;
+                while (i < count && slot[i].pos == in[i].pos && slot[i].neg == in[i].neg) ++i;
+                if (i < count) {
+                    system_versions[page]++;
+                    if (!system_owned[page]) MakeSystemWritable(page, page);
+                    std::copy(in + i, in + count, system_words[page] + offset + i);
+                }
+            } else {
+                size_t skip = 0;
+                if (!IsPageAllocated(page)) {
+                    // Auto-allocate at the first word that is not 0, as Write does
+                    path = HostProfile::MEM_UNALLOCATED;
+                    while (skip < count && in[skip].ToInt64() == 0) ++skip;
+                    if (skip < count) AllocatePage(page);
+                } else {
+                    path = HostProfile::MEM_COGNITIVE;
+                }
+                TernaryWord* words = skip < count ? WritableCognitivePage(page) : nullptr;
+                if (words) std::copy(in + skip, in + count, words + offset + skip);
+            }
+        }
+        if (host_profile) host_profile->mem[path].Add(HostProfile::Ticks() - t0);
+        addr += (int64_t)count;
+        in += count;
+        n -= count;
+    }
+}
+
+const TernaryWord* TernaryMemory::ReadPage(int64_t page_id) {
+    if (page_id < 0) return nullptr;
+    if (!host_profile) {
+        HostProfile::MemPath path;
+        return ReadablePage(page_id, path);
+    }
+    uint64_t t0 = HostProfile::Ticks();
+    HostProfile::MemPath path;
+    const TernaryWord* words = ReadablePage(page_id, path);
+    host_profile->mem[path].Add(HostProfile::Ticks() - t0);
+    return words;
+}
+
+template <class AddrFn> void TernaryMemory::GatherWords(AddrFn address, TernaryWord* out, size_t n) {
+    int64_t page = -1; // Resolved page
+    const TernaryWord* words = nullptr;
+    HostProfile::MemPath path = HostProfile::MEM_SYSTEM;
+    uint64_t t0 = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int64_t a = address(i);
+        if (a < 0) {
+            out[i] = TernaryWord();
+            continue;
+        }
+        if (a / PAGE_SIZE != page) {
+            if (host_profile) {
+                uint64_t t = HostProfile::Ticks();
+                if (page >= 0) host_profile->mem[path].Add(t - t0);
+                t0 = t;
+            }
+            page = a / PAGE_SIZE;
+            words = ReadablePage(page, path);
+        }
+        out[i] = words ? words[a % PAGE_SIZE] : TernaryWord();
+    }
+    if (host_profile && page >= 0) host_profile->mem[path].Add(HostProfile::Ticks() - t0);
+}
+
+template <class AddrFn> void TernaryMemory::ScatterWords(AddrFn address, const TernaryWord* in, size_t n) {
+    int64_t page = -1; // Resolved cognitive page
+    TernaryWord* words = nullptr;
+    bool allocated = false; // Else words is null until a word that is not 0 allocates it
+    uint64_t t0 = 0;
+    auto close = [&] {
+        if (host_profile && page >= 0) {
+            host_profile->mem[allocated ? HostProfile::MEM_COGNITIVE : HostProfile::MEM_UNALLOCATED].Add(HostProfile::Ticks() - t0);
+        }
+        page = -1;
+    };
+    for (size_t i = 0; i < n; ++i) {
+        int64_t a = address(i);
+        if (a < SYSTEM_SIZE || a == 0x8000) {
+            close();
+            Write(a, in[i]); // Flat system memory and the UART: nothing to resolve
+            continue;
+        }
+        if (!watches.empty()) CheckWatch(a);
+        if (a / PAGE_SIZE != page) {
+            close();
+            if (host_profile) t0 = HostProfile::Ticks();
+            page = a / PAGE_SIZE;
+            allocated = IsPageAllocated(page);
+            words = allocated ? WritableCognitivePage(page) : nullptr;
+        }
+        if (!allocated) {
+            if (in[i].ToInt64() == 0) continue;
+            AllocatePage(page);
+            allocated = true;
+            words = WritableCognitivePage(page);
+        }
+        if (words) words[a % PAGE_SIZE] = in[i];
     }
+    close();
+}
+
+void TernaryMemory::ReadStrided(int64_t addr, int64_t stride, TernaryWord* out, size_t n) {
+    if (stride == 1) return ReadBlock(addr, out, n);
+    GatherWords([=](size_t i) { return addr + (int64_t)i * stride; }, out, n);
+}
+
+void TernaryMemory::Gather(const int64_t* addrs, TernaryWord* out, size_t n) {
+    GatherWords([=](size_t i) { return addrs[i]; }, out, n);
+}
+
+void TernaryMemory::Scatter(const int64_t* addrs, const TernaryWord* in, size_t n) {
+    ScatterWords([=](size_t i) { return addrs[i]; }, in, n);
 }
 
 #include <fstream>
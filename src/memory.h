@@ -1,5 +1,6 @@
 #pragma once
 #include "trit_word.h"
+#include "host_profile.h"
 #include <unordered_map>
 #include <vector>
 #include <memory>
@@ -22,6 +23,7 @@ struct Page {
     std::vector<TernaryWord> words;
     uint32_t owner_id;
     uint8_t permissions; 
+    bool shared = false; // Referenced by a snapshot: copied before any write
     
     Page() : owner_id(0), permissions(PERM_OWNER_READ | PERM_OWNER_WRITE) { 
         words.resize(PAGE_SIZE, TernaryWord::FromInt64(0)); 
@@ -30,9 +32,24 @@ struct Page {
 
 class TernaryMemory {
 private:
-    std::vector<TernaryWord> system_memory; // 0x0000 - 0x2FFF
+    std::vector<uint64_t> system_versions;   // Per-page write generation (code cache tags)
     std::unordered_map<int64_t, std::shared_ptr<Page>> cognitive_pages; // PageID -> Page
     uint32_t current_context_id; // 0 = System (Root)
+    std::vector<int64_t> watches; // Sorted
+    bool watch_hit = false;
+    int64_t watch_addr = 0;
+
+    void CheckWatch(int64_t addr);
+    void MakeSystemWritable(int64_t first_page, int64_t last_page); // Copy shared pages home
+    static Page& WritablePage(std::shared_ptr<Page>& page);          // Copy if shared
+    TernaryWord ReadWord(int64_t addr);
+    void WriteWord(int64_t addr, const TernaryWord& value);
+    TernaryWord* RawPointer(int64_t addr, int length);
+    HostProfile::MemPath Classify(int64_t addr) const; // Path the access is about to take
+    const TernaryWord* ReadablePage(int64_t page_id, HostProfile::MemPath& path); // Null: reads as zeros
+    TernaryWord* WritableCognitivePage(int64_t page_id); // Null: denied (reported)
+    template <class AddrFn> void GatherWords(AddrFn address, TernaryWord* out, size_t n);
+    template <class AddrFn> void ScatterWords(AddrFn address, const TernaryWord* in, size_t n);
 
 public:
     TernaryMemory();
@@ -41,14 +58,74 @@ public:
     void SetContext(uint32_t context_id) { current_context_id = context_id; }
     uint32_t GetContext() const { return current_context_id; }
     
-    // Read/Write
-    TernaryWord Read(const TernaryWord& address);
-    void Write(const TernaryWord& address, const TernaryWord& value);
+    // Host cost attribution (Cpu::SetHostProfile); null when not profiling
+    HostProfile* host_profile = nullptr;
     
-    // Raw Access for Vector Unit Performance
+    // Read/Write
+    TernaryWord Read(int64_t addr) {
+        if (!host_profile) return ReadWord(addr);
+        HostProfile::MemPath path = Classify(addr);
+        uint64_t t0 = HostProfile::Ticks();
+        TernaryWord value = ReadWord(addr);
+        host_profile->mem[path].Add(HostProfile::Ticks() - t0);
+        return value;
+    }
+    void Write(int64_t addr, const TernaryWord& value) {
+        if (!host_profile) return WriteWord(addr, value);
+        HostProfile::MemPath path = addr == 0x8000 ? HostProfile::MEM_DEVICE : Classify(addr);
+        uint64_t t0 = HostProfile::Ticks();
+        WriteWord(addr, value);
+        host_profile->mem[path].Add(HostProfile::Ticks() - t0);
+    }
+    TernaryWord Read(const TernaryWord& address) { return Read(address.ToInt64()); }
+    void Write(const TernaryWord& address, const TernaryWord& value) { Write(address.ToInt64(), value); }
+
+    // Span Transfers
+    // Same results as a Read/Write per word, in order, but each page a span
+    // touches is looked up and permission checked once: contiguous words are
+    // copied a page at a time, strided/gathered ones resolve a page again only
+    // when the address leaves it. An access violation is reported once per page
+    // resolution instead of once per word. The host profile counts one access
+    // per page resolution.
+    void ReadBlock(int64_t addr, TernaryWord* out, size_t n);
+    void WriteBlock(int64_t addr, const TernaryWord* in, size_t n);
+    void ReadStrided(int64_t addr, int64_t stride, TernaryWord* out, size_t n); // out[i] = [addr + i*stride]
+    void Gather(const int64_t* addrs, TernaryWord* out, size_t n);
+    void Scatter(const int64_t* addrs, const TernaryWord* in, size_t n);
+    // Read-only view of page page_id's PAGE_SIZE words, as Read sees them (page
+    // ops). Null when the page reads as zeros: unallocated, negative, or denied
+    // (reported once). Valid until the next write or snapshot restore.
+    const TernaryWord* ReadPage(int64_t page_id);
+
+    // Raw (Mutable) Access
     // Returns a raw pointer if 'length' words are contiguous and safe to access.
-    // Returns nullptr if crossing a page boundary or unallocated.
-    TernaryWord* GetRawPointer(const TernaryWord& address, int length);
+    // Returns nullptr if crossing a page boundary or unallocated. Counts as a
+    // write: bumps the code generation of the system pages it spans and takes
+    // private copies of snapshot-shared pages. Readers use the span transfers.
+    TernaryWord* GetRawPointer(const TernaryWord& address, int length) {
+        if (!host_profile) return RawPointer(address.ToInt64(), length);
+        uint64_t t0 = HostProfile::Ticks();
+        TernaryWord* ptr = RawPointer(address.ToInt64(), length);
+        host_profile->mem[ptr ? HostProfile::MEM_RAW_HIT : HostProfile::MEM_RAW_MISS].Add(HostProfile::Ticks() - t0);
+        return ptr;
+    }
+
+    // Code Versioning (Predecode Cache)
+    // Every store that changes a system memory word bumps the generation of its
+    // 256-word page; handing out a raw (mutable) pointer bumps the pages it spans.
+    // Decoded instructions tagged with an older generation are stale.
+    static const int64_t SYSTEM_SIZE = 0x3000;
+    uint64_t CodeVersion(int64_t addr) const { return system_versions[addr / PAGE_SIZE]; }
+    void InvalidateCode(int64_t addr, int64_t length);
+    
+    // Watched Addresses (Cpu::RunUntil)
+    // Any Write to a watched address is latched (the first one until cleared);
+    // the CPU cores stop after the instruction that made it.
+    void SetWatches(const std::vector<int64_t>& addrs);
+    const std::vector<int64_t>& Watches() const { return watches; }
+    bool WatchHit() const { return watch_hit; }
+    int64_t WatchAddress() const { return watch_addr; }
+    void ClearWatchHit() { watch_hit = false; }
     
     // Sparse Helpers
     bool IsPageAllocated(int64_t page_id) const;
@@ -56,9 +133,40 @@ public:
     void AllocatePage(int64_t page_id, uint32_t owner, uint8_t perms); // Overload
     void OptimizePage(int64_t page_id); // Check if empty -> Deallocate
 
+    // Footprint (Diagnostics)
+    size_t AllocatedPageCount() const { return cognitive_pages.size(); }
+    size_t FootprintBytes() const; // System memory + allocated pages
+
     // Legacy Loading
     bool LoadExecutable(const std::string& filename);
     bool LoadFromFile(const std::string& filename, int64_t startAddr);
     
-    static std::pair<int64_t, int64_t> DecodeAddress(const TernaryWord& address);
+    static std::pair<int64_t, int64_t> DecodeAddress(int64_t addr);
+    static std::pair<int64_t, int64_t> DecodeAddress(const TernaryWord& address) { return DecodeAddress(address.ToInt64()); }
+
+    // Snapshots (copy-on-write)
+    // A snapshot references the memory's pages instead of copying them: from
+    // then on neither side writes a referenced page in place, the writer takes
+    // a private copy first (system pages go back to a contiguous block of their
+    // own, so GetRawPointer ranges stay contiguous). Taking or restoring one
+    // costs a pointer per system page and per allocated cognitive page.
+    // Restore bumps the code generation only of system pages whose contents
+    // it replaces, so decoded code elsewhere stays cached.
+    static const int SYSTEM_PAGES = SYSTEM_SIZE / PAGE_SIZE;
+    struct Snapshot {
+        std::shared_ptr<TernaryWord> system_pages[SYSTEM_PAGES]; // PAGE_SIZE words each, never written
+        std::unordered_map<int64_t, std::shared_ptr<Page>> pages; // All marked shared
+        uint32_t context_id = 0;
+    };
+    Snapshot TakeSnapshot();
+    void Restore(const Snapshot& snapshot);
+
+private:
+    // System memory (0x0000 - 0x2FFF) in PAGE_SIZE pages. Owned pages sit at
+    // their home slot in system_block; shared ones (and never written ones, on
+    // a common zero page) wherever their snapshot keeps them.
+    std::shared_ptr<TernaryWord> system_block;               // Null after a snapshot until the next write
+    std::shared_ptr<TernaryWord> system_pages[SYSTEM_PAGES]; // Keeps each page's storage alive
+    TernaryWord* system_words[SYSTEM_PAGES];                 // system_pages[p].get()
+    bool system_owned[SYSTEM_PAGES];                         // At its home slot, writable in place
 };
@@ -4,11 +4,13 @@
 #include <cassert>
 #include <vector>
 #include <random>
+#include <algorithm>
 
 // Advanced Testing for Sparse Memory & Cognitive Trace
 // 1. Stress Test Allocation
 // 2. Test Sparsity Optimization
 // 3. Test Boundary Conditions
+// 4. Span Transfers (ReadBlock etc.) against per-word Read/Write
 
 void Assert(bool cond, const std::string& msg) {
     if (!cond) {
@@ -75,6 +77,75 @@ int main() {
     Assert(mem.Read(TernaryWord::FromInt64(0x3000)).ToInt64() == 456, "Cognitive read");
     
     std::cout << "PASS: Memory Boundaries." << std::endl;
+
+    // --- Test 4: Span Transfers vs Word Access ---
+    std::cout << "[Test] Block/Strided/Gather/Scatter..." << std::endl;
+    {
+        // Same ops on two memories: spans on one, a Read/Write per word on the other
+        TernaryMemory span_mem, word_mem;
+        span_mem.AllocatePage(0x5000 / 256, 7, PERM_OWNER_READ | PERM_OWNER_WRITE); // Foreign to context 9
+        word_mem.AllocatePage(0x5000 / 256, 7, PERM_OWNER_READ | PERM_OWNER_WRITE);
+        std::mt19937 rng(24);
+        auto addr = [&] { return (int64_t)(rng() % 0x3400) - 0x100 + (rng() % 2) * 0x2300; }; // Negative to 0x5700
+        std::vector<TernaryWord> in(700), a(700), b(700);
+        std::vector<int64_t> addrs(700);
+        for (int round = 0; round < 300; ++round) {
+            for (TernaryWord& w : in) w = TernaryWord::FromInt64(rng() % 3 ? 0 : (int64_t)(rng() % 2001) - 1000);
+            uint32_t context = rng() % 4 == 0 ? 9 : 0;
+            span_mem.SetContext(context);
+            word_mem.SetContext(context);
+            size_t n = rng() % (context ? 24 : in.size()); // Word access reports every denied word
+            int64_t base = addr();
+            int64_t stride = (int64_t)(rng() % 9) - 4;
+            for (size_t i = 0; i < n; ++i) addrs[i] = addr();
+            switch (round % 5) {
+                case 0:
+                    span_mem.WriteBlock(base, in.data(), n);
+                    for (size_t i = 0; i < n; ++i) word_mem.Write(base + (int64_t)i, in[i]);
+                    break;
+                case 1:
+                    span_mem.Scatter(addrs.data(), in.data(), n);
+                    for (size_t i = 0; i < n; ++i) word_mem.Write(addrs[i], in[i]);
+                    break;
+                case 2:
+                    span_mem.ReadBlock(base, a.data(), n);
+                    for (size_t i = 0; i < n; ++i) b[i] = word_mem.Read(base + (int64_t)i);
+                    break;
+                case 3:
+                    span_mem.ReadStrided(base, stride, a.data(), n);
+                    for (size_t i = 0; i < n; ++i) b[i] = word_mem.Read(base + (int64_t)i * stride);
+                    break;
+                case 4:
+                    span_mem.Gather(addrs.data(), a.data(), n);
+                    for (size_t i = 0; i < n; ++i) b[i] = word_mem.Read(addrs[i]);
+                    break;
+            }
+            if (round % 5 >= 2) {
+                for (size_t i = 0; i < n; ++i) Assert(a[i].pos == b[i].pos && a[i].neg == b[i].neg, "Span read matches Read");
+            }
+        }
+        span_mem.SetContext(0);
+        word_mem.SetContext(0);
+        Assert(span_mem.AllocatedPageCount() == word_mem.AllocatedPageCount(), "Span writes allocate like Write");
+        for (int64_t x = 0; x < 0x5800; ++x) {
+            TernaryWord s = span_mem.Read(x), w = word_mem.Read(x);
+            Assert(s.pos == w.pos && s.neg == w.neg, "Span writes match Write");
+        }
+
+        // All-zero spans leave unallocated pages alone; changed system pages get a new code version
+        std::vector<TernaryWord> zeros(PAGE_SIZE);
+        span_mem.WriteBlock(0x6000, zeros.data(), zeros.size());
+        Assert(!span_mem.IsPageAllocated(0x6000 / 256), "Zero span does not allocate");
+        uint64_t version = span_mem.CodeVersion(0x100);
+        span_mem.ReadBlock(0x100, a.data(), 16);
+        span_mem.WriteBlock(0x100, a.data(), 16);
+        Assert(span_mem.CodeVersion(0x100) == version, "Unchanged span keeps code version");
+        span_mem.WriteBlock(0x100, in.data() + 1, 16);
+        Assert(span_mem.CodeVersion(0x100) != version || std::equal(a.begin(), a.begin() + 16, in.begin() + 1,
+               [](const TernaryWord& x, const TernaryWord& y) { return x.pos == y.pos && x.neg == y.neg; }),
+               "Changed span bumps code version");
+    }
+    std::cout << "PASS: Span Transfers." << std::endl;
     
     std::cout << "--- Advanced Tests Complete ---" << std::endl;
     return 0;
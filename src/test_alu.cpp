@@ -1,6 +1,16 @@
 #include <iostream>
 #include <cassert>
+#include <random>
 #include "trit_word.h"
+#include "trit_span.h"
+
+// Unlike assert, still checks in the NDEBUG (Release) build
+void Check(bool cond, const char* what) {
+    if (!cond) {
+        std::cout << "FAIL: " << what << std::endl;
+        exit(1);
+    }
+}
 
 void TestConversion() {
     std::cout << "Testing Conversion..." << std::endl;
@@ -15,6 +25,52 @@ void TestConversion() {
     std::cout << "Conversion Passed." << std::endl;
 }
 
+void TestConversionTables() {
+    std::cout << "Testing Table Conversion vs Reference..." << std::endl;
+    const int64_t MAX27 = 3812798742493LL; // (3^27 - 1) / 2
+
+    auto check = [](int64_t v) {
+        TernaryWord ref = TernaryWord::FromInt64Reference(v);
+        TernaryWord fast = TernaryWord::FromInt64(v);
+        if (ref.pos != fast.pos || ref.neg != fast.neg || fast.ToInt64() != ref.ToInt64Reference()) {
+            std::cout << "FAIL: " << v << " ref=" << ref.ToString() << " table=" << fast.ToString() << std::endl;
+            exit(1);
+        }
+    };
+
+    // Dense range around zero (covers every low chunk pattern)
+    for (int64_t v = -400000; v <= 400000; ++v) check(v);
+
+    // Range edges and chunk boundaries (3^9, 3^18 and their half-points)
+    int64_t edges[] = {MAX27, -MAX27, MAX27 + 1, -MAX27 - 1, 19683, 9841, 9842, -9842,
+                       387420489, 193710244, 193710245, -193710245,
+                       INT64_MAX - 3, INT64_MIN + 4};
+    for (int64_t e : edges) {
+        for (int64_t d = -3; d <= 3; ++d) {
+            check(e + d);
+        }
+    }
+
+    // Random values inside and far outside the 27-trit range (wraps mod 3^27).
+    // INT64_MIN is excluded: the reference loop overflows computing (v - 1) / 3.
+    std::mt19937_64 rng(42);
+    for (int k = 0; k < 1000000; ++k) {
+        check((int64_t)(rng() % (2 * MAX27 + 1)) - MAX27);
+        int64_t v = (int64_t)rng();
+        if (v != INT64_MIN) check(v);
+    }
+
+    // ToInt64 on arbitrary planes, including invalid (1,1) trits and high garbage bits
+    for (int k = 0; k < 1000000; ++k) {
+        TernaryWord w(rng(), rng());
+        if (w.ToInt64() != w.ToInt64Reference()) {
+            std::cout << "FAIL: ToInt64 on raw planes " << w.pos << "," << w.neg << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "Table Conversion Passed." << std::endl;
+}
+
 void TestLogic() {
     std::cout << "Testing Logic..." << std::endl;
     // +1 (p=1, n=0)
@@ -55,10 +111,488 @@ void TestArithmetic() {
     std::cout << "Arithmetic Passed." << std::endl;
 }
 
+// Builds a word from a base-3 digit index (0..3^len-1) placed at trit 'start'.
+TernaryWord WordFromDigits(int64_t index, int start, int len) {
+    TernaryWord w;
+    for (int i = 0; i < len; ++i) {
+        w.SetTrit(start + i, (int8_t)(index % 3) - 1);
+        index /= 3;
+    }
+    return w;
+}
+
+bool SameAdd(const TernaryWord& a, const TernaryWord& b) {
+    int8_t c_ref = 0, c_fast = 0;
+    TernaryWord ref = a.AddRipple(b, c_ref);
+    TernaryWord fast = a.Add(b, c_fast);
+    if (ref.pos != fast.pos || ref.neg != fast.neg || c_ref != c_fast) {
+        std::cout << "FAIL: " << a.ToString() << " + " << b.ToString()
+                  << " ripple=" << ref.ToString() << " c=" << (int)c_ref
+                  << " lookahead=" << fast.ToString() << " c=" << (int)c_fast << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void TestAdderEquivalence() {
+    std::cout << "Testing Lookahead Adder vs Ripple Reference..." << std::endl;
+    const int W = 6;
+    const int64_t N = 729; // 3^6
+
+    // Exhaustive: every pair of 6-trit windows, at the LSB and at the MSB (carry-out)
+    for (int start : {0, 27 - W}) {
+        for (int64_t i = 0; i < N; ++i) {
+            TernaryWord a = WordFromDigits(i, start, W);
+            for (int64_t j = 0; j < N; ++j) {
+                if (!SameAdd(a, WordFromDigits(j, start, W))) exit(1);
+            }
+        }
+    }
+
+    // Long carry chains: all +1 / all -1 words against every single-trit operand
+    TernaryWord all_pos((1ULL << 27) - 1, 0);
+    TernaryWord all_neg(0, (1ULL << 27) - 1);
+    for (int t = 0; t < 27; ++t) {
+        for (int8_t v : {(int8_t)-1, (int8_t)1}) {
+            TernaryWord b;
+            b.SetTrit(t, v);
+            if (!SameAdd(all_pos, b) || !SameAdd(all_neg, b)) exit(1);
+        }
+    }
+
+    // Random full-width words
+    std::mt19937_64 rng(1234);
+    for (int k = 0; k < 1000000; ++k) {
+        uint64_t ap = rng() & ((1ULL << 27) - 1);
+        uint64_t bp = rng() & ((1ULL << 27) - 1);
+        TernaryWord a(ap, rng() & ~ap & ((1ULL << 27) - 1));
+        TernaryWord b(bp, rng() & ~bp & ((1ULL << 27) - 1));
+        if (!SameAdd(a, b)) exit(1);
+    }
+
+    // Saturation follows the carry trit
+    int8_t carry = 0;
+    TernaryWord sat = all_pos.SaturatingAdd(TernaryWord::FromInt64(1), carry);
+    assert(carry == 1 && sat.pos == all_pos.pos && sat.neg == 0);
+    sat = all_neg.SaturatingAdd(TernaryWord::FromInt64(-1), carry);
+    assert(carry == -1 && sat.neg == all_neg.neg && sat.pos == 0);
+    sat = TernaryWord::FromInt64(40).SaturatingAdd(TernaryWord::FromInt64(2), carry);
+    assert(carry == 0 && sat.ToInt64() == 42);
+
+    std::cout << "Adder Equivalence Passed." << std::endl;
+}
+
+void TestBitplaneLogic() {
+    std::cout << "Testing Bitplane XOR/Shift/Slice vs Per-Trit Reference..." << std::endl;
+    std::mt19937_64 rng(7);
+    auto same = [](const TernaryWord& x, const TernaryWord& y) { return x.pos == y.pos && x.neg == y.neg; };
+
+    for (int k = 0; k < 200000; ++k) {
+        // Raw planes: includes (1,1) trits (read as +1 by GetTrit) and bits above trit 26
+        TernaryWord a(rng(), rng());
+        TernaryWord b(rng(), rng());
+
+        TernaryWord x_ref, l_ref, r_ref;
+        for (int i = 0; i < 27; ++i) {
+            int sum = a.GetTrit(i) + b.GetTrit(i);
+            if (sum > 1) sum = -1;
+            else if (sum < -1) sum = 1;
+            x_ref.SetTrit(i, sum);
+            if (i > 0) l_ref.SetTrit(i, a.GetTrit(i - 1));
+            if (i < 26) r_ref.SetTrit(i, a.GetTrit(i + 1));
+        }
+        if (!same(a.XOR(b), x_ref) || !same(a.ShiftLeft(), l_ref) || !same(a.ShiftRight(), r_ref)) {
+            std::cout << "FAIL: XOR/Shift on " << a.ToString() << " , " << b.ToString() << std::endl;
+            exit(1);
+        }
+
+        int start = (int)(rng() % 27);
+        int len = 1 + (int)(rng() % 30);
+        if (a.Slice(start, len) != a.SliceReference(start, len)) {
+            std::cout << "FAIL: Slice(" << start << "," << len << ") on " << a.ToString() << std::endl;
+            exit(1);
+        }
+
+        int64_t val = (int64_t)(rng() % 20000001) - 10000000;
+        TernaryWord s_fast = a, s_ref = a;
+        s_fast.SetSlice(start, len, val);
+        s_ref.SetSliceReference(start, len, val);
+        if (!same(s_fast, s_ref)) {
+            std::cout << "FAIL: SetSlice(" << start << "," << len << "," << val << ")" << std::endl;
+            exit(1);
+        }
+    }
+
+    // Decode fields round-trip: [Opcode(6)][Mode(3)][Rd(4)][Rs1(4)][Rs2/Imm(10)]
+    TernaryWord inst;
+    inst.SetSlice(21, 6, 36);
+    inst.SetSlice(18, 3, 4);
+    inst.SetSlice(14, 4, 15);
+    inst.SetSlice(10, 4, 7);
+    inst.SetSlice(0, 10, -29524);
+    assert(inst.Slice(21, 6) == 36 && inst.Slice(18, 3) == 4 && inst.Slice(14, 4) == 15);
+    assert(inst.Slice(10, 4) == 7 && inst.Slice(0, 10) == -29524);
+
+    std::cout << "Bitplane Logic Passed." << std::endl;
+}
+
+void TestMultiplyDivide() {
+    std::cout << "Testing Native Multiply/DivMod vs 128-bit Reference..." << std::endl;
+    std::mt19937_64 rng(13);
+    const int64_t POW3_27 = 7625597484987LL;
+    const int64_t HALF = (POW3_27 - 1) / 2;
+
+    for (int k = 0; k < 200000; ++k) {
+        // Mix full-range operands (bitplane path), ones whose int64 product
+        // spills into the high word, and small ones (the common MUL/DIV case)
+        int64_t range = (k % 3 == 0) ? HALF : (k % 3 == 1 ? 4000000 : 20000);
+        int64_t x = (int64_t)(rng() % (2 * range + 1)) - range;
+        int64_t y = (int64_t)(rng() % (2 * range + 1)) - range;
+        TernaryWord a = TernaryWord::FromInt64(x), b = TernaryWord::FromInt64(y);
+
+        // Product split into balanced low/high words: p = hi * 3^27 + lo
+        __int128 p = (__int128)x * y;
+        int64_t lo = (int64_t)(p % POW3_27);
+        if (lo > HALF) lo -= POW3_27;
+        if (lo < -HALF) lo += POW3_27;
+        int64_t hi = (int64_t)((p - lo) / POW3_27);
+
+        TernaryWord high, plane_high;
+        TernaryWord low = a.Multiply(b, high);
+        TernaryWord plane_low = a.MultiplyPlanes(b, plane_high);
+        if (low.ToInt64() != lo || high.ToInt64() != hi || plane_low.ToInt64() != lo || plane_high.ToInt64() != hi) {
+            std::cout << "FAIL: " << x << " * " << y << " -> " << low.ToInt64() << ", " << high.ToInt64()
+                      << " (planes " << plane_low.ToInt64() << ", " << plane_high.ToInt64() << ")" << std::endl;
+            exit(1);
+        }
+
+        TernaryWord q, r, plane_q, plane_r;
+        if (y == 0) {
+            if (a.DivMod(b, q, r) || a.DivModPlanes(b, q, r)) {
+                std::cout << "FAIL: " << x << " / 0 accepted" << std::endl;
+                exit(1);
+            }
+            continue;
+        }
+        if (!a.DivMod(b, q, r) || q.ToInt64() != x / y || r.ToInt64() != x % y ||
+            !a.DivModPlanes(b, plane_q, plane_r) || plane_q.ToInt64() != x / y || plane_r.ToInt64() != x % y) {
+            std::cout << "FAIL: " << x << " / " << y << " -> " << q.ToInt64() << " rem " << r.ToInt64()
+                      << " (planes " << plane_q.ToInt64() << " rem " << plane_r.ToInt64() << ")" << std::endl;
+            exit(1);
+        }
+    }
+
+    // Spec examples (truncation, remainder follows dividend)
+    TernaryWord q, r, high;
+    TernaryWord::FromInt64(-10).DivMod(TernaryWord::FromInt64(3), q, r);
+    assert(q.ToInt64() == -3 && r.ToInt64() == -1);
+    TernaryWord::FromInt64(10).DivMod(TernaryWord::FromInt64(-3), q, r);
+    assert(q.ToInt64() == -3 && r.ToInt64() == 1);
+    TernaryWord::FromInt64(HALF).DivMod(TernaryWord::FromInt64(1), q, r);
+    assert(q.ToInt64() == HALF && r.ToInt64() == 0);
+    assert(TernaryWord::FromInt64(6).Multiply(TernaryWord::FromInt64(-7), high).ToInt64() == -42 && high.ToInt64() == 0);
+    TernaryWord::FromInt64(HALF).Multiply(TernaryWord::FromInt64(3), high);
+    assert(high.ToInt64() == 1);
+
+    std::cout << "Multiply/DivMod Passed." << std::endl;
+}
+
+void TestPacking() {
+    std::cout << "Testing Packed Encoding (portable/BMI2) vs Per-Trit Reference..." << std::endl;
+    std::mt19937_64 rng(17);
+    bool host_bmi2 = TernaryWord::PackedUsesBMI2();
+
+    for (int backend = 0; backend <= (host_bmi2 ? 1 : 0); ++backend) {
+        TernaryWord::SetPackedBMI2(backend == 1);
+        for (int k = 0; k < 200000; ++k) {
+            // Raw planes include (1,1) trits; raw codes include reserved 11
+            TernaryWord w(rng(), rng());
+            uint64_t code = rng();
+            if (w.ToPacked() != w.ToPackedReference()) {
+                std::cout << "FAIL: ToPacked " << w.ToString() << std::endl;
+                exit(1);
+            }
+            TernaryWord u = TernaryWord::FromPacked(code), u_ref = TernaryWord::FromPackedReference(code);
+            if (u.pos != u_ref.pos || u.neg != u_ref.neg) {
+                std::cout << "FAIL: FromPacked " << code << std::endl;
+                exit(1);
+            }
+        }
+
+        // Stream round trip over every tail length
+        for (size_t count = 0; count < 40; ++count) {
+            std::vector<TernaryWord> words(count), back(count);
+            for (auto& w : words) {
+                uint64_t p = rng() & ((1ULL << 27) - 1);
+                w = TernaryWord(p, rng() & ~p & ((1ULL << 27) - 1));
+            }
+            std::vector<uint8_t> bytes(TernaryWord::PackedStreamBytes(count));
+            TernaryWord::PackStream(words.data(), count, bytes.data());
+            TernaryWord::UnpackStream(bytes.data(), count, back.data());
+            for (size_t i = 0; i < count; ++i) assert(back[i].pos == words[i].pos && back[i].neg == words[i].neg);
+            // Dense layout: word i occupies bits [54i, 54i + 54)
+            if (count > 0) {
+                uint64_t code = 0;
+                size_t bit = 54 * (count - 1);
+                for (int b = 0; b < 54; ++b, ++bit) code |= (uint64_t)((bytes[bit / 8] >> (bit % 8)) & 1) << b;
+                assert(code == words[count - 1].ToPackedReference());
+            }
+        }
+    }
+    TernaryWord::SetPackedBMI2(host_bmi2);
+    assert(TernaryWord::PackedStreamBytes(4) == 27);
+
+    std::cout << "Packed Encoding Passed (" << (host_bmi2 ? "BMI2" : "portable") << ")." << std::endl;
+}
+
+void TestTritKernels() {
+    std::cout << "Testing TritSpan Kernels (all ISAs) vs Per-Word Methods..." << std::endl;
+    std::mt19937_64 rng(11);
+    const size_t N = 1027; // Odd length exercises the scalar tails
+    std::vector<TernaryWord> a(N), b(N);
+    for (size_t i = 0; i < N; ++i) {
+        uint64_t p = rng() & ((1ULL << 27) - 1);
+        a[i] = TernaryWord(p, rng() & ~p & ((1ULL << 27) - 1));
+        b[i] = TernaryWord(rng(), rng()); // Raw planes, including bits above trit 26
+    }
+
+    int64_t pop_ref = 0, ham_ref = 0;
+    for (size_t i = 0; i < N; ++i) {
+        pop_ref += a[i].PopCount();
+        TernaryWord diff((a[i].pos ^ b[i].pos) | (a[i].neg ^ b[i].neg), 0);
+        ham_ref += diff.PopCount();
+    }
+
+    TritKernels::ISA best = TritKernels::DetectISA();
+    for (int isa = 0; isa <= (int)best; ++isa) {
+        TritKernels::ForceISA((TritKernels::ISA)isa);
+        TritArray sa, sb, out(N);
+        sa.Load(a.data(), N);
+        sb.Load(b.data(), N);
+
+        for (size_t off = 0; off < 3; ++off) { // Unaligned sub-spans
+            TritSpan va = sa.Span().Sub(off, N - off), vb = sb.Span().Sub(off, N - off);
+            TritSpan vo = out.Span().Sub(off, N - off);
+            struct { void (*fn)(TritSpan, TritSpan, TritSpan); TernaryWord (TernaryWord::*ref)(const TernaryWord&) const; } ops[] = {
+                { TritKernels::Consensus, &TernaryWord::Consensus },
+                { TritKernels::Decay, &TernaryWord::Decay },
+                { TritKernels::Min, &TernaryWord::Min },
+                { TritKernels::Max, &TernaryWord::Max },
+            };
+            for (auto& op : ops) {
+                op.fn(vo, va, vb);
+                for (size_t i = off; i < N; ++i) {
+                    TernaryWord r = (a[i].*op.ref)(b[i]);
+                    if (out.Get(i).pos != r.pos || out.Get(i).neg != r.neg) {
+                        std::cout << "FAIL: " << TritKernels::ISAName((TritKernels::ISA)isa) << " kernel at " << i << std::endl;
+                        exit(1);
+                    }
+                }
+            }
+            TritKernels::Negate(vo, va);
+            for (size_t i = off; i < N; ++i) Check(out.Get(i).ToInt64() == a[i].Negate().ToInt64(), "Negate kernel");
+        }
+
+        // In-place (dst aliases a)
+        TritArray sc = sa;
+        TritKernels::Consensus(sc.Span(), sc.Span(), sb.Span());
+        TritKernels::Negate(sc.Span(), sc.Span());
+        for (size_t i = 0; i < N; ++i) Check(sc.Get(i).pos == a[i].Consensus(b[i]).neg, "In-place Consensus/Negate kernels");
+
+        Check(TritKernels::PopCount(sa.Span()) == pop_ref, "PopCount kernel");
+        Check(TritKernels::HammingDistance(sa.Span(), sb.Span()) == ham_ref, "HammingDistance kernel");
+        Check(TritKernels::HammingDistance(sa.Span(), sa.Span()) == 0, "HammingDistance of a span with itself");
+
+        std::vector<TernaryWord> back(N);
+        sa.Store(back.data());
+        for (size_t i = 0; i < N; ++i) Check(back[i].pos == a[i].pos && back[i].neg == a[i].neg, "TritArray Load/Store round trip");
+
+        // Interleaved words (Page::words), unaligned starts and in place
+        std::vector<TernaryWord> words(N);
+        for (size_t off = 0; off < 3; ++off) {
+            TritKernels::Consensus(words.data() + off, a.data() + off, b.data() + off, N - off);
+            for (size_t i = off; i < N; ++i) Check(words[i].pos == a[i].Consensus(b[i]).pos && words[i].neg == a[i].Consensus(b[i]).neg, "Interleaved Consensus kernel");
+            TritKernels::Decay(words.data() + off, b.data() + off, a.data() + off, N - off);
+            for (size_t i = off; i < N; ++i) Check(words[i].pos == b[i].Decay(a[i]).pos && words[i].neg == b[i].Decay(a[i]).neg, "Interleaved Decay kernel");
+            int64_t pop = 0;
+            for (size_t i = off; i < N; ++i) pop += b[i].PopCount();
+            Check(TritKernels::PopCount(b.data() + off, N - off) == pop, "Interleaved PopCount kernel");
+        }
+        words = a;
+        TritKernels::Consensus(words.data(), words.data(), b.data(), N);
+        for (size_t i = 0; i < N; ++i) Check(words[i].neg == a[i].Consensus(b[i]).neg, "In-place interleaved Consensus kernel");
+        Check(TritKernels::PopCount(a.data(), N) == pop_ref, "Interleaved PopCount matches span PopCount");
+    }
+    TritKernels::ForceISA(best);
+
+    std::cout << "TritSpan Kernels Passed (" << TritKernels::ISAName(best) << ")." << std::endl;
+}
+
+void TestBitplaneDot() {
+    std::cout << "Testing Single-Trit Bitplane Dot Products (all ISAs)..." << std::endl;
+    std::mt19937_64 rng(12);
+    auto single_trit = [&]() {
+        TernaryWord w = TernaryWord::FromInt64((int64_t)(rng() % 3) - 1);
+        if (rng() % 16 == 0) w = TernaryWord(1, 1);                            // Non-canonical zero
+        if (rng() % 16 == 0) w = TernaryWord(w.pos | (1u << 29), w.neg);        // Above trit 26: ignored
+        return w;
+    };
+    const size_t lengths[] = { 0, 1, 63, 64, 65, 130, 1024 };
+
+    TritKernels::ISA best = TritKernels::DetectISA();
+    for (int isa = 0; isa <= (int)best; ++isa) {
+        TritKernels::ForceISA((TritKernels::ISA)isa);
+        for (size_t n : lengths) {
+            std::vector<TernaryWord> a(n), b(n);
+            int64_t ref = 0;
+            for (size_t i = 0; i < n; ++i) {
+                a[i] = single_trit();
+                b[i] = single_trit();
+                ref += a[i].ToInt64() * b[i].ToInt64();
+            }
+            size_t blocks = TritKernels::BitplaneBlocks(n);
+            std::vector<uint64_t> ap(blocks), an(blocks), bp(blocks), bn(blocks), sp(blocks), sn(blocks);
+            Check(TritKernels::PackSingleTrit(a.data(), n, ap.data(), an.data()), "PackSingleTrit accepts single-trit words");
+            Check(TritKernels::PackSingleTrit(b.data(), n, bp.data(), bn.data()), "PackSingleTrit accepts single-trit words");
+            Check(TritKernels::BitplaneDot(ap.data(), an.data(), bp.data(), bn.data(), blocks) == ref, "BitplaneDot matches the scalar dot product");
+
+            // SoA packing agrees with the word packer
+            TritArray sa;
+            sa.Load(a.data(), n);
+            Check(TritKernels::PackSingleTrit(sa.Span(), sp.data(), sn.data()), "PackSingleTrit accepts a single-trit span");
+            Check(sp == ap && sn == an, "Span and word packers agree");
+
+            // Any wider word (head, SIMD body, tail) is refused
+            for (size_t at : { (size_t)0, n / 2, n - 1 }) {
+                if (n == 0) break;
+                std::vector<TernaryWord> wide = a;
+                wide[at] = TernaryWord::FromInt64(rng() % 2 ? 2 : -4);
+                if (TritKernels::PackSingleTrit(wide.data(), n, ap.data(), an.data())) {
+                    std::cout << "FAIL: " << TritKernels::ISAName((TritKernels::ISA)isa) << " packed a wide word at " << at << std::endl;
+                    exit(1);
+                }
+                sa.Set(at, wide[at]);
+                Check(!TritKernels::PackSingleTrit(sa.Span(), sp.data(), sn.data()), "PackSingleTrit refuses a wide word in a span");
+                sa.Set(at, a[at]);
+            }
+        }
+    }
+    TritKernels::ForceISA(best);
+
+    std::cout << "Bitplane Dot Products Passed." << std::endl;
+}
+
+// Compile-time instruction encoding: [Opcode(6)][Mode(3)][Rd(4)][Rs1(4)][Imm(10)]
+constexpr TernaryWord EncodeInstruction(int op, int mode, int rd, int rs1, int imm) {
+    TernaryWord w;
+    w.SetSlice(21, 6, op);
+    w.SetSlice(18, 3, mode);
+    w.SetSlice(14, 4, rd);
+    w.SetSlice(10, 4, rs1);
+    w.SetSlice(0, 10, imm);
+    return w;
+}
+
+constexpr TernaryWord ENCODED_ADDI = EncodeInstruction(1, 1, 3, 2, -7);
+static_assert(ENCODED_ADDI.Slice(21, 6) == 1 && ENCODED_ADDI.Slice(0, 10) == -7, "constexpr encode/decode");
+static_assert(TernaryWord::FromInt64(40).Add(TernaryWord::FromInt64(2)).ToInt64() == 42, "constexpr add");
+static_assert(BalancedTernary<3>::FromInt64(14).ToInt64() == -13, "3-trit wrap (14 mod 27)");
+static_assert(BalancedTernary<9>::FromInt64(-5).Negate().Consensus(BalancedTernary<9>::FromInt64(5)).ToInt64() == 5, "constexpr logic");
+static_assert(sizeof(BalancedTernary<12>) == 8 && sizeof(TernaryWord81) == 24, "word storage");
+static_assert(BalancedTernary<4>::FromInt64(7).Multiply(BalancedTernary<4>::FromInt64(-6)).ToInt64() == -42 + 81, "constexpr multiply wraps (-42 mod 81)");
+
+constexpr int64_t ConstHighWord(int64_t x, int64_t y) {
+    TernaryWord high;
+    return TernaryWord::FromInt64(x).Multiply(TernaryWord::FromInt64(y), high).ToInt64() == 0 ? high.ToInt64() : -1;
+}
+static_assert(ConstHighWord(TritDetail::Pow3(20), -TritDetail::Pow3(20)) == -TritDetail::Pow3(13), "constexpr bitplane multiply (3^40)");
+
+constexpr int64_t ConstQuotient(int64_t x, int64_t y) {
+    TernaryWord q, r;
+    return TernaryWord::FromInt64(x).DivMod(TernaryWord::FromInt64(y), q, r) ? q.ToInt64() * 100 + r.ToInt64() : 0;
+}
+static_assert(ConstQuotient(-10, 3) == -301, "constexpr divmod (-3 rem -1)");
+
+template <int N>
+void CheckWidth(std::mt19937_64& rng) {
+    using Word = BalancedTernary<N>;
+    const int64_t half = (TritDetail::Pow3(N) - 1) / 2;
+    for (int k = 0; k < 20000; ++k) {
+        int64_t x = (int64_t)(rng() % (4 * half + 3)) - (2 * half + 1); // Includes out-of-range values
+        int64_t y = (int64_t)(rng() % (2 * half + 1)) - half;
+        Word a = Word::FromInt64(x), b = Word::FromInt64(y);
+        Word a_ref = Word::FromInt64Reference(x);
+        Check(a.pos == a_ref.pos && a.neg == a_ref.neg, "FromInt64 vs reference");
+        Check(a.ToInt64() == a.ToInt64Reference(), "ToInt64 vs reference");
+
+        int8_t c1 = 0, c2 = 0;
+        Word s = a.Add(b, c1), s_ref = a.AddRipple(b, c2);
+        Check(s.pos == s_ref.pos && s.neg == s_ref.neg && c1 == c2, "Add vs ripple adder");
+
+        int64_t av = a.ToInt64();
+        Word high, plane_high;
+        Word low = a.Multiply(b, high);
+        Word plane_low = a.MultiplyPlanes(b, plane_high);
+        __int128 prod = (__int128)av * y;
+        Check((__int128)high.ToInt64() * TritDetail::Pow3(N) + low.ToInt64() == prod, "Multiply vs 128-bit product");
+        Check(plane_low.ToInt64() == low.ToInt64() && plane_high.ToInt64() == high.ToInt64(), "MultiplyPlanes vs Multiply");
+
+        Word q, r, plane_q, plane_r;
+        if (y != 0) {
+            Check(a.DivMod(b, q, r) && q.ToInt64() == av / y && r.ToInt64() == av % y, "DivMod vs / and %");
+            Check(a.DivModPlanes(b, plane_q, plane_r) && plane_q.ToInt64() == av / y && plane_r.ToInt64() == av % y,
+                  "DivModPlanes vs / and %");
+        }
+        Check(Word::FromPacked(a.ToPacked()).ToInt64() == av, "Packed round trip");
+    }
+}
+
+void TestGenericWidths() {
+    std::cout << "Testing BalancedTernary<N> Widths and Multi-Limb Words..." << std::endl;
+    std::mt19937_64 rng(19);
+    CheckWidth<3>(rng);
+    CheckWidth<9>(rng);
+    CheckWidth<12>(rng);
+    CheckWidth<20>(rng);
+    CheckWidth<32>(rng);
+
+    // 81 trits: three 27-trit limbs, carries cross limb boundaries
+    const int64_t H27 = (TritDetail::Pow3(27) - 1) / 2;
+    TernaryWord81 w = TernaryWord81::FromInt64(H27 + 1);
+    Check(w.limbs[0].ToInt64() == -H27 && w.limbs[1].ToInt64() == 1 && w.limbs[2].ToInt64() == 0, "81-trit limb split");
+    Check(w.ToInt64() == H27 + 1, "81-trit limb value");
+    for (int k = 0; k < 100000; ++k) {
+        int64_t x = (int64_t)(rng() >> 2) - (int64_t)(1ULL << 61);
+        int64_t y = (int64_t)(rng() >> 2) - (int64_t)(1ULL << 61);
+        TernaryWord81 a = TernaryWord81::FromInt64(x), b = TernaryWord81::FromInt64(y);
+        int8_t carry = 0;
+        Check(a.ToInt64() == x, "81-trit conversion");
+        Check(a.Add(b, carry).ToInt64() == x + y && carry == 0, "81-trit add");
+        Check(a.Negate().ToInt64() == -x, "81-trit negate");
+        Check(a.ShiftLeft().ShiftRight().ToInt64() == x, "81-trit shifts"); // |x| < 3^80 / 2
+    }
+    TernaryWord81 top;
+    top.SetTrit(80, 1);
+    Check(top.ShiftLeft().PopCount() == 0, "81-trit shift out of the top trit");
+    int8_t carry = 0;
+    TernaryWord81 twice = top.Add(top, carry); // 2 * 3^80 = 3^81 - 3^80: trit 80 is -1, carry 1
+    Check(carry == 1 && twice.GetTrit(80) == -1 && twice.PopCount() == 1, "81-trit add carries out of the top limb");
+
+    std::cout << "Generic Widths Passed." << std::endl;
+}
+
 int main() {
     TestConversion();
+    TestConversionTables();
     TestLogic();
+    TestBitplaneLogic();
     TestArithmetic();
+    TestAdderEquivalence();
+    TestMultiplyDivide();
+    TestPacking();
+    TestTritKernels();
+    TestBitplaneDot();
+    TestGenericWidths();
     
     std::cout << "All Tests Passed!" << std::endl;
     return 0;
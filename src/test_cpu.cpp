@@ -1,7 +1,12 @@
 #include "cpu.h"
 #include "isa.h"
+#include "trit_span.h"
 #include <iostream>
 #include <cassert>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
 
 // Helper to construct instruction words based on Phase 2 Format
 // Format: [Opcode: 6] [Mode: 3] [Rd: 4] [Rs1: 4] [Rs2/Imm: 10]
@@ -172,6 +177,429 @@ int main() {
         std::cout << "FAILURE: Expected 30, got " << result.ToInt64() << std::endl;
         return 1;
     }
+
+    // --- Self-Modifying Code (Predecode Cache Invalidation) ---
+    // 256: LDW R5, [R0 + 200]   ; R5 = replacement instruction
+    // 257: STW R5, [R0 + 258]   ; patch the next instruction
+    // 258: LDI R6, 11           ; becomes LDI R6, 77
+    // 259: HLT
+    std::cout << "Running Self-Modifying Program..." << std::endl;
+    mem.Write(TernaryWord::FromInt64(200), Encode(Opcode::LDI, 6, 0, 77));
+    mem.Write(TernaryWord::FromInt64(256), Encode(Opcode::LDW, 5, 0, 200));
+    mem.Write(TernaryWord::FromInt64(257), Encode(Opcode::STW, 5, 0, 258));
+    mem.Write(TernaryWord::FromInt64(258), Encode(Opcode::LDI, 6, 0, 11));
+    mem.Write(TernaryWord::FromInt64(259), Encode(Opcode::HLT, 0, 0, 0));
+
+    // Execute the original instruction once so its decode is cached
+    cpu.halted = false;
+    cpu.pc = TernaryWord::FromInt64(258);
+    cpu.Run(5);
+    if (cpu.regs[6].ToInt64() != 11) {
+        std::cout << "FAILURE: Expected R6 = 11 before patch, got " << cpu.regs[6].ToInt64() << std::endl;
+        return 1;
+    }
+
+    cpu.halted = false;
+    cpu.pc = TernaryWord::FromInt64(256);
+    cpu.Run(10);
+    if (cpu.regs[6].ToInt64() != 77) {
+        std::cout << "FAILURE: Stale decode after STW, R6 = " << cpu.regs[6].ToInt64() << std::endl;
+        return 1;
+    }
+
+    // Host-side rewrite (loader / code generator path)
+    mem.Write(TernaryWord::FromInt64(258), Encode(Opcode::LDI, 6, 0, -5));
+    cpu.halted = false;
+    cpu.pc = TernaryWord::FromInt64(258);
+    cpu.Run(5);
+    if (cpu.regs[6].ToInt64() != -5) {
+        std::cout << "FAILURE: Stale decode after host write, R6 = " << cpu.regs[6].ToInt64() << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS: Patched instructions were re-decoded." << std::endl;
+
+    // --- Register Shadows ---
+    // Integer register arithmetic (RegArith) against the ternary ALU, around
+    // the 27-trit limits and with non-canonical (1,1) operands
+    std::cout << "Checking register shadow arithmetic..." << std::endl;
+    std::mt19937 rng(0x5EED);
+    auto random_word = [&]() {
+        int64_t v = 0;
+        switch (rng() % 4) {
+            case 0: v = (int64_t)(rng() % 2001) - 1000; break;
+            case 1: v = RegArith::WORD_MAX - (int64_t)(rng() % 100); break;
+            case 2: v = -RegArith::WORD_MAX + (int64_t)(rng() % 100); break;
+            default: v = (int64_t)(((uint64_t)rng() << 32 | rng()) % (uint64_t)RegArith::WORD_RANGE) - RegArith::WORD_MAX; break;
+        }
+        TernaryWord w = TernaryWord::FromInt64(v);
+        if (rng() % 8 == 0) { uint32_t both = 1u << (rng() % 27); w.pos |= both; w.neg |= both; }
+        return w;
+    };
+    for (int t = 0; t < 100000; ++t) {
+        TernaryWord a = random_word(), b = random_word();
+        int64_t x = a.ToInt64(), y = b.ToInt64();
+        int8_t c1 = 0, c2 = 0;
+        TernaryWord high;
+        bool overflow = false;
+        int64_t q1 = 0, r1 = 0;
+        TernaryWord q2, r2;
+        bool ok = a.Add(b, c1).ToInt64() == RegArith::Add(x, y, c2) && c1 == c2;
+        ok = ok && a.SaturatingAdd(b, c1).ToInt64() == RegArith::SaturatingAdd(x, y, c2) && c1 == c2;
+        ok = ok && a.Multiply(b, high).ToInt64() == RegArith::Multiply(x, y, overflow)
+                && overflow == ((high.pos | high.neg) != 0);
+        ok = ok && a.DivMod(b, q2, r2) == RegArith::DivMod(x, y, q1, r1)
+                && (y == 0 || (q1 == q2.ToInt64() && r1 == r2.ToInt64()));
+        if (!ok) {
+            std::cout << "FAILURE: Register arithmetic differs from the ALU for " << x << ", " << y << std::endl;
+            return 1;
+        }
+    }
+
+    // Flip accounting off: same architectural state, integer results stay lazy
+    //   LDI R1, 40 / LDI R2, 7 / MUL R3, R1, R2 / SUB R1, R1, R2 / XOR R4, R3, R1 / BGT -4 / HLT
+    TernaryMemory mem_on, mem_off;
+    Cpu on(mem_on), off(mem_off);
+    off.instrumentation = Cpu::Instrumentation::Basic;
+    const TernaryWord loop[] = {
+        Encode(Opcode::LDI, 1, 0, 40), Encode(Opcode::LDI, 2, 0, 7), Encode(Opcode::MUL, 3, 1, 2),
+        Encode(Opcode::SUB, 1, 1, 2), Encode(Opcode::XOR, 4, 3, 1), Encode(Opcode::BGT, 0, 0, -4),
+        Encode(Opcode::HLT, 0, 0, 0)
+    };
+    for (int64_t i = 0; i < 7; ++i) {
+        mem_on.Write(TernaryWord::FromInt64(i), loop[i]);
+        mem_off.Write(TernaryWord::FromInt64(i), loop[i]);
+    }
+    TernaryWord bgt = loop[5];
+    for (int i = 18; i < 21; ++i) bgt.SetTrit(i, TernaryWord::FromInt64(4).GetTrit(i - 18)); // Mode 4: PC-relative
+    mem_on.Write(TernaryWord::FromInt64(5), bgt);
+    mem_off.Write(TernaryWord::FromInt64(5), bgt);
+    on.Run(200);
+    off.Run(200);
+    for (int i = 0; i < 16; ++i) {
+        const TernaryWord& x = on.regs[i];
+        const TernaryWord& y = off.regs[i];
+        if (x.pos != y.pos || x.neg != y.neg) {
+            std::cout << "FAILURE: R" << i << " differs with flip accounting off" << std::endl;
+            return 1;
+        }
+    }
+    if (!on.halted || !off.halted || off.metrics.trit_flips != 0 || on.metrics.trit_flips == 0 ||
+        on.metrics.energy_proxy != off.metrics.energy_proxy + on.metrics.trit_flips) {
+        std::cout << "FAILURE: Unexpected metrics with flip accounting off" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS: Register shadows match the ternary ALU." << std::endl;
+
+    // --- Instrumentation Policies ---
+    // Threaded core instantiations: same state at every level, trace output
+    // identical to the switch core, and COG set by MSR honoured mid-run
+    std::cout << "Checking instrumentation policies..." << std::endl;
+    auto run_loop = [&](Cpu::Core core, Cpu::Instrumentation level, bool trace, std::string* out) {
+        TernaryMemory m;
+        for (int64_t i = 0; i < 7; ++i) m.Write(TernaryWord::FromInt64(i), i == 5 ? bgt : loop[i]);
+        Cpu c(m);
+        c.core = core;
+        c.instrumentation = level;
+        c.ToggleTrace(trace);
+        std::ostringstream sink;
+        std::streambuf* old = std::cout.rdbuf(sink.rdbuf());
+        c.Step(200);
+        std::cout.rdbuf(old);
+        if (out) *out = sink.str();
+        for (int i = 0; i < 16; ++i) {
+            if (c.regs[i].ToInt64() != on.regs[i].ToInt64()) return false;
+        }
+        switch (level) {
+            case Cpu::Instrumentation::Full:
+                return c.metrics.total_cycles == on.metrics.total_cycles && c.metrics.trit_flips == on.metrics.trit_flips &&
+                       c.metrics.energy_proxy == on.metrics.energy_proxy;
+            case Cpu::Instrumentation::Basic:
+                return c.metrics.total_cycles == on.metrics.total_cycles && c.metrics.trit_flips == 0 &&
+                       c.metrics.energy_proxy == off.metrics.energy_proxy;
+            default:
+                return c.metrics.total_cycles == 0 && c.metrics.energy_proxy == 0 && c.metrics.trit_flips == 0;
+        }
+    };
+    std::string trace_switch, trace_threaded, trace_blocks;
+    bool policies_ok = run_loop(Cpu::Core::Threaded, Cpu::Instrumentation::None, false, nullptr) &&
+                       run_loop(Cpu::Core::Threaded, Cpu::Instrumentation::Basic, false, nullptr) &&
+                       run_loop(Cpu::Core::Threaded, Cpu::Instrumentation::Full, false, nullptr) &&
+                       run_loop(Cpu::Core::Block, Cpu::Instrumentation::None, false, nullptr) &&
+                       run_loop(Cpu::Core::Switch, Cpu::Instrumentation::Full, true, &trace_switch) &&
+                       run_loop(Cpu::Core::Threaded, Cpu::Instrumentation::Full, true, &trace_threaded) &&
+                       run_loop(Cpu::Core::Block, Cpu::Instrumentation::Full, true, &trace_blocks);
+    if (!policies_ok || trace_switch.empty() || trace_threaded != trace_switch || trace_blocks != trace_switch) {
+        std::cout << "FAILURE: Instrumentation policies changed execution or trace output" << std::endl;
+        return 1;
+    }
+
+    //   LDI R1, 729 (COG trit) / MSR R1 / LDW R2, [R0 + 5] (secure fault) / HLT
+    TernaryMemory mem_cog;
+    mem_cog.Write(TernaryWord::FromInt64(0), Encode(Opcode::LDI, 1, 0, 729));
+    mem_cog.Write(TernaryWord::FromInt64(1), Encode(Opcode::MSR, 0, 1, 0));
+    mem_cog.Write(TernaryWord::FromInt64(2), Encode(Opcode::LDW, 2, 0, 5));
+    mem_cog.Write(TernaryWord::FromInt64(3), Encode(Opcode::HLT, 0, 0, 0));
+    Cpu cog(mem_cog);
+    cog.core = Cpu::Core::Threaded;
+    cog.instrumentation = Cpu::Instrumentation::None;
+    std::streambuf* cerr_buf = std::cerr.rdbuf(nullptr);
+    cog.Step(10);
+    std::cerr.rdbuf(cerr_buf);
+    if (!cog.halted || cog.pc.ToInt64() != 3) {
+        std::cout << "FAILURE: Cognitive mode entered by MSR was not enforced" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS: Policy instantiations agree." << std::endl;
+
+    // --- Run Control ---
+    // Breakpoints, watches, callbacks and the budget stop every core at the
+    // same instruction, and resuming continues the same execution
+    //   LDI R1, 10 / LDI R2, 1 / SUB R1, R1, R2 / STW R1, [R0 + 100] / BGT -3 / HLT
+    std::cout << "Checking RunUntil stop conditions..." << std::endl;
+    auto run_control = [&](Cpu::Core core) {
+        TernaryMemory m;
+        TernaryWord loop_back = Encode(Opcode::BGT, 0, 0, -3);
+        for (int i = 18; i < 21; ++i) loop_back.SetTrit(i, TernaryWord::FromInt64(4).GetTrit(i - 18));
+        const TernaryWord prog[] = {
+            Encode(Opcode::LDI, 1, 0, 10), Encode(Opcode::LDI, 2, 0, 1), Encode(Opcode::SUB, 1, 1, 2),
+            Encode(Opcode::STW, 1, 0, 100), loop_back, Encode(Opcode::HLT, 0, 0, 0)
+        };
+        for (int64_t i = 0; i < 6; ++i) m.Write(i, prog[i]);
+        auto fresh = [&](Cpu& c) {
+            c.pc.SetInt(0);
+            c.halted = false;
+            c.core = core;
+            c.jit_threshold = 1;
+        };
+        Cpu c(m);
+
+        // Breakpoint at the loop head: once before the loop, then once per taken branch
+        fresh(c);
+        Cpu::StopConditions bp;
+        bp.breakpoints = { 2 };
+        uint64_t total = 0;
+        int stops = 0;
+        Cpu::RunResult r;
+        while ((r = c.RunUntil(bp)).reason == Cpu::StopReason::Breakpoint) {
+            if (r.address != 2 || c.pc.ToInt64() != 2 || c.regs[1].ToInt64() != 10 - stops) return false;
+            total += r.cycles;
+            stops++;
+        }
+        total += r.cycles;
+        if (r.reason != Cpu::StopReason::Halted || stops != 10 || total != 33 || c.metrics.total_cycles != 33) return false;
+
+        // Watch: stop right after each store
+        fresh(c);
+        Cpu::StopConditions watch;
+        watch.watches = { 100 };
+        stops = 0;
+        while ((r = c.RunUntil(watch)).reason == Cpu::StopReason::Watchpoint) {
+            if (r.address != 100 || c.pc.ToInt64() != 4 || m.Read(100).ToInt64() != 9 - stops) return false;
+            stops++;
+        }
+        if (r.reason != Cpu::StopReason::Halted || stops != 10) return false;
+
+        // Callback every 5 instructions, stopping the run on the third call
+        fresh(c);
+        Cpu::StopConditions cb;
+        int calls = 0;
+        cb.callback_interval = 5;
+        cb.callback = [&](Cpu&) { return ++calls < 3; };
+        r = c.RunUntil(cb);
+        if (r.reason != Cpu::StopReason::Callback || r.cycles != 15 || calls != 3) return false;
+
+        // Budget
+        fresh(c);
+        r = c.RunUntil(Cpu::StopConditions(7));
+        return r.reason == Cpu::StopReason::CycleLimit && r.cycles == 7 && c.pc.ToInt64() == 4;
+    };
+    if (!run_control(Cpu::Core::Switch) || !run_control(Cpu::Core::Threaded) ||
+        !run_control(Cpu::Core::Block) || !run_control(Cpu::Core::Jit)) {
+        std::cout << "FAILURE: RunUntil stopped at the wrong place" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS: All cores honour the stop conditions." << std::endl;
+
+    std::cout << "Checking snapshots and forks..." << std::endl;
+    auto checkpoints = [&](Cpu::Core core) {
+        // Counts R1 down from 10, storing it to 100 and to cognitive page 0x30 each time
+        TernaryMemory m;
+        TernaryWord loop_back = Encode(Opcode::BGT, 0, 0, -4);
+        for (int i = 18; i < 21; ++i) loop_back.SetTrit(i, TernaryWord::FromInt64(4).GetTrit(i - 18));
+        const TernaryWord prog[] = {
+            Encode(Opcode::LDI, 1, 0, 10), Encode(Opcode::LDI, 2, 0, 1), Encode(Opcode::LDI, 3, 0, 0x3005),
+            Encode(Opcode::SUB, 1, 1, 2), Encode(Opcode::STW, 1, 0, 100), Encode(Opcode::STW, 1, 3, 0),
+            loop_back, Encode(Opcode::HLT, 0, 0, 0)
+        };
+        for (int64_t i = 0; i < 8; ++i) m.Write(i, prog[i]);
+        Cpu c(m);
+        c.core = core;
+        c.jit_threshold = 1;
+        c.RunUntil(Cpu::StopConditions(11)); // Two iterations in
+        Cpu::Snapshot snap = c.TakeSnapshot();
+
+        TernaryMemory child_mem;
+        Cpu child(child_mem);
+        c.Fork(child);
+        c.RunUntil(Cpu::StopConditions(1000));
+        if (!c.halted || m.Read(100).ToInt64() != 0 || m.Read(0x3005).ToInt64() != 0) return false;
+        // The child still sees the memory of the fork point, and runs on its own
+        if (child.halted || child_mem.Read(100).ToInt64() != 8 || child_mem.Read(0x3005).ToInt64() != 8) return false;
+        child.RunUntil(Cpu::StopConditions(1000));
+        if (!child.halted || child_mem.Read(0x3005).ToInt64() != 0 || child.metrics.total_cycles != c.metrics.total_cycles) return false;
+
+        // Restore rewinds registers, metrics and both memory regions
+        c.Restore(snap);
+        if (c.halted || c.regs[1].ToInt64() != 8 || m.Read(100).ToInt64() != 8 || m.Read(0x3005).ToInt64() != 8 ||
+            c.metrics.total_cycles != 11) return false;
+        c.RunUntil(Cpu::StopConditions(1000));
+        if (!c.halted || c.metrics.total_cycles != child.metrics.total_cycles) return false;
+
+        // File round trip, restored into a fresh machine
+        Cpu::Snapshot loaded;
+        if (!snap.Save("test_snapshot.hxs") || !loaded.Load("test_snapshot.hxs")) return false;
+        std::remove("test_snapshot.hxs");
+        TernaryMemory fresh_mem;
+        Cpu fresh(fresh_mem);
+        fresh.core = core;
+        fresh.Restore(loaded);
+        if (fresh.pc.ToInt64() != snap.pc.ToInt64() || fresh_mem.Read(6).ToInt64() != prog[6].ToInt64() ||
+            fresh_mem.Read(0x3005).ToInt64() != 8) return false;
+        fresh.RunUntil(Cpu::StopConditions(1000));
+        return fresh.halted && fresh_mem.Read(100).ToInt64() == 0 && fresh.metrics.total_cycles == c.metrics.total_cycles;
+    };
+    if (!checkpoints(Cpu::Core::Switch) || !checkpoints(Cpu::Core::Threaded) ||
+        !checkpoints(Cpu::Core::Block) || !checkpoints(Cpu::Core::Jit)) {
+        std::cout << "FAILURE: Snapshot/fork state diverged" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS: Snapshots restore and forks run independently." << std::endl;
+
+    std::cout << "Checking ternary matrix-vector products..." << std::endl;
+    auto matvec = [&](int wide_row, int threads, int64_t matrix, bool holes) {
+        // 70 lanes: a full and a partial bitplane block. Weights are -1/0/+1
+        // except one entry of row wide_row (-1: none), which takes that row
+        // and the ones after it to the general path. threads > 1 splits the
+        // rows across the worker pool; rows of a cognitive matrix cross pages.
+        // holes (cognitive matrix, run as agent 5): one matrix page is left
+        // unallocated and one belongs to agent 7, so both read as zeros.
+        const int n = 70;
+        const int64_t vec = 100;
+        TernaryMemory m;
+        Cpu c(m);
+        c.vector_threads = threads;
+        c.vector_parallel_threshold = 16;
+        std::mt19937 rng(5);
+        std::vector<int64_t> x(n), w(n * n);
+        for (int i = 0; i < n; ++i) m.Write(vec + i, TernaryWord::FromInt64(x[i] = (int64_t)(rng() % 3) - 1));
+        for (int i = 0; i < n * n; ++i) w[i] = (int64_t)(rng() % 3) - 1;
+        if (wide_row >= 0) w[wide_row * n + 3] = 5;
+        const int64_t first = matrix / PAGE_SIZE, last = (matrix + n * n - 1) / PAGE_SIZE;
+        const int64_t hole_page = holes ? (matrix + 1000) / PAGE_SIZE : -1;
+        const int64_t foreign_page = holes ? (matrix + 4000) / PAGE_SIZE : -1;
+        for (int64_t p = first; holes && p <= last; ++p) {
+            if (p != hole_page) m.AllocatePage(p, p == foreign_page ? 7 : 5, PERM_OWNER_READ | PERM_OWNER_WRITE);
+        }
+        for (int i = 0; i < n * n; ++i) {
+            if ((matrix + i) / PAGE_SIZE != hole_page) m.Write(matrix + i, TernaryWord::FromInt64(w[i]));
+            if ((matrix + i) / PAGE_SIZE == hole_page || (matrix + i) / PAGE_SIZE == foreign_page) w[i] = 0;
+        }
+        const TernaryWord prog[] = {
+            Encode(Opcode::LDI, 1, 0, vec), Encode(Opcode::LDI, 2, 0, matrix), Encode(Opcode::VLDR, 0, 0, 1),
+            Encode(Opcode::VMMUL, 1, 0, 2), Encode(Opcode::VMMSGN, 2, 0, 2), Encode(Opcode::VDOT, 3, 0, 1),
+            Encode(Opcode::HLT, 0, 0, 0)
+        };
+        for (int64_t i = 0; i < 7; ++i) m.Write(i, prog[i]);
+        c.vector_length = n;
+
+        // The weights are only read: their pages keep their code generation
+        // (page 0 also holds the program) and stay shared with a snapshot
+        Cpu::Snapshot snap = c.TakeSnapshot();
+        std::vector<uint64_t> versions;
+        for (int64_t p = first; p <= last && p < TernaryMemory::SYSTEM_PAGES; ++p) versions.push_back(m.CodeVersion(p * PAGE_SIZE));
+        m.SetContext(holes ? 5 : 0);
+        c.Run(100);
+        m.SetContext(0);
+        for (int64_t p = first; p <= last; ++p) {
+            if (p < TernaryMemory::SYSTEM_PAGES) {
+                if (m.CodeVersion(p * PAGE_SIZE) != versions[p - first] || m.ReadPage(p) != snap.memory.system_pages[p].get()) return false;
+            } else {
+                auto shared = snap.memory.pages.find(p);
+                if (m.ReadPage(p) != (shared == snap.memory.pages.end() ? nullptr : shared->second->words.data())) return false;
+            }
+        }
+
+        int64_t dot = 0;
+        for (int i = 0; i < n; ++i) {
+            int64_t sum = 0;
+            for (int j = 0; j < n; ++j) sum += w[i * n + j] * x[j];
+            if (c.vec_regs.Get(1, i).ToInt64() != sum || c.vec_regs.Get(2, i).ToInt64() != (sum > 0) - (sum < 0)) return false;
+            dot += x[i] * sum;
+        }
+        return c.halted && c.regs[3].ToInt64() == dot;
+    };
+    if (!matvec(-1, 1, 200, false) || !matvec(0, 1, 200, false) || !matvec(41, 1, 200, false) ||
+        !matvec(-1, 3, 0x3010, false) || !matvec(41, 3, 0x3010, false) || !matvec(41, 4, 200, false) ||
+        !matvec(-1, 1, 0x3010, true) || !matvec(41, 3, 0x3010, true)) {
+        std::cout << "FAILURE: VMMUL/VMMSGN/VDOT result mismatch or weight pages unshared" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS: Matrix products agree across paths and thread counts." << std::endl;
+
+    std::cout << "Checking page ops (VEC.CNS/VEC.POP/DEC.MASK/SAT.MAC)..." << std::endl;
+    auto page_ops = [&](TritKernels::ISA isa) {
+        // Single-trit pages A, B; wide pages W1, W2 (W1 . W2 saturates);
+        // 0x3300 and the destinations at 0x3400 and 0x3700 start unallocated
+        TritKernels::ForceISA(isa);
+        TernaryMemory m;
+        Cpu c(m);
+        std::mt19937 rng(25);
+        std::vector<TernaryWord> a(256), b(256), w1(256), w2(256);
+        for (int i = 0; i < 256; ++i) {
+            a[i] = TernaryWord::FromInt64((int64_t)(rng() % 3) - 1);
+            b[i] = TernaryWord::FromInt64((int64_t)(rng() % 3) - 1);
+            w1[i] = TernaryWord::FromInt64((int64_t)(rng() % 2000001) - 1000000);
+            w2[i] = TernaryWord::FromInt64(i < 4 ? RegArith::WORD_MAX : (int64_t)(rng() % 2000001) - 1000000);
+        }
+        m.WriteBlock(0x3000, a.data(), 256);
+        m.WriteBlock(0x3100, b.data(), 256);
+        m.WriteBlock(0x3500, w1.data(), 256);
+        m.WriteBlock(0x3600, w2.data(), 256);
+        const TernaryWord prog[] = {
+            Encode(Opcode::LDI, 1, 0, 0x3000), Encode(Opcode::LDI, 2, 0, 0x3105), Encode(Opcode::LDI, 3, 0, 0x3200),
+            Encode(Opcode::LDI, 5, 0, 0x3400), Encode(Opcode::LDI, 8, 0, 0x3500), Encode(Opcode::LDI, 9, 0, 0x3600),
+            Encode(Opcode::LDI, 11, 0, 0x3300), Encode(Opcode::LDI, 12, 0, 0x3700),
+            Encode(Opcode::VEC_CNS, 3, 1, 2), Encode(Opcode::VEC_POP, 4, 3, 0), Encode(Opcode::VEC_DEC, 5, 1, 2),
+            Encode(Opcode::VEC_MAC, 6, 1, 2), Encode(Opcode::VEC_MAC, 7, 8, 9), Encode(Opcode::VEC_MAC, 10, 1, 11),
+            Encode(Opcode::VEC_CNS, 12, 11, 11), Encode(Opcode::HLT, 0, 0, 0)
+        };
+        for (int64_t i = 0; i < 16; ++i) m.Write(i, prog[i]);
+        c.Run(100);
+
+        int64_t pop = 0, dot = 0, mac = 0;
+        for (int i = 0; i < 256; ++i) {
+            TernaryWord cns = a[i].Consensus(b[i]), dec = a[i].Decay(b[i]);
+            TernaryWord d = m.Read(0x3200 + i), e = m.Read(0x3400 + i);
+            if (d.pos != cns.pos || d.neg != cns.neg || e.pos != dec.pos || e.neg != dec.neg) return false;
+            pop += cns.PopCount();
+            dot += a[i].ToInt64() * b[i].ToInt64();
+            bool overflow = false;
+            int64_t product = RegArith::Multiply(w1[i].ToInt64(), w2[i].ToInt64(), overflow);
+            if (overflow) product = (w1[i].ToInt64() < 0) ? -RegArith::WORD_MAX : RegArith::WORD_MAX;
+            int8_t carry = 0;
+            mac = RegArith::SaturatingAdd(mac, product, carry);
+        }
+        TritKernels::ForceISA(TritKernels::DetectISA());
+        return c.halted && c.regs[4].ToInt64() == pop && c.regs[6].ToInt64() == dot && c.regs[7].ToInt64() == mac &&
+               c.regs[10].ToInt64() == 0 && !m.IsPageAllocated(0x3700 / 256);
+    };
+    for (int isa = 0; isa <= (int)TritKernels::DetectISA(); ++isa) {
+        if (!page_ops((TritKernels::ISA)isa)) {
+            std::cout << "FAILURE: Page op mismatch (" << TritKernels::ISAName((TritKernels::ISA)isa) << ")" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "SUCCESS: Page ops match per-word results on every ISA." << std::endl;
     
     return 0;
 }
@@ -0,0 +1,287 @@
+#include "cpu.h"
+#include "isa.h"
+#include <iostream>
+#include <sstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Lockstep Test: Execution Cores
+// Runs identical programs on the switch core (reference), the threaded core,
+// the block core and the JIT core, each Cpu with its own memory, and compares
+// architectural state and metrics after every batch. Programs are random
+// scalar/cognitive instruction streams plus a few vector ops, with stores into
+// the code region to exercise re-decoding and block invalidation, and hot
+// counted loops so that the JIT compiles and runs (and bails out of) its blocks.
+
+static TernaryWord EncodeInst(int64_t op, int64_t mode, int64_t rd, int64_t rs1, int64_t imm) {
+    TernaryWord inst;
+    TernaryWord fields[5] = { TernaryWord::FromInt64(imm), TernaryWord::FromInt64(rs1),
+                              TernaryWord::FromInt64(rd), TernaryWord::FromInt64(mode),
+                              TernaryWord::FromInt64(op) };
+    const int offsets[5] = { 0, 10, 14, 18, 21 };
+    const int widths[5] = { 10, 4, 4, 3, 6 };
+    for (int f = 0; f < 5; ++f) {
+        for (int i = 0; i < widths[f]; ++i) inst.SetTrit(offsets[f] + i, fields[f].GetTrit(i));
+    }
+    return inst;
+}
+
+static bool SameWord(const TernaryWord& a, const TernaryWord& b) {
+    return a.pos == b.pos && a.neg == b.neg;
+}
+
+static bool Compare(const Cpu& a, const Cpu& b, TernaryMemory& ma, TernaryMemory& mb, std::string& why) {
+    std::ostringstream out;
+    for (int i = 0; i < 16; ++i) {
+        if (!SameWord(a.regs[i], b.regs[i])) out << "R" << i << " ";
+    }
+    if (!SameWord(a.pc, b.pc)) out << "PC ";
+    if (!SameWord(a.status, b.status)) out << "STATUS ";
+    if (a.halted != b.halted) out << "HALTED ";
+    if (a.metrics.total_cycles != b.metrics.total_cycles) out << "total_cycles ";
+    if (a.metrics.active_cycles != b.metrics.active_cycles) out << "active_cycles ";
+    if (a.metrics.energy_proxy != b.metrics.energy_proxy) out << "energy_proxy ";
+    if (a.metrics.trit_flips != b.metrics.trit_flips) out << "trit_flips ";
+    for (int64_t addr = 0; addr < 1024; ++addr) {
+        TernaryWord x = ma.Read(TernaryWord::FromInt64(addr));
+        TernaryWord y = mb.Read(TernaryWord::FromInt64(addr));
+        if (!SameWord(x, y)) { out << "MEM[" << addr << "] "; break; }
+    }
+    why = out.str();
+    return why.empty();
+}
+
+// Runs one memory image on all four cores in batches of random size, at the
+// given instrumentation level (Basic: no flip accounting, registers then stay
+// integer-only until read; None: metrics stay zero).
+// Returns false (and reports) on the first divergence.
+static bool RunLockstep(const std::vector<TernaryWord>& image, bool cognitive, Cpu::Instrumentation level, int batches,
+                        std::mt19937& rng, const std::string& label, uint64_t& instructions,
+                        std::ostream& report) {
+    TernaryMemory mem_a, mem_b, mem_c, mem_d;
+    Cpu a(mem_a), b(mem_b), c(mem_c), d(mem_d);
+    a.core = Cpu::Core::Switch;
+    b.core = Cpu::Core::Threaded;
+    c.core = Cpu::Core::Block;
+    d.core = Cpu::Core::Jit;
+    d.jit_threshold = 2;
+    a.instrumentation = b.instrumentation = c.instrumentation = d.instrumentation = level;
+
+    for (size_t addr = 0; addr < image.size(); ++addr) {
+        mem_a.Write(TernaryWord::FromInt64((int64_t)addr), image[addr]);
+        mem_b.Write(TernaryWord::FromInt64((int64_t)addr), image[addr]);
+        mem_c.Write(TernaryWord::FromInt64((int64_t)addr), image[addr]);
+        mem_d.Write(TernaryWord::FromInt64((int64_t)addr), image[addr]);
+    }
+    // Cognitive mode: saturating ADD, secure LDW/STW
+    if (cognitive) {
+        a.status.SetTrit(Cpu::BIT_COG, 1);
+        b.status.SetTrit(Cpu::BIT_COG, 1);
+        c.status.SetTrit(Cpu::BIT_COG, 1);
+        d.status.SetTrit(Cpu::BIT_COG, 1);
+    }
+
+    for (int batch = 0; batch < batches && !a.halted; ++batch) {
+        uint64_t n = 1 + rng() % 32;
+        uint64_t ra = a.Step(n);
+        uint64_t rb = b.Step(n);
+        uint64_t rc = c.Step(n);
+        uint64_t rd = d.Step(n);
+        instructions += ra;
+        std::string why;
+        const char* core = nullptr;
+        if (ra != rb || !Compare(a, b, mem_a, mem_b, why)) core = "threaded";
+        else if (ra != rc || !Compare(a, c, mem_a, mem_c, why)) core = "block";
+        else if (ra != rd || !Compare(a, d, mem_a, mem_d, why)) core = "jit";
+        if (core) {
+            report << "FAILURE: " << label << " batch " << batch << " " << core
+                      << " core diverged (" << (why.empty() ? "step count" : why) << ")" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Mostly full instrumentation, every 4th program Basic and every 4th None
+static Cpu::Instrumentation LevelFor(int p) {
+    switch (p % 4) {
+        case 2: return Cpu::Instrumentation::None;
+        case 3: return Cpu::Instrumentation::Basic;
+        default: return Cpu::Instrumentation::Full;
+    }
+}
+
+int main() {
+    std::cout << "Lockstep Test: Switch vs Threaded vs Block vs JIT Core" << std::endl;
+
+    // Scalar, control, cognitive and a few vector opcodes (no VMMUL: its cost
+    // depends on VL and is covered by the vector tests)
+    const Opcode ops[] = {
+        Opcode::NOP, Opcode::ADD, Opcode::SUB, Opcode::MUL, Opcode::DIV, Opcode::MOD,
+        Opcode::AND, Opcode::OR, Opcode::XOR, Opcode::LSL, Opcode::LSR,
+        Opcode::MOV, Opcode::LDI, Opcode::LDW, Opcode::STW,
+        Opcode::JMP, Opcode::BEQ, Opcode::BNE, Opcode::BGT, Opcode::BLT, Opcode::CALL, Opcode::RET,
+        Opcode::MSR, Opcode::MRS, Opcode::CMP,
+        Opcode::CNS, Opcode::DEC, Opcode::POP, Opcode::SAT,
+        Opcode::VADD, Opcode::VSIGN, Opcode::VSTRI
+    };
+    const int num_ops = sizeof(ops) / sizeof(ops[0]);
+    const int programs = 300;
+    const int program_len = 192;
+    const int hot_loops = 100;
+
+    // Silence HLT / trap chatter from the CPUs under test
+    std::ostringstream sink;
+    std::streambuf* cout_buf = std::cout.rdbuf(sink.rdbuf());
+    std::streambuf* cerr_buf = std::cerr.rdbuf(sink.rdbuf());
+    std::ostream report(cout_buf);
+
+    std::mt19937 rng(0x4E11);
+    uint64_t instructions = 0;
+    bool ok = true;
+
+    // Directed: a loop that patches an instruction inside its own block
+    //   0: LDI R1, 3          ; counter
+    //   1: LDI R3, 1
+    //   2: LDW R5, [R0 + 100] ; replacement instruction
+    //   3: STW R5, [R0 + 4]   ; patch the next instruction
+    //   4: LDI R6, 11         ; becomes LDI R6, 77
+    //   5: ADD R7, R7, R6
+    //   6: SUB R1, R1, R3
+    //   7: BGT pc-6           ; back to 2
+    //   8: HLT
+    {
+        std::vector<TernaryWord> image(128);
+        image[0] = EncodeInst((int64_t)Opcode::LDI, 1, 1, 0, 3);
+        image[1] = EncodeInst((int64_t)Opcode::LDI, 1, 3, 0, 1);
+        image[2] = EncodeInst((int64_t)Opcode::LDW, 0, 5, 0, 100);
+        image[3] = EncodeInst((int64_t)Opcode::STW, 0, 5, 0, 4);
+        image[4] = EncodeInst((int64_t)Opcode::LDI, 1, 6, 0, 11);
+        image[5] = EncodeInst((int64_t)Opcode::ADD, 0, 7, 7, 6);
+        image[6] = EncodeInst((int64_t)Opcode::SUB, 0, 1, 1, 3);
+        image[7] = EncodeInst((int64_t)Opcode::BGT, 4, 0, 0, -6);
+        image[8] = EncodeInst((int64_t)Opcode::HLT, 0, 0, 0, 0);
+        image[100] = EncodeInst((int64_t)Opcode::LDI, 1, 6, 0, 77);
+        ok = RunLockstep(image, false, Cpu::Instrumentation::Full, 64, rng, "self-patching loop", instructions, report);
+    }
+
+    // Directed: hot loops that cross the 27-trit (or int64) limit; the JIT's
+    // guards must hand these ops to the interpreter
+    //   0: LDI R1, 0
+    //   1: LDI R2, 1
+    //   2: LDW R3, [R0 + 100] ; MAX - 5
+    //   3: LDW R4, [R0 + 101] ; -(MAX - 5)
+    //   4: LDW R5, [R0 + 102] ; 2^32 (2^64 wraps to 0 in int64)
+    //   5: ADD R1, R1, R2
+    //   6: ADD R3, R3, R2     ; wraps at MAX + 1
+    //   7: BGT pc-3           ; back to 5
+    //   8: SUB R4, R4, R2     ; wraps at -(MAX + 1)
+    //   9: BLT pc-2           ; back to 8
+    //  10: ADD R7, R7, R2
+    //  11: MUL R6, R5, R5
+    //  12: CMP R7, 5
+    //  13: BLT pc-4           ; back to 10
+    //  14: HLT
+    if (ok) {
+        const int64_t max_word = (TritDetail::Pow3(TernaryWord::NUM_TRITS) - 1) / 2;
+        std::vector<TernaryWord> image(128);
+        image[0] = EncodeInst((int64_t)Opcode::LDI, 1, 1, 0, 0);
+        image[1] = EncodeInst((int64_t)Opcode::LDI, 1, 2, 0, 1);
+        image[2] = EncodeInst((int64_t)Opcode::LDW, 0, 3, 0, 100);
+        image[3] = EncodeInst((int64_t)Opcode::LDW, 0, 4, 0, 101);
+        image[4] = EncodeInst((int64_t)Opcode::LDW, 0, 5, 0, 102);
+        image[5] = EncodeInst((int64_t)Opcode::ADD, 0, 1, 1, 2);
+        image[6] = EncodeInst((int64_t)Opcode::ADD, 0, 3, 3, 2);
+        image[7] = EncodeInst((int64_t)Opcode::BGT, 4, 0, 0, -3);
+        image[8] = EncodeInst((int64_t)Opcode::SUB, 0, 4, 4, 2);
+        image[9] = EncodeInst((int64_t)Opcode::BLT, 4, 0, 0, -2);
+        image[10] = EncodeInst((int64_t)Opcode::ADD, 0, 7, 7, 2);
+        image[11] = EncodeInst((int64_t)Opcode::MUL, 0, 6, 5, 5);
+        image[12] = EncodeInst((int64_t)Opcode::CMP, 1, 0, 7, 5);
+        image[13] = EncodeInst((int64_t)Opcode::BLT, 4, 0, 0, -4);
+        image[14] = EncodeInst((int64_t)Opcode::HLT, 0, 0, 0, 0);
+        image[100] = TernaryWord::FromInt64(max_word - 5);
+        image[101] = TernaryWord::FromInt64(-(max_word - 5));
+        image[102] = TernaryWord::FromInt64((int64_t)1 << 32);
+        ok = RunLockstep(image, false, Cpu::Instrumentation::Full, 64, rng, "overflow loop", instructions, report);
+    }
+
+    // Random programs: 1024-word images, code in the first program_len words
+    for (int p = 0; p < programs && ok; ++p) {
+        std::vector<TernaryWord> image(1024);
+        for (int64_t addr = 0; addr < 1024; ++addr) {
+            if (addr < program_len) {
+                Opcode op = ops[rng() % num_ops];
+                int64_t mode = (rng() % 3 == 0) ? 4 : (int64_t)(rng() % 2);
+                int64_t rd = rng() % 16, rs1 = rng() % 16;
+                // Small offsets keep branches and memory ops near the program
+                int64_t imm = (op == Opcode::LDW || op == Opcode::STW) ? (int64_t)(rng() % 1024)
+                                                                       : (int64_t)(rng() % 64) - 32;
+                image[addr] = EncodeInst((int64_t)op, mode, rd, rs1, imm);
+            } else {
+                image[addr] = TernaryWord::FromInt64((int64_t)(rng() % 2001) - 1000);
+            }
+        }
+        ok = RunLockstep(image, p % 5 == 0, LevelFor(p), 64, rng, "program " + std::to_string(p), instructions, report);
+    }
+
+    // Hot loops: a counted loop over a random body of mostly JIT-able ops,
+    // optionally calling a subroutine. Large data values and repeated MULs
+    // drive the overflow guards; LDW/DIV end the compiled prefix mid-block.
+    //   0: LDI R1, count
+    //   1: LDI R2, 1
+    //   2: body...            ; writes R3..R13 only
+    //      [CALL sub]
+    //      SUB R1, R1, R2
+    //      BGT back to 2
+    //      HLT
+    //   sub: body... RET
+    const Opcode hot_ops[] = {
+        Opcode::ADD, Opcode::SUB, Opcode::MUL, Opcode::CMP, Opcode::LDI, Opcode::MOV, Opcode::NOP,
+        Opcode::ADD, Opcode::MUL, Opcode::LDW, Opcode::DIV
+    };
+    const int num_hot_ops = sizeof(hot_ops) / sizeof(hot_ops[0]);
+    auto hot_inst = [&](std::mt19937& r) {
+        Opcode op = hot_ops[r() % num_hot_ops];
+        int64_t rd = 3 + r() % 11, rs1 = r() % 14;
+        int64_t mode = (r() % 2 == 0) ? 1 : 0;
+        int64_t imm = (mode == 1) ? (int64_t)(r() % 243) - 121 : (int64_t)(r() % 14);
+        if (op == Opcode::LDW) { mode = 0; rs1 = 0; imm = 200 + (int64_t)(r() % 16); }
+        return EncodeInst((int64_t)op, mode, rd, rs1, imm);
+    };
+    for (int p = 0; p < hot_loops && ok; ++p) {
+        std::vector<TernaryWord> image(256);
+        int64_t pc = 0;
+        image[pc++] = EncodeInst((int64_t)Opcode::LDI, 1, 1, 0, 20 + (int64_t)(rng() % 60));
+        image[pc++] = EncodeInst((int64_t)Opcode::LDI, 1, 2, 0, 1);
+        int body = 2 + (int)(rng() % 12);
+        for (int k = 0; k < body; ++k) image[pc++] = hot_inst(rng);
+        int64_t call_at = (rng() % 2 == 0) ? pc++ : -1;
+        image[pc++] = EncodeInst((int64_t)Opcode::SUB, 0, 1, 1, 2);
+        image[pc] = EncodeInst((int64_t)Opcode::BGT, 4, 0, 0, 2 - (pc + 1));
+        ++pc;
+        image[pc++] = EncodeInst((int64_t)Opcode::HLT, 0, 0, 0, 0);
+        if (call_at >= 0) {
+            image[call_at] = EncodeInst((int64_t)Opcode::CALL, 4, 0, 0, pc - (call_at + 1));
+            int sub = 1 + (int)(rng() % 6);
+            for (int k = 0; k < sub; ++k) image[pc++] = hot_inst(rng);
+            image[pc++] = EncodeInst((int64_t)Opcode::RET, 0, 0, 0, 0);
+        }
+        // Data: small values and values near the 27-trit limit
+        const int64_t max_word = (TritDetail::Pow3(TernaryWord::NUM_TRITS) - 1) / 2;
+        for (int64_t addr = 200; addr < 216; ++addr) {
+            int64_t v = (rng() % 2 == 0) ? (int64_t)(rng() % 201) - 100 : max_word - (int64_t)(rng() % 1000);
+            image[addr] = TernaryWord::FromInt64((rng() % 2 == 0) ? v : -v);
+        }
+        ok = RunLockstep(image, false, LevelFor(p), 200, rng, "hot loop " + std::to_string(p), instructions, report);
+    }
+
+    std::cout.rdbuf(cout_buf);
+    std::cerr.rdbuf(cerr_buf);
+
+    if (!ok) return 1;
+    std::cout << "SUCCESS: " << programs + hot_loops + 2 << " programs, " << instructions
+              << " instructions in lockstep." << std::endl;
+    return 0;
+}
@@ -1,9 +1,17 @@
 #include "memory.h"
 #include "trit_word.h"
 #include "cognitive_trace.h"
+#include "cpu.h"
+#include "exec_trace.h"
+#include "guest_profiler.h"
+#include "host_profile.h"
+#include "isa.h"
 #include <iostream>
 #include <fstream>
 #include <cstdio>
+#include <random>
+#include <sstream>
+#include <vector>
 
 // Assert Helper
 void Assert(bool cond, const std::string& msg) {
@@ -15,6 +23,62 @@ void Assert(bool cond, const std::string& msg) {
     }
 }
 
+static bool SameRecord(const ExecTrace::Record& a, const ExecTrace::Record& b) {
+    return a.cycle == b.cycle && a.pc == b.pc && a.rd_value == b.rd_value && a.op == b.op && a.rd == b.rd &&
+           a.flags == b.flags && (!(a.flags & ExecTrace::HAS_MEM) || a.mem_addr == b.mem_addr);
+}
+
+static std::vector<ExecTrace::Record> ReadTrace(const std::string& path) {
+    std::vector<ExecTrace::Record> records;
+    ExecTrace::Reader reader;
+    ExecTrace::Record r;
+    if (reader.Open(path)) {
+        while (reader.Next(r)) records.push_back(r);
+    }
+    return records;
+}
+
+// Instruction word: [Opcode(6)@21][Mode(3)@18][Rd(4)@14][Rs1(4)@10][Imm(10)@0]
+static TernaryWord EncodeInst(Opcode op, int64_t mode, int64_t rd, int64_t rs1, int64_t imm) {
+    TernaryWord inst;
+    const int64_t fields[5] = { imm, rs1, rd, mode, (int64_t)op };
+    const int offsets[5] = { 0, 10, 14, 18, 21 };
+    const int widths[5] = { 10, 4, 4, 3, 6 };
+    for (int f = 0; f < 5; ++f) {
+        TernaryWord v = TernaryWord::FromInt64(fields[f]);
+        for (int i = 0; i < widths[f]; ++i) inst.SetTrit(offsets[f] + i, v.GetTrit(i));
+    }
+    return inst;
+}
+
+// Runs the store/load loop with a recorder attached, returns the decoded trace
+static std::vector<ExecTrace::Record> TraceLoop(Cpu::Core core, const std::string& path) {
+    //   LDI R1, 3 / LDI R2, 0x3000 / LDI R4, 1
+    //   loop: STW R1, [R2 + 5] / LDW R3, [R2 + 5] / SUB R1, R1, R4 / BGT loop
+    //   HLT
+    const TernaryWord program[] = {
+        EncodeInst(Opcode::LDI, 0, 1, 0, 3), EncodeInst(Opcode::LDI, 0, 2, 0, 0x3000),
+        EncodeInst(Opcode::LDI, 0, 4, 0, 1), EncodeInst(Opcode::STW, 0, 1, 2, 5),
+        EncodeInst(Opcode::LDW, 0, 3, 2, 5), EncodeInst(Opcode::SUB, 0, 1, 1, 4),
+        EncodeInst(Opcode::BGT, 4, 0, 0, -4), EncodeInst(Opcode::HLT, 0, 0, 0, 0)
+    };
+    TernaryMemory mem;
+    for (int64_t i = 0; i < 8; ++i) mem.Write(TernaryWord::FromInt64(i), program[i]);
+    Cpu cpu(mem);
+    cpu.core = core;
+    ExecTrace::Recorder recorder(16);
+    recorder.Open(path);
+    cpu.trace_recorder = &recorder;
+    std::ostringstream sink;
+    std::streambuf* old = std::cout.rdbuf(sink.rdbuf());
+    uint64_t executed = cpu.Step(100);
+    std::cout.rdbuf(old);
+    recorder.Close();
+    std::vector<ExecTrace::Record> records = ReadTrace(path);
+    if (records.size() != executed || recorder.Records() != executed) records.clear();
+    return records;
+}
+
 int main() {
     std::cout << "--- Testing Cognitive Trace ---" << std::endl;
     
@@ -72,5 +136,116 @@ int main() {
     remove(log_file.c_str());
     
     std::cout << "--- Cognitive Trace Verified ---" << std::endl;
+
+    // 5. Binary Execution Trace: a tiny ring (producer stalls, wraparound)
+    // round-trips through the drain thread and the chunked encoding
+    std::cout << "--- Testing Execution Trace ---" << std::endl;
+    std::string trace_file = "exec_trace_test.htr";
+    std::vector<ExecTrace::Record> written;
+    std::mt19937_64 rng(7);
+    ExecTrace::Record rec;
+    for (int i = 0; i < 20000; ++i) {
+        rec.cycle += (rng() % 8 == 0) ? 256 : 1;
+        rec.pc = (rng() % 4 == 0) ? (int64_t)(rng() % 0x8000) - 100 : rec.pc + 1;
+        rec.rd = (int8_t)(rng() % 16);
+        rec.rd_value = (int64_t)(rng() % 7625597484987ULL) - 3812798742493LL; // Full 27-trit range
+        rec.op = (int16_t)(rng() % 50) - 5;
+        rec.flags = (rng() % 3 == 0) ? ExecTrace::HAS_MEM : 0;
+        rec.mem_addr = (int64_t)(rng() % 0x10000) - 0x100;
+        written.push_back(rec);
+    }
+    ExecTrace::Recorder recorder(64);
+    Assert(recorder.Open(trace_file), "Trace file opened");
+    for (const ExecTrace::Record& r : written) recorder.Push(r);
+    recorder.Close();
+    std::vector<ExecTrace::Record> read_back = ReadTrace(trace_file);
+    bool same = read_back.size() == written.size();
+    for (size_t i = 0; same && i < written.size(); ++i) same = SameRecord(read_back[i], written[i]);
+    Assert(same, "Records round-trip through ring, drain and file");
+    Assert(recorder.BytesWritten() < written.size() * sizeof(ExecTrace::Record) / 2, "Trace is compressed");
+
+    // 6. CPU records: one per instruction, identical on every core
+    std::vector<ExecTrace::Record> traced = TraceLoop(Cpu::Core::Switch, trace_file);
+    Assert(traced.size() == 16, "One record per executed instruction");
+    Assert(traced[3].op == (int16_t)Opcode::STW && (traced[3].flags & ExecTrace::HAS_MEM) &&
+           traced[3].mem_addr == 0x3005 && traced[3].pc == 3, "Store record carries its address");
+    Assert(traced[4].op == (int16_t)Opcode::LDW && traced[4].rd == 3 && traced[4].rd_value == 3 &&
+           traced[8].rd_value == 2, "Load records carry the loaded value");
+    Assert(traced[15].op == (int16_t)Opcode::HLT && traced[15].cycle == 15, "Trace ends at HLT");
+    std::vector<ExecTrace::Record> traced_jit = TraceLoop(Cpu::Core::Jit, trace_file);
+    same = traced_jit.size() == traced.size();
+    for (size_t i = 0; same && i < traced.size(); ++i) same = SameRecord(traced_jit[i], traced[i]);
+    Assert(same, "Traces match across cores");
+    remove(trace_file.c_str());
+
+    std::cout << "--- Execution Trace Verified ---" << std::endl;
+
+    // 7. Guest profiler: per-PC/opcode counts and calling contexts through R14
+    //   CALL f / CALL f / HLT / NOP
+    //   f: MOV R13, R14 / CALL g / MOV R14, R13 / RET
+    //   g: LDI R1, 1 / RET
+    std::cout << "--- Testing Guest Profiler ---" << std::endl;
+    const TernaryWord calls[] = {
+        EncodeInst(Opcode::CALL, 4, 0, 0, 3), EncodeInst(Opcode::CALL, 4, 0, 0, 2),
+        EncodeInst(Opcode::HLT, 0, 0, 0, 0), EncodeInst(Opcode::NOP, 0, 0, 0, 0),
+        EncodeInst(Opcode::MOV, 0, 13, 14, 0), EncodeInst(Opcode::CALL, 4, 0, 0, 2),
+        EncodeInst(Opcode::MOV, 0, 14, 13, 0), EncodeInst(Opcode::RET, 0, 0, 0, 0),
+        EncodeInst(Opcode::LDI, 0, 1, 0, 1), EncodeInst(Opcode::RET, 0, 0, 0, 0)
+    };
+    TernaryMemory prof_mem;
+    for (int64_t i = 0; i < 10; ++i) prof_mem.Write(i, calls[i]);
+    Cpu prof_cpu(prof_mem);
+    prof_cpu.core = Cpu::Core::Jit;
+    GuestProfiler profiler({ { "f", ".text", 4, true, 4 }, { "g", ".text", 8, true, 8 } });
+    prof_cpu.profiler = &profiler;
+    std::streambuf* old_out = std::cout.rdbuf(nullptr);
+    prof_cpu.RunUntil(Cpu::StopConditions(100));
+    std::cout.rdbuf(old_out);
+    Assert(prof_cpu.halted && profiler.Instructions() == 15, "Every instruction profiled");
+    Assert(profiler.Count(0) == 1 && profiler.Count(4) == 2 && profiler.Count(9) == 2 && profiler.Count(3) == 0,
+           "Per-PC counts");
+    Assert(profiler.OpcodeCount((int)Opcode::CALL) == 4 && profiler.OpcodeCount((int)Opcode::RET) == 4 &&
+           profiler.UnmatchedReturns() == 0, "Opcode histogram and matched returns");
+    Assert(profiler.Symbolize(6) == "f+2" && profiler.Symbolize(8) == "g", "Symbolization");
+    std::ostringstream folded;
+    profiler.WriteFolded(folded);
+    Assert(folded.str() == "[root] 3\n[root];f 8\n[root];f;g 4\n", "Folded stacks");
+    std::cout << "--- Guest Profiler Verified ---" << std::endl;
+
+    // 8. Host profile: per-opcode counts and memory path outcomes
+    //   LDW R1, [R2] (unallocated page) / LDW R3, [R4] (allocated page) /
+    //   STW R3, [R0 + 100] (system) / HLT
+    std::cout << "--- Testing Host Profile ---" << std::endl;
+    TernaryMemory host_mem;
+    host_mem.Write(0, EncodeInst(Opcode::LDW, 0, 1, 2, 0));
+    host_mem.Write(1, EncodeInst(Opcode::LDW, 0, 3, 4, 0));
+    host_mem.Write(2, EncodeInst(Opcode::STW, 0, 3, 0, 100));
+    host_mem.Write(3, EncodeInst(Opcode::HLT, 0, 0, 0, 0));
+    host_mem.Write(0x3100, TernaryWord::FromInt64(5));
+    Cpu host_cpu(host_mem);
+    host_cpu.core = Cpu::Core::Block;
+    host_cpu.regs[2].SetInt(0x3000);
+    host_cpu.regs[4].SetInt(0x3100);
+    HostProfile host;
+    host_cpu.SetHostProfile(&host);
+    old_out = std::cout.rdbuf(nullptr);
+    host_cpu.RunUntil(Cpu::StopConditions(100));
+    std::cout.rdbuf(old_out);
+    Assert(host_cpu.halted && host_mem.Read(100).ToInt64() == 5, "Program ran under the host profile");
+    Assert(host.ops[(int)Opcode::LDW].count == 2 && host.ops[(int)Opcode::STW].count == 1 &&
+           host.ops[(int)Opcode::HLT].count == 1 && host.ops[(int)Opcode::ADD].count == 0, "Per-opcode counts");
+    Assert(host.mem[HostProfile::MEM_UNALLOCATED].count == 1 && host.mem[HostProfile::MEM_COGNITIVE].count == 1 &&
+           host.mem[HostProfile::MEM_SYSTEM].count >= 1, "Memory path outcomes");
+    host.Reset();
+    Assert(host_mem.GetRawPointer(TernaryWord::FromInt64(0x3100), 8) != nullptr &&
+           host_mem.GetRawPointer(TernaryWord::FromInt64(0x3000), 8) == nullptr &&
+           host.mem[HostProfile::MEM_RAW_HIT].count == 1 && host.mem[HostProfile::MEM_RAW_MISS].count == 1,
+           "Raw pointer hits and misses");
+    std::ostringstream host_table;
+    host.ops[(int)Opcode::LDW].Add(1000);
+    host.Print(host_table);
+    Assert(host_table.str().find("LDW") != std::string::npos &&
+           host_table.str().find("raw pointer miss") != std::string::npos, "Host profile table");
+    std::cout << "--- Host Profile Verified ---" << std::endl;
     return 0;
 }
@@ -2,6 +2,7 @@
 #include <vector>
 #include <cassert>
 #include "../cpu.h"
+#include "../isa.h"
 #include "../memory.h"
 #include "../cognitive/scheduler.h"
 #include "../cognitive/agent.h"
@@ -105,9 +106,55 @@ void TestIsolation() {
     std::cout << "[Test] Isolation Test Passed." << std::endl;
 }
 
+// Instruction word, register/immediate field in trits 0..9 (mode 0)
+static TernaryWord EncodeOp(Opcode op, int64_t rd, int64_t rs1, int64_t rs2_or_imm) {
+    TernaryWord inst;
+    auto put = [&inst](int start, int len, int64_t v) {
+        TernaryWord t = TernaryWord::FromInt64(v);
+        for (int i = 0; i < len; ++i) inst.SetTrit(start + i, t.GetTrit(i));
+    };
+    put(21, 6, static_cast<int64_t>(op));
+    put(14, 4, rd);
+    put(10, 4, rs1);
+    put(0, 10, rs2_or_imm);
+    return inst;
+}
+
+void TestContextSwitchFlags() {
+    std::cout << "[Test] Starting Context Switch Flags Test..." << std::endl;
+    TernaryMemory mem;
+    Cpu cpu(mem);
+    Scheduler scheduler(cpu);
+
+    // Agent: LDI R1, -5 / SUB R3, R2, R1 (= 5: P) / HLT
+    cpu.mem.Write(TernaryWord::FromInt64(0), EncodeOp(Opcode::LDI, 1, 0, -5));
+    cpu.mem.Write(TernaryWord::FromInt64(1), EncodeOp(Opcode::SUB, 3, 2, 1));
+    cpu.mem.Write(TernaryWord::FromInt64(2), EncodeOp(Opcode::HLT, 0, 0, 0));
+
+    auto a1 = std::make_shared<Agent>(1);
+    a1->state = AgentState::ACTIVE;
+    a1->status = -1; // N, to be overwritten by the agent's SUB
+    scheduler.RegisterAgent(a1);
+
+    // System flags still pending (never read) when the agent is switched in
+    cpu.UpdateFlagsArithmetic(0, -1, true); // Z, C = -1, O
+    scheduler.Tick();
+
+    TernaryWord agent_status = TernaryWord::FromInt64(a1->status);
+    assert(agent_status.GetTrit(0) == 0 && agent_status.GetTrit(1) == 1 && agent_status.GetTrit(2) == 0);
+    assert(agent_status.GetTrit(3) == 0 && agent_status.GetTrit(4) == 0);
+
+    const TernaryWord& system_status = cpu.status;
+    assert(system_status.GetTrit(0) == 1 && system_status.GetTrit(1) == 0 && system_status.GetTrit(2) == 0);
+    assert(system_status.GetTrit(3) == -1 && system_status.GetTrit(4) == 1);
+
+    std::cout << "[Test] Context Switch Flags Test Passed." << std::endl;
+}
+
 int main() {
     TestFairness();
     TestIsolation();
+    TestContextSwitchFlags();
     std::cout << "All Cognitive Runtime Tests Passed." << std::endl;
     return 0;
 }
@@ -122,9 +122,7 @@ void GraphCompiler::PlanMemory(std::vector<GraphNode>& ir, TernaryMemory& mem, c
                 const auto& w = model.layers[layer_model_idx].weights;
                 
                 // Write weights to planned memory
-                for(size_t i=0; i<w.size(); ++i) {
-                    mem.Write(TernaryWord::FromInt64(current_heap + i), w[i]);
-                }
+                mem.WriteBlock(current_heap, w.data(), w.size());
                 
                 // Advance Heap (Align to next page optionally? No, let's keep it dense for now)
                 current_heap += w.size();
@@ -30,9 +30,7 @@ std::vector<TernaryWord> HelixRuntime::Execute(const TNNModel& model, const std:
     // 3. Execution Phase
     // Write initial input to the planned input address of the first node
     int64_t first_input_addr = optimized_ir.empty() ? input_addr : optimized_ir[0].input_addr;
-    for (size_t i = 0; i < input.size(); ++i) {
-         mem.Write(TernaryWord::FromInt64(first_input_addr + i), input[i]);
-    }
+    mem.WriteBlock(first_input_addr, input.data(), input.size());
     
     // Set Vector Length for the CPU (Hardware config assumed uniform for now)
     // In a real Mixed-Dimensional model, we need a VSETL opcode injected 
@@ -46,7 +44,11 @@ std::vector<TernaryWord> HelixRuntime::Execute(const TNNModel& model, const std:
     cpu.halted = false;
     cpu.trace_enabled = false;
     cpu.metrics.active_cycles = 0;
-    cpu.Run(10000); // 10k max cycles safety limit
+    Cpu::StopConditions stop;
+    stop.max_cycles = 10000; // Safety limit
+    if (cpu.RunUntil(stop).reason != Cpu::StopReason::Halted) {
+        std::cerr << "[Runtime] Program did not halt within " << stop.max_cycles << " cycles" << std::endl;
+    }
     
     std::cout << "[Runtime] Execution Complete. Active Cycles: " << cpu.metrics.active_cycles << std::endl;
     
@@ -58,9 +60,7 @@ std::vector<TernaryWord> HelixRuntime::Execute(const TNNModel& model, const std:
         int64_t out_addr = last_node.output_addr;
         
         result.resize(out_size);
-        for(int i = 0; i < out_size; ++i) {
-            result[i] = mem.Read(TernaryWord::FromInt64(out_addr + i));
-        }
+        mem.ReadBlock(out_addr, result.data(), result.size());
     }
     
     return result;
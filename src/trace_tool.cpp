@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "exec_trace.h"
+#include "isa.h"
+
+// helix_trace: decode, filter and summarize binary execution traces
+// (helix_emu --trace-file=<path>)
+
+struct Filter {
+    int64_t pc_lo = INT64_MIN, pc_hi = INT64_MAX;
+    uint64_t cycle_lo = 0, cycle_hi = UINT64_MAX;
+    int64_t op = -1000; // -1000 = any
+    int rd = -1;        // -1 = any
+    bool mem_only = false;
+
+    bool Match(const ExecTrace::Record& r) const {
+        return r.pc >= pc_lo && r.pc <= pc_hi && r.cycle >= cycle_lo && r.cycle <= cycle_hi &&
+               (op == -1000 || r.op == op) && (rd < 0 || r.rd == rd) &&
+               (!mem_only || (r.flags & ExecTrace::HAS_MEM));
+    }
+};
+
+template <typename T>
+static bool ParseInt(const std::string& text, T& out) {
+    try {
+        size_t used = 0;
+        out = (T)std::stoll(text, &used, 0);
+        return used == text.size();
+    } catch (...) {
+        return false;
+    }
+}
+
+// "A" or "A:B" (either side may be empty)
+template <typename T>
+static bool ParseRange(const std::string& text, T& lo, T& hi) {
+    size_t colon = text.find(':');
+    if (colon == std::string::npos) {
+        if (!ParseInt(text, lo)) return false;
+        hi = lo;
+        return true;
+    }
+    if (colon > 0 && !ParseInt(text.substr(0, colon), lo)) return false;
+    if (colon + 1 < text.size() && !ParseInt(text.substr(colon + 1), hi)) return false;
+    return true;
+}
+
+static int64_t ParseOpcode(const std::string& text) {
+    for (int64_t op = 0; op < OPCODE_COUNT; ++op) {
+        std::string name = OpcodeName(op);
+        std::string upper = text;
+        std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+        if (name == upper) return op;
+    }
+    int64_t op = -1000;
+    return ParseInt(text, op) ? op : -1000;
+}
+
+static void PrintRecord(const ExecTrace::Record& r) {
+    std::cout << "cyc=" << r.cycle << " pc=" << r.pc << " op=" << OpcodeName(r.op);
+    if (std::string(OpcodeName(r.op)) == "?") std::cout << "(" << r.op << ")";
+    std::cout << " R" << (int)r.rd << "=" << r.rd_value;
+    if (r.flags & ExecTrace::HAS_MEM) std::cout << " mem=" << r.mem_addr;
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: helix_trace <trace.htr> [--summary] [--pc=A[:B]] [--cycles=A[:B]]"
+                  << " [--op=NAME|N] [--rd=N] [--mem] [--limit=N]" << std::endl;
+        return 1;
+    }
+
+    Filter filter;
+    bool summary = false;
+    uint64_t limit = UINT64_MAX;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool ok = true;
+        if (arg == "--summary") summary = true;
+        else if (arg == "--mem") filter.mem_only = true;
+        else if (arg.rfind("--pc=", 0) == 0) ok = ParseRange(arg.substr(5), filter.pc_lo, filter.pc_hi);
+        else if (arg.rfind("--cycles=", 0) == 0) ok = ParseRange(arg.substr(9), filter.cycle_lo, filter.cycle_hi);
+        else if (arg.rfind("--op=", 0) == 0) ok = (filter.op = ParseOpcode(arg.substr(5))) != -1000;
+        else if (arg.rfind("--rd=", 0) == 0) ok = ParseInt(arg.substr(5), filter.rd);
+        else if (arg.rfind("--limit=", 0) == 0) ok = ParseInt(arg.substr(8), limit);
+        else ok = false;
+        if (!ok) {
+            std::cerr << "Bad argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    ExecTrace::Reader reader;
+    if (!reader.Open(argv[1])) {
+        std::cerr << "Not a Helix9 trace file: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    // Summary state
+    uint64_t total = 0, matched = 0, loads = 0, stores = 0;
+    uint64_t first_cycle = 0, last_cycle = 0;
+    std::map<int64_t, uint64_t> op_counts;
+    std::map<int64_t, uint64_t> pc_counts;
+
+    ExecTrace::Record r;
+    while (reader.Next(r)) {
+        total++;
+        if (!filter.Match(r)) continue;
+        if (matched == 0) first_cycle = r.cycle;
+        last_cycle = r.cycle;
+        matched++;
+        if (summary) {
+            op_counts[r.op]++;
+            pc_counts[r.pc]++;
+            if (r.op == (int64_t)Opcode::LDW) loads++;
+            if (r.op == (int64_t)Opcode::STW) stores++;
+        } else if (matched <= limit) {
+            PrintRecord(r);
+        }
+    }
+
+    if (!summary) return 0;
+
+    std::cout << "Records: " << matched << " of " << total << std::endl;
+    if (matched == 0) return 0;
+    std::cout << "Cycles: " << first_cycle << " .. " << last_cycle << std::endl;
+    std::cout << "Distinct PCs: " << pc_counts.size() << std::endl;
+    std::cout << "Loads: " << loads << "  Stores: " << stores << std::endl;
+
+    std::vector<std::pair<uint64_t, int64_t>> ops;
+    for (const auto& entry : op_counts) ops.push_back({ entry.second, entry.first });
+    std::sort(ops.rbegin(), ops.rend());
+    std::cout << "\nOpcode histogram:" << std::endl;
+    for (const auto& entry : ops) {
+        std::cout << "  " << std::left << std::setw(8) << OpcodeName(entry.second) << std::right
+                  << std::setw(12) << entry.first << std::setw(8) << std::fixed << std::setprecision(1)
+                  << (100.0 * entry.first / matched) << "%" << std::endl;
+    }
+
+    std::vector<std::pair<uint64_t, int64_t>> pcs;
+    for (const auto& entry : pc_counts) pcs.push_back({ entry.second, entry.first });
+    std::sort(pcs.rbegin(), pcs.rend());
+    std::cout << "\nHottest PCs:" << std::endl;
+    for (size_t i = 0; i < pcs.size() && i < 10; ++i) {
+        std::cout << "  pc=" << std::left << std::setw(10) << pcs[i].second << std::right
+                  << std::setw(12) << pcs[i].first << std::endl;
+    }
+    return 0;
+}
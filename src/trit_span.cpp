@@ -0,0 +1,616 @@
+#include "trit_span.h"
+#include <bitset>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define HELIX_X86_64 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define HELIX_TARGET_AVX2
+#define HELIX_TARGET_POPCNT
+#else
+#define HELIX_TARGET_AVX2 __attribute__((target("avx2")))
+#define HELIX_TARGET_POPCNT __attribute__((target("popcnt")))
+#endif
+#endif
+
+// --- TritArray ---
+
+void TritArray::Load(const TernaryWord* words, size_t n) {
+    Resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        pos[i] = words[i].pos;
+        neg[i] = words[i].neg;
+    }
+}
+
+void TritArray::Store(TernaryWord* words) const {
+    for (size_t i = 0; i < pos.size(); ++i) {
+        words[i] = TernaryWord(pos[i], neg[i]);
+    }
+}
+
+namespace TritKernels {
+
+namespace {
+
+const uint32_t WORD_MASK = (1u << 27) - 1;
+const uint32_t HIGH_TRITS = WORD_MASK & ~1u; // Trits 1..26: zero in a single-trit word
+
+// The word packers read TernaryWord arrays as interleaved pos/neg planes
+static_assert(sizeof(TernaryWord) == 2 * sizeof(uint32_t), "TernaryWord must be two uint32 planes");
+
+// Kernel signatures: (out_p, out_n, a_p, a_n, b_p, b_n, count)
+typedef void (*BinaryKernel)(uint32_t*, uint32_t*, const uint32_t*, const uint32_t*,
+                             const uint32_t*, const uint32_t*, size_t);
+typedef int64_t (*ReduceKernel)(const uint32_t*, const uint32_t*,
+                                const uint32_t*, const uint32_t*, size_t);
+// (words, count, out_p, out_n) -> all single-trit
+typedef bool (*PackKernel)(const TernaryWord*, size_t, uint64_t*, uint64_t*);
+// (a_p, a_n, b_p, b_n, blocks)
+typedef int64_t (*BitplaneKernel)(const uint64_t*, const uint64_t*, const uint64_t*, const uint64_t*, size_t);
+// Interleaved words: (out, a, b, count) and (a, count)
+typedef void (*WordBinaryKernel)(TernaryWord*, const TernaryWord*, const TernaryWord*, size_t);
+typedef int64_t (*WordReduceKernel)(const TernaryWord*, size_t);
+
+struct KernelTable {
+    BinaryKernel consensus;
+    BinaryKernel decay;
+    BinaryKernel min;
+    BinaryKernel max;
+    ReduceKernel popcount; // b planes unused
+    ReduceKernel hamming;
+    PackKernel pack_words;
+    BitplaneKernel bitplane_dot;
+    WordBinaryKernel consensus_words;
+    WordBinaryKernel decay_words;
+    WordReduceKernel popcount_words;
+};
+
+// --- Per-word Logic (shared by scalar kernels and SIMD tails) ---
+
+inline void ConsensusWord(uint32_t ap, uint32_t an, uint32_t bp, uint32_t bn, uint32_t& p, uint32_t& n) {
+    p = (ap & ~bn) | (bp & ~an);
+    n = (an & ~bp) | (bn & ~ap);
+}
+
+inline int CountBits(uint32_t x) {
+    return (int)std::bitset<32>(x).count();
+}
+
+inline int CountBits64(uint64_t x) {
+    return (int)std::bitset<64>(x).count();
+}
+
+// Packs up to 64 words into one bitplane block; returns the OR of their planes
+inline uint32_t PackBlock(const TernaryWord* words, size_t n, uint64_t& bp, uint64_t& bn) {
+    uint32_t seen = 0;
+    uint64_t p = 0, q = 0;
+    for (size_t j = 0; j < n; ++j) {
+        seen |= words[j].pos | words[j].neg;
+        p |= (uint64_t)(words[j].pos & 1) << j;
+        q |= (uint64_t)(words[j].neg & 1) << j;
+    }
+    bp = p;
+    bn = q;
+    return seen;
+}
+
+// --- Scalar ---
+
+void ScalarConsensus(uint32_t* op, uint32_t* on, const uint32_t* ap, const uint32_t* an,
+                     const uint32_t* bp, const uint32_t* bn, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t p, q;
+        ConsensusWord(ap[i], an[i], bp[i], bn[i], p, q);
+        op[i] = p; on[i] = q;
+    }
+}
+
+void ScalarDecay(uint32_t* op, uint32_t* on, const uint32_t* ap, const uint32_t* an,
+                 const uint32_t* bp, const uint32_t* bn, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        op[i] = ap[i] & bp[i];
+        on[i] = an[i] & bn[i];
+    }
+}
+
+void ScalarMin(uint32_t* op, uint32_t* on, const uint32_t* ap, const uint32_t* an,
+               const uint32_t* bp, const uint32_t* bn, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t p = ap[i] & bp[i];
+        uint32_t q = an[i] | bn[i];
+        op[i] = p; on[i] = q;
+    }
+}
+
+void ScalarMax(uint32_t* op, uint32_t* on, const uint32_t* ap, const uint32_t* an,
+               const uint32_t* bp, const uint32_t* bn, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t p = ap[i] | bp[i];
+        uint32_t q = an[i] & bn[i];
+        op[i] = p; on[i] = q;
+    }
+}
+
+int64_t ScalarPopCount(const uint32_t* ap, const uint32_t* an, const uint32_t*, const uint32_t*, size_t n) {
+    int64_t total = 0;
+    for (size_t i = 0; i < n; ++i) total += CountBits((ap[i] | an[i]) & WORD_MASK);
+    return total;
+}
+
+int64_t ScalarHamming(const uint32_t* ap, const uint32_t* an, const uint32_t* bp, const uint32_t* bn, size_t n) {
+    int64_t total = 0;
+    for (size_t i = 0; i < n; ++i) total += CountBits(((ap[i] ^ bp[i]) | (an[i] ^ bn[i])) & WORD_MASK);
+    return total;
+}
+
+bool ScalarPackWords(const TernaryWord* words, size_t n, uint64_t* bp, uint64_t* bn) {
+    uint32_t seen = 0;
+    for (size_t b = 0; b * 64 < n; ++b) {
+        seen |= PackBlock(words + b * 64, n - b * 64 < 64 ? n - b * 64 : 64, bp[b], bn[b]);
+    }
+    return (seen & HIGH_TRITS) == 0;
+}
+
+int64_t ScalarBitplaneDot(const uint64_t* ap, const uint64_t* an, const uint64_t* bp, const uint64_t* bn, size_t blocks) {
+    int64_t total = 0;
+    for (size_t i = 0; i < blocks; ++i) {
+        total += CountBits64(ap[i] & bp[i]) + CountBits64(an[i] & bn[i])
+               - CountBits64(ap[i] & bn[i]) - CountBits64(an[i] & bp[i]);
+    }
+    return total;
+}
+
+void ScalarConsensusWords(TernaryWord* out, const TernaryWord* a, const TernaryWord* b, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t p, q;
+        ConsensusWord(a[i].pos, a[i].neg, b[i].pos, b[i].neg, p, q);
+        out[i] = TernaryWord(p, q);
+    }
+}
+
+void ScalarDecayWords(TernaryWord* out, const TernaryWord* a, const TernaryWord* b, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = TernaryWord(a[i].pos & b[i].pos, a[i].neg & b[i].neg);
+}
+
+int64_t ScalarPopCountWords(const TernaryWord* a, size_t n) {
+    int64_t total = 0;
+    for (size_t i = 0; i < n; ++i) total += CountBits((a[i].pos | a[i].neg) & WORD_MASK);
+    return total;
+}
+
+const KernelTable SCALAR_KERNELS = {
+    ScalarConsensus, ScalarDecay, ScalarMin, ScalarMax, ScalarPopCount, ScalarHamming,
+    ScalarPackWords, ScalarBitplaneDot,
+    ScalarConsensusWords, ScalarDecayWords, ScalarPopCountWords
+};
+
+#ifdef HELIX_X86_64
+
+// --- SSE2 (4 words per step) ---
+
+// SWAR popcount of each 32-bit lane, summed into two 64-bit lanes
+inline __m128i PopCountSSE2(__m128i x) {
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0F);
+    x = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi16(x, 1), m1));
+    x = _mm_add_epi8(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi16(x, 2), m2));
+    x = _mm_and_si128(_mm_add_epi8(x, _mm_srli_epi16(x, 4)), m4);
+    return _mm_sad_epu8(x, _mm_setzero_si128());
+}
+
+inline int64_t HorizontalSumSSE2(__m128i acc) {
+    return (int64_t)_mm_cvtsi128_si64(acc) + (int64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(acc, acc));
+}
+
+#define HELIX_SSE2_BINARY(NAME, EXPR_P, EXPR_N, TAIL)                                              \
+void NAME(uint32_t* op, uint32_t* on, const uint32_t* ap, const uint32_t* an,                      \
+          const uint32_t* bp, const uint32_t* bn, size_t n) {                                      \
+    size_t i = 0;                                                                                  \
+    for (; i + 4 <= n; i += 4) {                                                                   \
+        __m128i vap = _mm_loadu_si128((const __m128i*)(ap + i));                                   \
+        __m128i van = _mm_loadu_si128((const __m128i*)(an + i));                                   \
+        __m128i vbp = _mm_loadu_si128((const __m128i*)(bp + i));                                   \
+        __m128i vbn = _mm_loadu_si128((const __m128i*)(bn + i));                                   \
+        __m128i rp = EXPR_P;                                                                       \
+        __m128i rn = EXPR_N;                                                                       \
+        _mm_storeu_si128((__m128i*)(op + i), rp);                                                  \
+        _mm_storeu_si128((__m128i*)(on + i), rn);                                                  \
+    }                                                                                              \
+    TAIL(op + i, on + i, ap + i, an + i, bp + i, bn + i, n - i);                                   \
+}
+
+HELIX_SSE2_BINARY(SSE2Consensus,
+    _mm_or_si128(_mm_andnot_si128(vbn, vap), _mm_andnot_si128(van, vbp)),
+    _mm_or_si128(_mm_andnot_si128(vbp, van), _mm_andnot_si128(vap, vbn)),
+    ScalarConsensus)
+HELIX_SSE2_BINARY(SSE2Decay, _mm_and_si128(vap, vbp), _mm_and_si128(van, vbn), ScalarDecay)
+HELIX_SSE2_BINARY(SSE2Min, _mm_and_si128(vap, vbp), _mm_or_si128(van, vbn), ScalarMin)
+HELIX_SSE2_BINARY(SSE2Max, _mm_or_si128(vap, vbp), _mm_and_si128(van, vbn), ScalarMax)
+
+int64_t SSE2PopCount(const uint32_t* ap, const uint32_t* an, const uint32_t*, const uint32_t*, size_t n) {
+    const __m128i mask = _mm_set1_epi32((int)WORD_MASK);
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_or_si128(_mm_loadu_si128((const __m128i*)(ap + i)), _mm_loadu_si128((const __m128i*)(an + i)));
+        acc = _mm_add_epi64(acc, PopCountSSE2(_mm_and_si128(v, mask)));
+    }
+    return HorizontalSumSSE2(acc) + ScalarPopCount(ap + i, an + i, nullptr, nullptr, n - i);
+}
+
+int64_t SSE2Hamming(const uint32_t* ap, const uint32_t* an, const uint32_t* bp, const uint32_t* bn, size_t n) {
+    const __m128i mask = _mm_set1_epi32((int)WORD_MASK);
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i dp = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(ap + i)), _mm_loadu_si128((const __m128i*)(bp + i)));
+        __m128i dn = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(an + i)), _mm_loadu_si128((const __m128i*)(bn + i)));
+        acc = _mm_add_epi64(acc, PopCountSSE2(_mm_and_si128(_mm_or_si128(dp, dn), mask)));
+    }
+    return HorizontalSumSSE2(acc) + ScalarHamming(ap + i, an + i, bp + i, bn + i, n - i);
+}
+
+// Trit 0 of each 32-bit lane moved to the sign bit, gathered by movemask
+inline uint64_t LowTritsSSE2(__m128i v) {
+    return (uint64_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_slli_epi32(v, 31)));
+}
+
+bool SSE2PackWords(const TernaryWord* words, size_t n, uint64_t* bp, uint64_t* bn) {
+    __m128i seen = _mm_setzero_si128();
+    size_t b = 0;
+    for (; (b + 1) * 64 <= n; ++b) {
+        const TernaryWord* w = words + b * 64;
+        uint64_t p = 0, q = 0;
+        for (int j = 0; j < 64; j += 4) {
+            // p0 n0 p1 n1 / p2 n2 p3 n3 -> p0..p3 / n0..n3
+            __m128 lo = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(w + j)));
+            __m128 hi = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(w + j + 2)));
+            __m128i vp = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+            __m128i vn = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+            seen = _mm_or_si128(seen, _mm_or_si128(vp, vn));
+            p |= LowTritsSSE2(vp) << j;
+            q |= LowTritsSSE2(vn) << j;
+        }
+        bp[b] = p;
+        bn[b] = q;
+    }
+    uint32_t tail = b * 64 < n ? PackBlock(words + b * 64, n - b * 64, bp[b], bn[b]) : 0;
+    seen = _mm_and_si128(seen, _mm_set1_epi32((int)HIGH_TRITS));
+    return _mm_movemask_epi8(_mm_cmpeq_epi32(seen, _mm_setzero_si128())) == 0xFFFF && (tail & HIGH_TRITS) == 0;
+}
+
+// Interleaved words, 2 per step. Swapping the planes of the other operand
+// lines its neg up with our pos (and vice versa), so both planes of a
+// consensus are  a & ~swap(b) | b & ~swap(a).
+inline __m128i SwapPlanesSSE2(__m128i v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+
+void SSE2ConsensusWords(TernaryWord* out, const TernaryWord* a, const TernaryWord* b, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        __m128i r = _mm_or_si128(_mm_andnot_si128(SwapPlanesSSE2(vb), va), _mm_andnot_si128(SwapPlanesSSE2(va), vb));
+        _mm_storeu_si128((__m128i*)(out + i), r);
+    }
+    ScalarConsensusWords(out + i, a + i, b + i, n - i);
+}
+
+void SSE2DecayWords(TernaryWord* out, const TernaryWord* a, const TernaryWord* b, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i r = _mm_and_si128(_mm_loadu_si128((const __m128i*)(a + i)), _mm_loadu_si128((const __m128i*)(b + i)));
+        _mm_storeu_si128((__m128i*)(out + i), r);
+    }
+    ScalarDecayWords(out + i, a + i, b + i, n - i);
+}
+
+// Non-zero trits of 4 words as one vector: pos|neg of x's words in the low
+// halves of the 64-bit lanes, of y's words in the high halves
+inline __m128i OrPlanesSSE2(__m128i x, __m128i y) {
+    const __m128i low = _mm_set_epi32(0, (int)WORD_MASK, 0, (int)WORD_MASK);
+    const __m128i high = _mm_set_epi32((int)WORD_MASK, 0, (int)WORD_MASK, 0);
+    return _mm_or_si128(_mm_and_si128(_mm_or_si128(x, _mm_srli_epi64(x, 32)), low),
+                        _mm_and_si128(_mm_or_si128(y, _mm_slli_epi64(y, 32)), high));
+}
+
+int64_t SSE2PopCountWords(const TernaryWord* a, size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*)(a + i + 2));
+        acc = _mm_add_epi64(acc, PopCountSSE2(OrPlanesSSE2(x, y)));
+    }
+    return HorizontalSumSSE2(acc) + ScalarPopCountWords(a + i, n - i);
+}
+
+const KernelTable SSE2_KERNELS = {
+    SSE2Consensus, SSE2Decay, SSE2Min, SSE2Max, SSE2PopCount, SSE2Hamming,
+    SSE2PackWords, ScalarBitplaneDot,
+    SSE2ConsensusWords, SSE2DecayWords, SSE2PopCountWords
+};
+
+// --- AVX2 (8 words per step) ---
+
+HELIX_TARGET_AVX2 inline __m256i PopCountAVX2(__m256i x) {
+    const __m256i m1 = _mm256_set1_epi8(0x55);
+    const __m256i m2 = _mm256_set1_epi8(0x33);
+    const __m256i m4 = _mm256_set1_epi8(0x0F);
+    x = _mm256_sub_epi8(x, _mm256_and_si256(_mm256_srli_epi16(x, 1), m1));
+    x = _mm256_add_epi8(_mm256_and_si256(x, m2), _mm256_and_si256(_mm256_srli_epi16(x, 2), m2));
+    x = _mm256_and_si256(_mm256_add_epi8(x, _mm256_srli_epi16(x, 4)), m4);
+    return _mm256_sad_epu8(x, _mm256_setzero_si256());
+}
+
+HELIX_TARGET_AVX2 inline int64_t HorizontalSumAVX2(__m256i acc) {
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    return (int64_t)_mm_cvtsi128_si64(sum) + (int64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(sum, sum));
+}
+
+#define HELIX_AVX2_BINARY(NAME, EXPR_P, EXPR_N, TAIL)                                              \
+HELIX_TARGET_AVX2 void NAME(uint32_t* op, uint32_t* on, const uint32_t* ap, const uint32_t* an,    \
+          const uint32_t* bp, const uint32_t* bn, size_t n) {                                      \
+    size_t i = 0;                                                                                  \
+    for (; i + 8 <= n; i += 8) {                                                                   \
+        __m256i vap = _mm256_loadu_si256((const __m256i*)(ap + i));                                \
+        __m256i van = _mm256_loadu_si256((const __m256i*)(an + i));                                \
+        __m256i vbp = _mm256_loadu_si256((const __m256i*)(bp + i));                                \
+        __m256i vbn = _mm256_loadu_si256((const __m256i*)(bn + i));                                \
+        __m256i rp = EXPR_P;                                                                       \
+        __m256i rn = EXPR_N;                                                                       \
+        _mm256_storeu_si256((__m256i*)(op + i), rp);                                               \
+        _mm256_storeu_si256((__m256i*)(on + i), rn);                                               \
+    }                                                                                              \
+    TAIL(op + i, on + i, ap + i, an + i, bp + i, bn + i, n - i);                                   \
+}
+
+HELIX_AVX2_BINARY(AVX2Consensus,
+    _mm256_or_si256(_mm256_andnot_si256(vbn, vap), _mm256_andnot_si256(van, vbp)),
+    _mm256_or_si256(_mm256_andnot_si256(vbp, van), _mm256_andnot_si256(vap, vbn)),
+    ScalarConsensus)
+HELIX_AVX2_BINARY(AVX2Decay, _mm256_and_si256(vap, vbp), _mm256_and_si256(van, vbn), ScalarDecay)
+HELIX_AVX2_BINARY(AVX2Min, _mm256_and_si256(vap, vbp), _mm256_or_si256(van, vbn), ScalarMin)
+HELIX_AVX2_BINARY(AVX2Max, _mm256_or_si256(vap, vbp), _mm256_and_si256(van, vbn), ScalarMax)
+
+HELIX_TARGET_AVX2 int64_t AVX2PopCount(const uint32_t* ap, const uint32_t* an, const uint32_t*, const uint32_t*, size_t n) {
+    const __m256i mask = _mm256_set1_epi32((int)WORD_MASK);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(ap + i)), _mm256_loadu_si256((const __m256i*)(an + i)));
+        acc = _mm256_add_epi64(acc, PopCountAVX2(_mm256_and_si256(v, mask)));
+    }
+    return HorizontalSumAVX2(acc) + ScalarPopCount(ap + i, an + i, nullptr, nullptr, n - i);
+}
+
+HELIX_TARGET_AVX2 int64_t AVX2Hamming(const uint32_t* ap, const uint32_t* an, const uint32_t* bp, const uint32_t* bn, size_t n) {
+    const __m256i mask = _mm256_set1_epi32((int)WORD_MASK);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i dp = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(ap + i)), _mm256_loadu_si256((const __m256i*)(bp + i)));
+        __m256i dn = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(an + i)), _mm256_loadu_si256((const __m256i*)(bn + i)));
+        acc = _mm256_add_epi64(acc, PopCountAVX2(_mm256_and_si256(_mm256_or_si256(dp, dn), mask)));
+    }
+    return HorizontalSumAVX2(acc) + ScalarHamming(ap + i, an + i, bp + i, bn + i, n - i);
+}
+
+HELIX_TARGET_AVX2 inline uint64_t LowTritsAVX2(__m256i v) {
+    return (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_slli_epi32(v, 31)));
+}
+
+HELIX_TARGET_AVX2 bool AVX2PackWords(const TernaryWord* words, size_t n, uint64_t* bp, uint64_t* bn) {
+    __m256i seen = _mm256_setzero_si256();
+    size_t b = 0;
+    for (; (b + 1) * 64 <= n; ++b) {
+        const TernaryWord* w = words + b * 64;
+        uint64_t p = 0, q = 0;
+        for (int j = 0; j < 64; j += 8) {
+            // The in-lane shuffle yields words 0 1 4 5 | 2 3 6 7; the permute restores the order
+            __m256 lo = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(w + j)));
+            __m256 hi = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(w + j + 4)));
+            __m256i vp = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0))),
+                                                  _MM_SHUFFLE(3, 1, 2, 0));
+            __m256i vn = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1))),
+                                                  _MM_SHUFFLE(3, 1, 2, 0));
+            seen = _mm256_or_si256(seen, _mm256_or_si256(vp, vn));
+            p |= LowTritsAVX2(vp) << j;
+            q |= LowTritsAVX2(vn) << j;
+        }
+        bp[b] = p;
+        bn[b] = q;
+    }
+    uint32_t tail = b * 64 < n ? PackBlock(words + b * 64, n - b * 64, bp[b], bn[b]) : 0;
+    return _mm256_testz_si256(seen, _mm256_set1_epi32((int)HIGH_TRITS)) && (tail & HIGH_TRITS) == 0;
+}
+
+// Hardware popcount (HostHasAVX2 also requires POPCNT)
+HELIX_TARGET_POPCNT int64_t PopcntBitplaneDot(const uint64_t* ap, const uint64_t* an, const uint64_t* bp, const uint64_t* bn, size_t blocks) {
+    int64_t total = 0;
+    for (size_t i = 0; i < blocks; ++i) {
+        total += (int64_t)_mm_popcnt_u64(ap[i] & bp[i]) + (int64_t)_mm_popcnt_u64(an[i] & bn[i])
+               - (int64_t)_mm_popcnt_u64(ap[i] & bn[i]) - (int64_t)_mm_popcnt_u64(an[i] & bp[i]);
+    }
+    return total;
+}
+
+// Interleaved words, 4 per step (see SSE2ConsensusWords)
+HELIX_TARGET_AVX2 inline __m256i SwapPlanesAVX2(__m256i v) { return _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+
+HELIX_TARGET_AVX2 void AVX2ConsensusWords(TernaryWord* out, const TernaryWord* a, const TernaryWord* b, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        __m256i r = _mm256_or_si256(_mm256_andnot_si256(SwapPlanesAVX2(vb), va), _mm256_andnot_si256(SwapPlanesAVX2(va), vb));
+        _mm256_storeu_si256((__m256i*)(out + i), r);
+    }
+    ScalarConsensusWords(out + i, a + i, b + i, n - i);
+}
+
+HELIX_TARGET_AVX2 void AVX2DecayWords(TernaryWord* out, const TernaryWord* a, const TernaryWord* b, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i r = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i)));
+        _mm256_storeu_si256((__m256i*)(out + i), r);
+    }
+    ScalarDecayWords(out + i, a + i, b + i, n - i);
+}
+
+// 8 words as one vector (see OrPlanesSSE2)
+HELIX_TARGET_AVX2 inline __m256i OrPlanesAVX2(__m256i x, __m256i y) {
+    const __m256i low = _mm256_set1_epi64x((int64_t)WORD_MASK);
+    const __m256i high = _mm256_set1_epi64x((int64_t)WORD_MASK << 32);
+    return _mm256_or_si256(_mm256_and_si256(_mm256_or_si256(x, _mm256_srli_epi64(x, 32)), low),
+                           _mm256_and_si256(_mm256_or_si256(y, _mm256_slli_epi64(y, 32)), high));
+}
+
+HELIX_TARGET_AVX2 int64_t AVX2PopCountWords(const TernaryWord* a, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(a + i + 4));
+        acc = _mm256_add_epi64(acc, PopCountAVX2(OrPlanesAVX2(x, y)));
+    }
+    return HorizontalSumAVX2(acc) + ScalarPopCountWords(a + i, n - i);
+}
+
+const KernelTable AVX2_KERNELS = {
+    AVX2Consensus, AVX2Decay, AVX2Min, AVX2Max, AVX2PopCount, AVX2Hamming,
+    AVX2PackWords, PopcntBitplaneDot,
+    AVX2ConsensusWords, AVX2DecayWords, AVX2PopCountWords
+};
+
+bool HostHasAVX2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool popcnt = (info[2] & (1 << 23)) != 0; // Used by the AVX2 table's bitplane dot
+    if (!osxsave || !avx || !popcnt) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false; // OS saves YMM state
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"); // POPCNT: bitplane dot
+#endif
+}
+
+#endif // HELIX_X86_64
+
+ISA g_detected = DetectISA();
+ISA g_active = g_detected;
+
+const KernelTable& Kernels() {
+#ifdef HELIX_X86_64
+    switch (g_active) {
+        case ISA::AVX2: return AVX2_KERNELS;
+        case ISA::SSE2: return SSE2_KERNELS;
+        default: break;
+    }
+#endif
+    return SCALAR_KERNELS;
+}
+
+inline size_t MinSize(size_t a, size_t b) { return a < b ? a : b; }
+
+} // namespace
+
+ISA DetectISA() {
+#ifdef HELIX_X86_64
+    return HostHasAVX2() ? ISA::AVX2 : ISA::SSE2; // SSE2 is baseline on x86-64
+#else
+    return ISA::Scalar;
+#endif
+}
+
+ISA ActiveISA() {
+    return g_active;
+}
+
+void ForceISA(ISA isa) {
+    g_active = ((int)isa <= (int)g_detected) ? isa : g_detected;
+}
+
+const char* ISAName(ISA isa) {
+    switch (isa) {
+        case ISA::AVX2: return "AVX2";
+        case ISA::SSE2: return "SSE2";
+        default: return "Scalar";
+    }
+}
+
+void Consensus(TritSpan dst, TritSpan a, TritSpan b) {
+    Kernels().consensus(dst.pos, dst.neg, a.pos, a.neg, b.pos, b.neg, MinSize(dst.size, MinSize(a.size, b.size)));
+}
+
+void Decay(TritSpan dst, TritSpan a, TritSpan mask) {
+    Kernels().decay(dst.pos, dst.neg, a.pos, a.neg, mask.pos, mask.neg, MinSize(dst.size, MinSize(a.size, mask.size)));
+}
+
+void Min(TritSpan dst, TritSpan a, TritSpan b) {
+    Kernels().min(dst.pos, dst.neg, a.pos, a.neg, b.pos, b.neg, MinSize(dst.size, MinSize(a.size, b.size)));
+}
+
+void Max(TritSpan dst, TritSpan a, TritSpan b) {
+    Kernels().max(dst.pos, dst.neg, a.pos, a.neg, b.pos, b.neg, MinSize(dst.size, MinSize(a.size, b.size)));
+}
+
+void Negate(TritSpan dst, TritSpan a) {
+    // Plane swap: a plain copy, which the compiler vectorizes
+    size_t n = MinSize(dst.size, a.size);
+    if (dst.pos == a.pos) {
+        std::swap_ranges(dst.pos, dst.pos + n, dst.neg);
+        return;
+    }
+    std::copy(a.pos, a.pos + n, dst.neg);
+    std::copy(a.neg, a.neg + n, dst.pos);
+}
+
+int64_t PopCount(TritSpan a) {
+    return Kernels().popcount(a.pos, a.neg, nullptr, nullptr, a.size);
+}
+
+void Consensus(TernaryWord* dst, const TernaryWord* a, const TernaryWord* b, size_t n) {
+    Kernels().consensus_words(dst, a, b, n);
+}
+
+void Decay(TernaryWord* dst, const TernaryWord* a, const TernaryWord* mask, size_t n) {
+    Kernels().decay_words(dst, a, mask, n);
+}
+
+int64_t PopCount(const TernaryWord* a, size_t n) {
+    return Kernels().popcount_words(a, n);
+}
+
+int64_t HammingDistance(TritSpan a, TritSpan b) {
+    return Kernels().hamming(a.pos, a.neg, b.pos, b.neg, MinSize(a.size, b.size));
+}
+
+bool PackSingleTrit(TritSpan a, uint64_t* bp, uint64_t* bn) {
+    std::fill(bp, bp + BitplaneBlocks(a.size), 0);
+    std::fill(bn, bn + BitplaneBlocks(a.size), 0);
+    uint32_t seen = 0;
+    for (size_t i = 0; i < a.size; ++i) {
+        seen |= a.pos[i] | a.neg[i];
+        bp[i / 64] |= (uint64_t)(a.pos[i] & 1) << (i % 64);
+        bn[i / 64] |= (uint64_t)(a.neg[i] & 1) << (i % 64);
+    }
+    return (seen & HIGH_TRITS) == 0;
+}
+
+bool PackSingleTrit(const TernaryWord* words, size_t n, uint64_t* bp, uint64_t* bn) {
+    return Kernels().pack_words(words, n, bp, bn);
+}
+
+int64_t BitplaneDot(const uint64_t* ap, const uint64_t* an, const uint64_t* bp, const uint64_t* bn, size_t blocks) {
+    return Kernels().bitplane_dot(ap, an, bp, bn, blocks);
+}
+
+} // namespace TritKernels
@@ -0,0 +1,110 @@
+#pragma once
+#include "trit_word.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <new>
+
+// Bulk Trit Arrays (SoA)
+// A sequence of 27-trit words stored as two contiguous planes: pos[i] and neg[i]
+// hold the planes of word i. Page-wide cognitive ops run as bulk kernels over
+// these planes (SSE2/AVX2 with runtime dispatch, scalar fallback).
+
+// 64-byte aligned allocator so planes start on a cache line / AVX boundary
+template <typename T, size_t Align = 64>
+struct AlignedAllocator {
+    using value_type = T;
+    template <typename U> struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() = default;
+    template <typename U> AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+    }
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, std::align_val_t(Align));
+    }
+
+    template <typename U> bool operator==(const AlignedAllocator<U, Align>&) const { return true; }
+    template <typename U> bool operator!=(const AlignedAllocator<U, Align>&) const { return false; }
+};
+
+using TritPlane = std::vector<uint32_t, AlignedAllocator<uint32_t>>;
+
+// Non-owning view over two planes
+struct TritSpan {
+    uint32_t* pos;
+    uint32_t* neg;
+    size_t size;
+
+    TritSpan() : pos(nullptr), neg(nullptr), size(0) {}
+    TritSpan(uint32_t* p, uint32_t* n, size_t len) : pos(p), neg(n), size(len) {}
+
+    TritSpan Sub(size_t offset, size_t len) const { return TritSpan(pos + offset, neg + offset, len); }
+    TernaryWord Get(size_t i) const { return TernaryWord(pos[i], neg[i]); }
+    void Set(size_t i, const TernaryWord& w) { pos[i] = w.pos; neg[i] = w.neg; }
+};
+
+// Owning SoA array
+class TritArray {
+public:
+    TritPlane pos;
+    TritPlane neg;
+
+    TritArray() {}
+    explicit TritArray(size_t n) : pos(n, 0), neg(n, 0) {}
+
+    size_t Size() const { return pos.size(); }
+    void Resize(size_t n) { pos.resize(n, 0); neg.resize(n, 0); }
+    TritSpan Span() { return TritSpan(pos.data(), neg.data(), pos.size()); }
+
+    TernaryWord Get(size_t i) const { return TernaryWord(pos[i], neg[i]); }
+    void Set(size_t i, const TernaryWord& w) { pos[i] = w.pos; neg[i] = w.neg; }
+
+    // Conversion from/to interleaved TernaryWord storage (Page::words etc.)
+    void Load(const TernaryWord* words, size_t n);
+    void Store(TernaryWord* words) const;
+};
+
+namespace TritKernels {
+
+    enum class ISA { Scalar, SSE2, AVX2 };
+
+    // Best ISA supported by the host CPU, the one currently dispatched, and
+    // an override (clamped to what the host supports) for testing/benchmarks.
+    ISA DetectISA();
+    ISA ActiveISA();
+    void ForceISA(ISA isa);
+    const char* ISAName(ISA isa);
+
+    // Element-wise kernels. Each processes min(size) words; dst may alias a source.
+    void Consensus(TritSpan dst, TritSpan a, TritSpan b); // A=B->A, 0 with X, else 0
+    void Decay(TritSpan dst, TritSpan a, TritSpan mask);  // Intersect with mask
+    void Min(TritSpan dst, TritSpan a, TritSpan b);       // Kleene AND
+    void Max(TritSpan dst, TritSpan a, TritSpan b);       // Kleene OR
+    void Negate(TritSpan dst, TritSpan a);                // Swap planes
+
+    // Reductions
+    int64_t PopCount(TritSpan a);                        // Non-zero trits (27 per word)
+    int64_t HammingDistance(TritSpan a, TritSpan b);     // Trit positions that differ
+
+    // The same on interleaved TernaryWord storage (Page::words), no conversion
+    // to planes; dst may alias a source
+    void Consensus(TernaryWord* dst, const TernaryWord* a, const TernaryWord* b, size_t n);
+    void Decay(TernaryWord* dst, const TernaryWord* a, const TernaryWord* mask, size_t n);
+    int64_t PopCount(const TernaryWord* a, size_t n);
+
+    // Single-trit bitplanes
+    // A vector of -1/0/+1 words (nothing set above trit 0) packs into two bit
+    // planes of 64 lanes per uint64, and a dot product becomes four popcounts:
+    //   a.b = |a+ & b+| + |a- & b-| - |a+ & b-| - |a- & b+|
+    // Exact for a non-canonical (1,1) trit as well, which counts as 0 like ToInt64.
+    // Packing fills BitplaneBlocks(n) uint64 per plane, lanes past n zeroed, and
+    // returns false (planes unspecified) if any word is not single-trit.
+    inline size_t BitplaneBlocks(size_t n) { return (n + 63) / 64; }
+    bool PackSingleTrit(TritSpan a, uint64_t* bp, uint64_t* bn);
+    bool PackSingleTrit(const TernaryWord* words, size_t n, uint64_t* bp, uint64_t* bn);
+    int64_t BitplaneDot(const uint64_t* ap, const uint64_t* an, const uint64_t* bp, const uint64_t* bn, size_t blocks);
+
+}
@@ -3,119 +3,136 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <array>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
-// Constants for 27 trits
-const int NUM_TRITS = 27;
+using TritDetail::TritMask;
+using TritDetail::SumMod3;
+using TritDetail::CleanNeg;
+using TritDetail::AddPlanesSettle;
 
-TernaryWord TernaryWord::FromInt64(int64_t value) {
-    uint64_t p = 0;
-    uint64_t n = 0;
-    
-    // Balanced Ternary Conversion
-    // Algorithm: Repeatedly divide by 3. 
-    // Remainder 0 -> 0
-    // Remainder 1 -> +1
-    // Remainder 2 -> -1 (logic: 2 is congruent to -1 mod 3. We treat it as -1 and add 1 to the quotient to carry over)
-    
-    int64_t current = value;
-    for (int i = 0; i < NUM_TRITS; ++i) {
-        if (current == 0) break;
-
-        int rem = current % 3;
-        // Fix remainder for negative inputs in C++ (%)
-        if (rem < 0) rem += 3;
+// --- Conversion Tables ---
+//
+// Words are converted in 9-trit chunks. Binary -> ternary splits the value
+// into base-3^9 digits and looks up each chunk's planes; ternary -> binary
+// sums one weight lookup per 9-bit plane slice.
 
-        // Balanced ternary adjustment
-        if (rem == 0) {
-            // 0: Do nothing
-            current /= 3;
-        } 
-        else if (rem == 1) {
-            // +1: Set P bit
-            p |= (1ULL << i);
-            current = (current - 1) / 3;
-        } 
-        else if (rem == 2) {
-            // -1: Set N bit
-            n |= (1ULL << i);
-            current = (current + 1) / 3;
+namespace {
+
+const int CHUNK_TRITS = 9;
+const uint64_t CHUNK_MASK = (1ULL << CHUNK_TRITS) - 1;
+const int64_t POW3_9 = 19683;                    // 3^9
+const int64_t POW3_18 = POW3_9 * POW3_9;         // 3^18
+const int64_t POW3_27 = POW3_18 * POW3_9;        // 3^27
+
+// Weight of a 9-bit plane slice: sum of 3^i over its set bits.
+struct PlaneWeightTable {
+    std::array<int32_t, 1 << CHUNK_TRITS> weight{};
+    constexpr PlaneWeightTable() {
+        for (int bits = 0; bits < (1 << CHUNK_TRITS); ++bits) {
+            int32_t w = 0, p3 = 1;
+            for (int i = 0; i < CHUNK_TRITS; ++i) {
+                if (bits & (1 << i)) w += p3;
+                p3 *= 3;
+            }
+            weight[bits] = w;
         }
-        
-        // Handling the carry case for "2" effectively turns it into a -1 and adds 1 to upper.
-        // My logic above: (current - rem)/3 for rem=1; (current - (-1))/3 for rem=-1?
-        // Let's stick to standard logic:
-        // rem=2 => digit=-1, carry=+1 to next pos.
-        // current = (current - (-1)) / 3 = (current+1)/3. Correct.
     }
-    return TernaryWord(p, n);
-}
+};
 
-int64_t TernaryWord::ToInt64() const {
-    int64_t result = 0;
-    int64_t powerOf3 = 1;
-    for (int i = 0; i < NUM_TRITS; ++i) {
-        bool is_p = (pos >> i) & 1;
-        bool is_n = (neg >> i) & 1;
-
-        if (is_p) result += powerOf3;
-        if (is_n) result -= powerOf3;
-        
-        powerOf3 *= 3;
+// Planes of an unbalanced 9-digit chunk u in [0, 3^9): digit 0 -> -1, 1 -> 0, 2 -> +1.
+// Packed as pos | (neg << 16).
+struct ChunkPlaneTable {
+    std::array<uint32_t, POW3_9> planes{};
+    constexpr ChunkPlaneTable() {
+        for (int32_t u = 0; u < POW3_9; ++u) {
+            uint32_t p = 0, n = 0;
+            int32_t rest = u;
+            for (int i = 0; i < CHUNK_TRITS; ++i) {
+                int32_t digit = rest % 3;
+                if (digit == 2) p |= (1u << i);
+                else if (digit == 0) n |= (1u << i);
+                rest /= 3;
+            }
+            planes[u] = p | (n << 16);
+        }
     }
-    return result;
-}
+};
 
-// Kleene Logic
-TernaryWord TernaryWord::Min(const TernaryWord& other) const {
-    // MIN (AND): Result is MIN of inputs.
-    // +1, +1 -> +1
-    // +1, 0 -> 0
-    // +1, -1 -> -1
-    
-    // Logic from research:
-    // P = A.p & B.p
-    // N = A.n | B.n
-    return TernaryWord(pos & other.pos, neg | other.neg);
+constexpr PlaneWeightTable PLANE_WEIGHT;
+constexpr ChunkPlaneTable CHUNK_PLANES;
+
+// Value of the 9 trits starting at 'shift'
+inline int64_t ChunkValue(uint64_t pos, uint64_t neg, int shift) {
+    return (int64_t)PLANE_WEIGHT.weight[(pos >> shift) & CHUNK_MASK]
+         - (int64_t)PLANE_WEIGHT.weight[(neg >> shift) & CHUNK_MASK];
 }
 
-TernaryWord TernaryWord::Max(const TernaryWord& other) const {
-    // MAX (OR): Result is MAX of inputs.
-    // Logic from research:
-    // P = A.p | B.p
-    // N = A.n & B.n
-    return TernaryWord(pos | other.pos, neg & other.neg);
+} // namespace
+
+namespace TritDetail {
+
+int64_t PlanesValue(uint64_t pos, uint64_t neg, int trits) {
+    // Common decode fields (<= 9 trits) need a single lookup per plane
+    int64_t val = ChunkValue(pos, neg, 0);
+    if (trits <= 9) return val;
+    val += ChunkValue(pos, neg, 9) * POW3_9;
+    if (trits <= 18) return val;
+    val += ChunkValue(pos, neg, 18) * POW3_18;
+    if (trits <= 27) return val;
+    return val + ChunkValue(pos, neg, 27) * POW3_27;
 }
 
-TernaryWord TernaryWord::Negate() const {
-    // Invert sign: Swap P and N
-    return TernaryWord(neg, pos);
+template <int N>
+void Int64ToPlanes(int64_t value, uint64_t& pos, uint64_t& neg) {
+    const int64_t pow3_n = Pow3(N);
+    const int64_t offset = (pow3_n - 1) / 2; // Balanced -> unbalanced bias (all +1s)
+
+    // Keep the low N balanced digits (v mod 3^N), matching the reference loop
+    int64_t r = value % pow3_n;
+    if (r < 0) r += pow3_n;
+    int64_t u = r + offset;
+    if (u >= pow3_n) u -= pow3_n;
+
+    // Digits above N in the top chunk are unbalanced 0s (-1 trits): masked off
+    uint64_t p = 0, n = 0;
+    for (int c = 0; c * CHUNK_TRITS < N; ++c) {
+        uint32_t planes = CHUNK_PLANES.planes[u % POW3_9];
+        u /= POW3_9;
+        p |= (uint64_t)(planes & 0xFFFF) << (c * CHUNK_TRITS);
+        n |= (uint64_t)(planes >> 16) << (c * CHUNK_TRITS);
+    }
+    pos = p & TritMask(N);
+    neg = n & TritMask(N);
 }
 
-TernaryWord TernaryWord::Add(const TernaryWord& other) const {
-    // For PoC, we implement a Ripple Carry Adder over the bits.
-    // Parallel SIMD logic is possible but complex to implement correctly in one go.
-    // We strictly use the ALU logic gate derivation per trit.
-    
+} // namespace TritDetail
+
+// Reference: Ripple Carry Adder, one trit at a time.
+template <int N>
+BalancedTernary<N, false> BalancedTernary<N, false>::AddRipple(const BalancedTernary& other, int8_t& carry_out) const {
     uint64_t res_p = 0;
     uint64_t res_n = 0;
-    
+
     // Carry Trits (Initially 0)
     int c_val = 0; // -1, 0, or 1
-    
-    for (int i = 0; i < NUM_TRITS; ++i) {
+
+    for (int i = 0; i < N; ++i) {
         // Extract A and B trits
         int a = ((pos >> i) & 1) - ((neg >> i) & 1);
         int b = ((other.pos >> i) & 1) - ((other.neg >> i) & 1);
-        
+
         int sum = a + b + c_val;
-        
+
         // Balanced Ternary Sum Normalization
         // Sum can range from -3 to +3 (since A,B,C are in [-1,1])
         // We want output digit in [-1,1] and new carry
-        
+
         int digit = 0;
         int new_c = 0;
-        
+
         if (sum > 1) {
             digit = sum - 3;
             new_c = 1;
@@ -126,43 +143,115 @@ TernaryWord TernaryWord::Add(const TernaryWord& other) const {
             digit = sum;
             new_c = 0;
         }
-        
+
         c_val = new_c;
-        
+
         // Store digit
         if (digit == 1) res_p |= (1ULL << i);
         if (digit == -1) res_n |= (1ULL << i);
     }
-    
-    return TernaryWord(res_p, res_n);
+
+    carry_out = (int8_t)c_val;
+    return BalancedTernary(res_p, res_n);
 }
 
-int8_t TernaryWord::GetTrit(int index) const {
-    if (index < 0 || index >= NUM_TRITS) return 0;
-    bool p = (pos >> index) & 1;
-    bool n = (neg >> index) & 1;
-    if (p) return 1;
-    if (n) return -1;
-    return 0;
+// --- Multiply / Divide ---
+//
+// The bitplane forms (MultiplyPlanes in trit_word.h, DivModPlanes here) run in
+// a 64-trit wide accumulator, so the full 2N-trit product and every shifted
+// divisor fit without overflow.
+
+namespace {
+
+inline int HighestBit(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanReverse64(&idx, x);
+    return (int)idx;
+#else
+    return 63 - __builtin_clzll(x);
+#endif
+}
+
+// Sign of normalized planes: the most significant non-zero trit decides.
+inline int PlaneSign(uint64_t p, uint64_t n) {
+    if ((p | n) == 0) return 0;
+    return ((p >> HighestBit(p | n)) & 1) ? 1 : -1;
 }
 
-void TernaryWord::SetTrit(int index, int8_t value) {
-    if (index < 0 || index >= NUM_TRITS) return;
-    
-    // Clear existing
-    pos &= ~(1ULL << index);
-    neg &= ~(1ULL << index);
-    
-    // Set new
-    if (value == 1) pos |= (1ULL << index);
-    else if (value == -1) neg |= (1ULL << index);
+// Balanced ternary comparison is lexicographic from the top trit: lower
+// trits can never outweigh a difference at a higher position.
+inline bool PlanesLess(uint64_t xp, uint64_t xn, uint64_t yp, uint64_t yn) {
+    uint64_t gt = (xp & ~yp) | (yn & ~xn); // x_k > y_k
+    uint64_t lt = (yp & ~xp) | (xn & ~yn); // x_k < y_k
+    if (lt == 0) return false;
+    if (gt == 0) return true;
+    return HighestBit(lt) > HighestBit(gt);
+}
+
+} // namespace
+
+// Restoring long division on magnitudes with ternary digits {0, 1, 2}: at each
+// position the remainder is compared (lexicographically, no subtraction) with
+// 2D and D, and at most one subtraction is made. Signs follow C++ truncation.
+template <int N>
+bool BalancedTernary<N, false>::DivModPlanes(const BalancedTernary& divisor, BalancedTernary& quotient, BalancedTernary& remainder) const {
+    uint64_t ap = pos & ~neg & TRIT_MASK;
+    uint64_t an = neg & ~pos & TRIT_MASK;
+    uint64_t bp = divisor.pos & ~divisor.neg & TRIT_MASK;
+    uint64_t bn = divisor.neg & ~divisor.pos & TRIT_MASK;
+
+    int sign_b = PlaneSign(bp, bn);
+    if (sign_b == 0) return false;
+    int sign_a = PlaneSign(ap, an);
+
+    // Magnitudes (negation is a plane swap)
+    if (sign_a < 0) std::swap(ap, an);
+    if (sign_b < 0) std::swap(bp, bn);
+
+    uint64_t q1 = 0, q2 = 0; // Digit 1 / digit 2 positions
+    uint64_t rp = ap, rn = an;
+    if (sign_a != 0) {
+        uint64_t b2p, b2n;
+        AddPlanesSettle(bp, bn, bp, bn, b2p, b2n);
+
+        // Start where 3 * (|b| << i) first exceeds |a|
+        int top = HighestBit(ap | an) - HighestBit(bp | bn);
+        for (int i = top < 0 ? 0 : top; i >= 0; --i) {
+            uint64_t dp, dn;
+            if (!PlanesLess(rp, rn, b2p << i, b2n << i)) {
+                dp = b2p << i; dn = b2n << i;
+                q2 |= 1ULL << i;
+            } else if (!PlanesLess(rp, rn, bp << i, bn << i)) {
+                dp = bp << i; dn = bn << i;
+                q1 |= 1ULL << i;
+            } else {
+                continue;
+            }
+            AddPlanesSettle(rp, rn, dn, dp, rp, rn); // r -= d
+        }
+    }
+
+    // q = q1 + 2*q2 = q1 + 3*q2 - q2; the last two terms only cancel, never carry
+    uint64_t tp = (q2 << 1) & ~q2;
+    uint64_t tn = q2 & ~(q2 << 1);
+    uint64_t qp, qn;
+    AddPlanesSettle(q1, 0, tp & TRIT_MASK, tn, qp, qn);
+
+    if (sign_a * sign_b < 0) std::swap(qp, qn);
+    if (sign_a < 0) std::swap(rp, rn);
+    quotient = BalancedTernary(qp & TRIT_MASK, qn & TRIT_MASK);
+    remainder = BalancedTernary(rp & TRIT_MASK, rn & TRIT_MASK);
+    return true;
 }
 
-int64_t TernaryWord::Slice(int start, int len) const {
+// Reference: per-trit extract through GetTrit
+template <int N>
+int64_t BalancedTernary<N, false>::SliceReference(int start, int len) const {
     int64_t val = 0;
     int64_t power = 1;
     for (int i = 0; i < len; ++i) {
-        if (start + i < 27) {
+        if (start + i < N) {
             val += GetTrit(start + i) * power;
             power *= 3;
         }
@@ -170,17 +259,19 @@ int64_t TernaryWord::Slice(int start, int len) const {
     return val;
 }
 
-void TernaryWord::SetSlice(int start, int len, int64_t val) {
+// Reference: per-trit insert through SetTrit
+template <int N>
+void BalancedTernary<N, false>::SetSliceReference(int start, int len, int64_t val) {
     int64_t remainder = val;
     for (int i = 0; i < len; ++i) {
-        if (start + i >= NUM_TRITS) break;
-        
+        if (start + i >= N) break;
+
         int rem = remainder % 3;
         // Fix remainder for negative inputs
         if (rem < 0) rem += 3;
-        
+
         int8_t t = 0;
-        
+
         if (rem == 0) {
             t = 0;
             remainder /= 3;
@@ -189,16 +280,17 @@ void TernaryWord::SetSlice(int start, int len, int64_t val) {
             remainder = (remainder - 1) / 3;
         } else if (rem == 2) {
             t = -1;
-            remainder = (remainder + 1) / 3; 
+            remainder = (remainder + 1) / 3;
         }
-        
+
         SetTrit(start + i, t);
     }
 }
 
-std::string TernaryWord::ToString() const {
+template <int N>
+std::string BalancedTernary<N, false>::ToString() const {
     std::string s = "";
-    for (int i = NUM_TRITS - 1; i >= 0; --i) {
+    for (int i = N - 1; i >= 0; --i) {
         bool p = (pos >> i) & 1;
         bool n = (neg >> i) & 1;
         if (p) s += "+";
@@ -208,151 +300,263 @@ std::string TernaryWord::ToString() const {
     return s + " (" + std::to_string(ToInt64()) + ")";
 }
 
-// Logic: Consensus / Sum Mod 3
-TernaryWord TernaryWord::XOR(const TernaryWord& other) const {
-    TernaryWord result;
-    for (int i = 0; i < NUM_TRITS; ++i) {
-        int a = GetTrit(i);
-        int b = other.GetTrit(i);
-        
-        // Balanced Ternary Sum Mod 3 (Consensus)
-        int sum = a + b;
-        if (sum > 1) { // 2 -> -1
-             sum = -1;
-        } else if (sum < -1) { // -2 -> 1
-             sum = 1;
+// --- Encoding Standard ---
+//
+// Pack N trits into 2N bits (2 bits per trit): 00=0, 01=+1, 10=-1, 11 reserved.
+// The codes interleave the planes (pos -> even bits, neg -> odd bits), which
+// is a single PDEP/PEXT per plane on BMI2 hosts. Otherwise a branch-free
+// Morton spread/compact does the same job. The backend is picked once at startup.
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define HELIX_HAS_BMI2_PATH 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define HELIX_TARGET_BMI2
+#else
+#define HELIX_TARGET_BMI2 __attribute__((target("bmi2")))
+#endif
+#endif
+
+namespace {
+
+// Even bits of the 2N-bit code
+constexpr uint64_t EvenBits(int trits) {
+    return 0x5555555555555555ULL & TritMask(2 * trits);
+}
+
+// Bit i -> bit 2i (low 32 bits)
+inline uint64_t SpreadBits(uint64_t x) {
+    x &= 0xFFFFFFFFULL;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8))  & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2))  & 0x3333333333333333ULL;
+    x = (x | (x << 1))  & 0x5555555555555555ULL;
+    return x;
+}
+
+// Bit 2i -> bit i (inverse of SpreadBits)
+inline uint64_t CompactBits(uint64_t x) {
+    x &= 0x5555555555555555ULL;
+    x = (x | (x >> 1))  & 0x3333333333333333ULL;
+    x = (x | (x >> 2))  & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x >> 4))  & 0x00FF00FF00FF00FFULL;
+    x = (x | (x >> 8))  & 0x0000FFFF0000FFFFULL;
+    x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+    return x;
+}
+
+// (1,1) trits pack as +1, matching GetTrit
+template <int N>
+inline uint64_t PackPortable(uint64_t p, uint64_t n) {
+    p &= TritMask(N);
+    n = CleanNeg(p, n) & TritMask(N);
+    return SpreadBits(p) | (SpreadBits(n) << 1);
+}
+
+// Reserved code 11 decodes to 0
+template <int N>
+inline void UnpackPortable(uint64_t val, uint64_t& p, uint64_t& n) {
+    uint64_t lo = CompactBits(val & EvenBits(N));
+    uint64_t hi = CompactBits((val >> 1) & EvenBits(N));
+    p = lo & ~hi;
+    n = hi & ~lo;
+}
+
+#ifdef HELIX_HAS_BMI2_PATH
+template <int N>
+HELIX_TARGET_BMI2 inline uint64_t PackBMI2(uint64_t p, uint64_t n) {
+    p &= TritMask(N);
+    n = CleanNeg(p, n) & TritMask(N);
+    return _pdep_u64(p, EvenBits(N)) | _pdep_u64(n, EvenBits(N) << 1);
+}
+
+template <int N>
+HELIX_TARGET_BMI2 inline void UnpackBMI2(uint64_t val, uint64_t& p, uint64_t& n) {
+    uint64_t lo = _pext_u64(val, EvenBits(N));
+    uint64_t hi = _pext_u64(val, EvenBits(N) << 1);
+    p = lo & ~hi;
+    n = hi & ~lo;
+}
+
+bool HostHasBMI2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 8)) != 0;
+#else
+    return __builtin_cpu_supports("bmi2");
+#endif
+}
+#else
+bool HostHasBMI2() { return false; }
+#endif
+
+const bool g_host_bmi2 = HostHasBMI2();
+bool g_packed_bmi2 = g_host_bmi2;
+
+// Byte-order independent little-endian stores/loads
+inline void StoreLE(uint8_t* out, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out[i] = (uint8_t)(v >> (8 * i));
+}
+
+inline uint64_t LoadLE(const uint8_t* in, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= (uint64_t)in[i] << (8 * i);
+    return v;
+}
+
+// x >> s, with s == 64 giving 0
+inline uint64_t ShiftOut(uint64_t x, int s) {
+    return s >= 64 ? 0 : x >> s;
+}
+
+template <int N, bool BMI2>
+void PackStreamImpl(const BalancedTernary<N>* words, size_t count, uint8_t* out) {
+    const int code_bits = 2 * N;
+    uint64_t acc = 0;
+    int bits = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t code;
+#ifdef HELIX_HAS_BMI2_PATH
+        if (BMI2) code = PackBMI2<N>(words[i].pos, words[i].neg);
+        else
+#endif
+        code = PackPortable<N>(words[i].pos, words[i].neg);
+
+        acc |= code << bits;
+        if (bits + code_bits >= 64) {
+            StoreLE(out, acc, 8);
+            out += 8;
+            acc = ShiftOut(code, 64 - bits);
+            bits += code_bits - 64;
+        } else {
+            bits += code_bits;
         }
-        
-        result.SetTrit(i, sum);
     }
-    return result;
+    StoreLE(out, acc, (bits + 7) / 8);
 }
 
-// Logic: Shift Left (Zero fill)
-TernaryWord TernaryWord::ShiftLeft() const {
-    TernaryWord result;
-    // T[i] = T[i-1], T[0] = 0
-    for (int i = 1; i < NUM_TRITS; ++i) {
-        result.SetTrit(i, GetTrit(i - 1));
+template <int N, bool BMI2>
+void UnpackStreamImpl(const uint8_t* in, size_t count, BalancedTernary<N>* words) {
+    const int code_bits = 2 * N;
+    uint64_t acc = 0;
+    int bits = 0;
+    size_t remaining = BalancedTernary<N>::PackedStreamBytes(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t code = acc;
+        if (bits < code_bits) {
+            // Refill: take the next (up to) 8 bytes
+            int take = remaining < 8 ? (int)remaining : 8;
+            uint64_t next = LoadLE(in, take);
+            in += take;
+            remaining -= take;
+            code = acc | (next << bits);
+            acc = ShiftOut(next, code_bits - bits);
+            bits += 64 - code_bits;
+        } else {
+            acc = ShiftOut(acc, code_bits);
+            bits -= code_bits;
+        }
+        code &= TritMask(code_bits);
+
+        uint64_t p, n;
+#ifdef HELIX_HAS_BMI2_PATH
+        if (BMI2) UnpackBMI2<N>(code, p, n);
+        else
+#endif
+        UnpackPortable<N>(code, p, n);
+        words[i] = BalancedTernary<N>(p, n);
     }
-    result.SetTrit(0, 0);
-    return result;
 }
 
-// Logic: Shift Right (Zero fill)
-TernaryWord TernaryWord::ShiftRight() const {
-    TernaryWord result;
-    // T[i] = T[i+1], T[26] = 0
-    for (int i = 0; i < NUM_TRITS - 1; ++i) {
-        result.SetTrit(i, GetTrit(i + 1));
-    }
-    result.SetTrit(NUM_TRITS - 1, 0);
-    return result;
-}
-
-// --- Cognitive Operations (Phase 6) ---
-
-// Consensus: A=B -> A, else 0
-// Bitwise AND of Pos and Neg masks handles this natively in balanced ternary.
-// (+1, +1) -> +1 (pos&pos, neg&neg = 1,0)
-// (-1, -1) -> -1 (pos&pos, neg&neg = 0,1)
-// (+1, -1) -> 0  (pos&pos, neg&neg = 0,0)
-// (0, X)   -> 0 
-// Consensus with Learning:
-// If A=0, B=X -> X
-// If A=X, B=0 -> X
-// If A=B -> A
-// If A!=B -> 0 (Conflict)
-TernaryWord TernaryWord::Consensus(const TernaryWord& other) const {
-    // P_out = (P1 & ~N2) | (P2 & ~N1)
-    // N_out = (N1 & ~P2) | (N2 & ~P1)
-    
-    uint64_t p = (pos & ~other.neg) | (other.pos & ~neg);
-    uint64_t n = (neg & ~other.pos) | (other.neg & ~pos);
-    
-    return TernaryWord(p, n);
-}
-
-// Decay: Masking
-// Apply mask to current state.
-TernaryWord TernaryWord::Decay(const TernaryWord& mask) const {
-    return TernaryWord(pos & mask.pos, neg & mask.neg);
-}
-
-// PopCount: Count non-zero trits
-// Non-zero if either POS bit or NEG bit is set. (Valid trits are mutually exclusive).
-#include <bitset>
-int TernaryWord::PopCount() const {
-    // Combine pos and neg to find all non-zero positions
-    uint64_t non_zero = pos | neg;
-    // Mask to just 27 trits to be safe (though upper bits should be 0)
-    non_zero &= ((1ULL << NUM_TRITS) - 1);
-    return std::bitset<64>(non_zero).count();
-}
-
-// Saturating Add: Add with Clamp on Overflow
-TernaryWord TernaryWord::SaturatingAdd(const TernaryWord& other) const {
-    uint64_t res_p = 0;
-    uint64_t res_n = 0;
-    int c_val = 0;
-    
-    for (int i = 0; i < NUM_TRITS; ++i) {
-        int a = ((pos >> i) & 1) - ((neg >> i) & 1);
-        int b = ((other.pos >> i) & 1) - ((other.neg >> i) & 1);
-        int sum = a + b + c_val;
-        
-        int digit = 0;
-        int new_c = 0;
-        
-        if (sum > 1) { digit = sum - 3; new_c = 1; }
-        else if (sum < -1) { digit = sum + 3; new_c = -1; }
-        else { digit = sum; new_c = 0; }
-        
-        c_val = new_c;
-        if (digit == 1) res_p |= (1ULL << i);
-        if (digit == -1) res_n |= (1ULL << i);
-    }
-    
-    // Check Overflow
-    if (c_val == 1) {
-        // Overflow Max: Return all +1s
-        return TernaryWord((1ULL << NUM_TRITS) - 1, 0);
-    } else if (c_val == -1) {
-        // Underflow Min: Return all -1s
-        return TernaryWord(0, (1ULL << NUM_TRITS) - 1);
+} // namespace
+
+template <int N>
+uint64_t BalancedTernary<N, false>::ToPacked() const {
+#ifdef HELIX_HAS_BMI2_PATH
+    if (g_packed_bmi2) return PackBMI2<N>(pos, neg);
+#endif
+    return PackPortable<N>(pos, neg);
+}
+
+template <int N>
+BalancedTernary<N, false> BalancedTernary<N, false>::FromPacked(uint64_t val) {
+    uint64_t p, n;
+#ifdef HELIX_HAS_BMI2_PATH
+    if (g_packed_bmi2) {
+        UnpackBMI2<N>(val, p, n);
+        return BalancedTernary(p, n);
     }
-    
-    return TernaryWord(res_p, res_n);
+#endif
+    UnpackPortable<N>(val, p, n);
+    return BalancedTernary(p, n);
 }
 
-// --- Encoding Standard ---
+template <int N>
+bool BalancedTernary<N, false>::PackedUsesBMI2() {
+    return g_packed_bmi2;
+}
+
+template <int N>
+void BalancedTernary<N, false>::SetPackedBMI2(bool enable) {
+    g_packed_bmi2 = enable && g_host_bmi2;
+}
+
+template <int N>
+void BalancedTernary<N, false>::PackStream(const BalancedTernary* words, size_t count, uint8_t* out) {
+    if (g_packed_bmi2) PackStreamImpl<N, true>(words, count, out);
+    else PackStreamImpl<N, false>(words, count, out);
+}
 
-// Pack 27 trits into 54 bits (2 bits per trit)
-// 00=0, 01=+1, 10=-1
-uint64_t TernaryWord::ToPacked() const {
+template <int N>
+void BalancedTernary<N, false>::UnpackStream(const uint8_t* in, size_t count, BalancedTernary* words) {
+    if (g_packed_bmi2) UnpackStreamImpl<N, true>(in, count, words);
+    else UnpackStreamImpl<N, false>(in, count, words);
+}
+
+// Reference: per-trit loop
+template <int N>
+uint64_t BalancedTernary<N, false>::ToPackedReference() const {
     uint64_t packed = 0;
-    for (int i = 0; i < NUM_TRITS; ++i) {
+    for (int i = 0; i < N; ++i) {
         bool p = (pos >> i) & 1;
         bool n = (neg >> i) & 1;
         uint64_t code = 0;
         if (p) code = 1;      // 01
         else if (n) code = 2; // 10
         // else 00
-        
+
         packed |= (code << (2 * i));
     }
     return packed;
 }
 
-// Unpack
-TernaryWord TernaryWord::FromPacked(uint64_t val) {
+// Reference: per-trit loop
+template <int N>
+BalancedTernary<N, false> BalancedTernary<N, false>::FromPackedReference(uint64_t val) {
     uint64_t p = 0;
     uint64_t n = 0;
-    for (int i = 0; i < NUM_TRITS; ++i) {
+    for (int i = 0; i < N; ++i) {
         uint64_t code = (val >> (2 * i)) & 3; // Get 2 bits
         if (code == 1) p |= (1ULL << i);
         else if (code == 2) n |= (1ULL << i);
         // Ignore 3 (Reserved) and 0
     }
-    return TernaryWord(p, n);
+    return BalancedTernary(p, n);
 }
+
+// --- Instantiations (every single-limb width) ---
+
+#define HELIX_INSTANTIATE_TRITS(N) \
+    template class BalancedTernary<N>; \
+    template void TritDetail::Int64ToPlanes<N>(int64_t, uint64_t&, uint64_t&);
+
+HELIX_INSTANTIATE_TRITS(1)  HELIX_INSTANTIATE_TRITS(2)  HELIX_INSTANTIATE_TRITS(3)  HELIX_INSTANTIATE_TRITS(4)
+HELIX_INSTANTIATE_TRITS(5)  HELIX_INSTANTIATE_TRITS(6)  HELIX_INSTANTIATE_TRITS(7)  HELIX_INSTANTIATE_TRITS(8)
+HELIX_INSTANTIATE_TRITS(9)  HELIX_INSTANTIATE_TRITS(10) HELIX_INSTANTIATE_TRITS(11) HELIX_INSTANTIATE_TRITS(12)
+HELIX_INSTANTIATE_TRITS(13) HELIX_INSTANTIATE_TRITS(14) HELIX_INSTANTIATE_TRITS(15) HELIX_INSTANTIATE_TRITS(16)
+HELIX_INSTANTIATE_TRITS(17) HELIX_INSTANTIATE_TRITS(18) HELIX_INSTANTIATE_TRITS(19) HELIX_INSTANTIATE_TRITS(20)
+HELIX_INSTANTIATE_TRITS(21) HELIX_INSTANTIATE_TRITS(22) HELIX_INSTANTIATE_TRITS(23) HELIX_INSTANTIATE_TRITS(24)
+HELIX_INSTANTIATE_TRITS(25) HELIX_INSTANTIATE_TRITS(26) HELIX_INSTANTIATE_TRITS(27) HELIX_INSTANTIATE_TRITS(28)
+HELIX_INSTANTIATE_TRITS(29) HELIX_INSTANTIATE_TRITS(30) HELIX_INSTANTIATE_TRITS(31) HELIX_INSTANTIATE_TRITS(32)
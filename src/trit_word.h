@@ -1,53 +1,607 @@
 #pragma once
 #include <cstdint>
+#include <cstddef>
 #include <string>
 
-// Represents a 27-trit balanced ternary word using 2-bit biased encoding.
-class TernaryWord {
+// Balanced ternary words, generic over the trit count.
+//
+// BalancedTernary<N> (N <= 32) uses 2-bit biased encoding: two 32-bit planes,
+// pos and neg, one bit per trit (8 bytes). Construction, conversion, logic,
+// addition and Multiply/DivMod (int64 round trips; the bitplane multiply
+// only past int64) are constexpr, so encoders and tables can be built at
+// compile time. At run time the same calls take the table-driven
+// paths in trit_word.cpp. DivModPlanes, packing and the reference loops are
+// explicitly instantiated there for every N in 1..32.
+//
+// Wider words (N a multiple of 27, e.g. 81) are little-endian arrays of
+// 27-trit limbs.
+//
+// TernaryWord is the machine word: BalancedTernary<27>.
+
+// Lets constexpr members pick a loop when evaluated at compile time and the
+// lookup tables at run time. Without the builtin, always use the loops.
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define HELIX_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define HELIX_CONSTANT_EVALUATED() true
+#endif
+
+namespace TritDetail {
+
+    constexpr uint64_t TritMask(int trits) {
+        return trits >= 64 ? ~0ULL : (1ULL << trits) - 1;
+    }
+
+    constexpr int64_t Pow3(int n) {
+        int64_t p = 1;
+        for (int i = 0; i < n; ++i) p *= 3;
+        return p;
+    }
+
+    // Balanced Sum Mod 3 per trit (no carry)
+    constexpr void SumMod3(uint64_t ap, uint64_t an, uint64_t bp, uint64_t bn, uint64_t& out_p, uint64_t& out_n) {
+        uint64_t az = ~(ap | an);
+        uint64_t bz = ~(bp | bn);
+        out_p = (ap & bz) | (az & bp) | (an & bn);
+        out_n = (an & bz) | (az & bn) | (ap & bp);
+    }
+
+    // GetTrit/SetTrit semantics: a (1,1) trit reads as +1
+    constexpr uint64_t CleanNeg(uint64_t pos, uint64_t neg) {
+        return neg & ~pos;
+    }
+
+    constexpr int CountBits(uint64_t x) {
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return (int)((x * 0x0101010101010101ULL) >> 56);
+    }
+
+    // --- Word-Level Adder ---
+    //
+    // Each trit position maps an incoming carry (-1, 0, +1) to an outgoing carry.
+    // These maps compose associatively, so the carry into every position can be
+    // resolved with a Kogge-Stone parallel prefix over the pos/neg bitplanes
+    // (5 rounds for 27 trits) instead of an N-step ripple.
+
+    // Carry-out as a function of carry-in, one (pos, neg) plane pair per input value.
+    struct CarryMap {
+        uint64_t mp = 0, mn = 0; // carry-in = -1
+        uint64_t zp = 0, zn = 0; // carry-in =  0
+        uint64_t pp = 0, pn = 0; // carry-in = +1
+    };
+
+    // f(g): route each trit of g through the map f at the same position.
+    constexpr void ComposeCarry(uint64_t gp, uint64_t gn, const CarryMap& f, uint64_t& out_p, uint64_t& out_n) {
+        uint64_t gz = ~(gp | gn);
+        out_p = (gn & f.mp) | (gz & f.zp) | (gp & f.pp);
+        out_n = (gn & f.mn) | (gz & f.zn) | (gp & f.pn);
+    }
+
+    // Sum of two normalized WIDTH-trit plane pairs; carry_out receives the
+    // carry trit out of the MSB.
+    template <int WIDTH>
+    constexpr void AddPlanes(uint64_t ap, uint64_t an, uint64_t bp, uint64_t bn,
+                             uint64_t& out_p, uint64_t& out_n, int8_t& carry_out) {
+        const uint64_t mask = TritMask(WIDTH);
+
+        // Per-trit carry maps from s = a + b:
+        //   cin=-1: -1 if s <= -1        cin=0: sign if |s| = 2        cin=+1: +1 if s >= 1
+        CarryMap f;
+        f.mp = 0;
+        f.mn = (an & ~bp) | (bn & ~ap);
+        f.zp = ap & bp;
+        f.zn = an & bn;
+        f.pp = (ap & ~bn) | (bp & ~an);
+        f.pn = 0;
+
+        // Carry into trit 0 is 0: make its map constant
+        f.mp = (f.mp & ~1ULL) | (f.zp & 1ULL);
+        f.mn = (f.mn & ~1ULL) | (f.zn & 1ULL);
+        f.pp = (f.pp & ~1ULL) | (f.zp & 1ULL);
+        f.pn = (f.pn & ~1ULL) | (f.zn & 1ULL);
+
+        // Parallel prefix: after the round with distance d, each position holds the
+        // composed map of the 2d trits below and including it. Zero fill from below
+        // acts as a constant-0 map, which is only reached once a span is resolved.
+        for (int d = 1; d < WIDTH; d <<= 1) {
+            CarryMap c;
+            ComposeCarry(f.mp << d, f.mn << d, f, c.mp, c.mn);
+            ComposeCarry(f.zp << d, f.zn << d, f, c.zp, c.zn);
+            ComposeCarry(f.pp << d, f.pn << d, f, c.pp, c.pn);
+            f = c;
+        }
+
+        // All spans now start at trit 0, so every map is constant: read the cin=0 plane.
+        carry_out = (int8_t)(((f.zp >> (WIDTH - 1)) & 1) - ((f.zn >> (WIDTH - 1)) & 1));
+        uint64_t cp = (f.zp << 1) & mask;
+        uint64_t cn = (f.zn << 1) & mask;
+
+        uint64_t sp = 0, sn = 0;
+        SumMod3(ap, an, bp, bn, sp, sn);
+        SumMod3(sp, sn, cp, cn, out_p, out_n);
+        out_p &= mask;
+        out_n &= mask;
+    }
+
+    // --- Multiply Helpers (64-trit planes) ---
+
+    // Carry-save step: x + y + z = s + 3c per trit, with s, c in {-1, 0, +1}.
+    constexpr void CarrySave(uint64_t xp, uint64_t xn, uint64_t yp, uint64_t yn, uint64_t zp, uint64_t zn,
+                             uint64_t& sp, uint64_t& sn, uint64_t& cp, uint64_t& cn) {
+        uint64_t tp = 0, tn = 0;
+        SumMod3(xp, xn, yp, yn, tp, tn);
+        uint64_t c1p = xp & yp, c1n = xn & yn; // Half adder x + y
+        SumMod3(tp, tn, zp, zn, sp, sn);
+        uint64_t c2p = tp & zp, c2n = tn & zn; // Half adder t + z
+        // c1 and c2 never share a sign, so their sum is a single trit
+        cp = (c1p | c2p) & ~(c1n | c2n);
+        cn = (c1n | c2n) & ~(c1p | c2p);
+    }
+
+    // Resolve a + b by repeated half-adds: each pass moves every pending carry
+    // up one trit. Carries rarely chain, so this settles in a few passes and is
+    // cheaper than a 64-trit prefix network for the multiply/divide inner loops.
+    constexpr void AddPlanesSettle(uint64_t ap, uint64_t an, uint64_t bp, uint64_t bn, uint64_t& out_p, uint64_t& out_n) {
+        while (bp | bn) {
+            uint64_t sp = 0, sn = 0;
+            SumMod3(ap, an, bp, bn, sp, sn);
+            uint64_t cp = (ap & bp) << 1;
+            uint64_t cn = (an & bn) << 1;
+            ap = sp; an = sn;
+            bp = cp; bn = cn;
+        }
+        out_p = ap;
+        out_n = an;
+    }
+
+    // Run-time conversions (9-trit chunk tables, trit_word.cpp)
+    template <int N> void Int64ToPlanes(int64_t value, uint64_t& pos, uint64_t& neg);
+    int64_t PlanesValue(uint64_t pos, uint64_t neg, int trits); // Low 'trits' (<= 32) of clean planes
+
+}
+
+template <int N, bool MultiLimb = (N > 32)>
+class BalancedTernary;
+
+// Single-limb word (N <= 32)
+template <int N>
+class BalancedTernary<N, false> {
+    static_assert(N >= 1, "BalancedTernary needs at least one trit");
+
 public:
-    uint64_t pos; // Positive bits
-    uint64_t neg; // Negative bits
+    static constexpr int NUM_TRITS = N;
+    static constexpr uint64_t TRIT_MASK = TritDetail::TritMask(N);
+
+    uint32_t pos; // Positive bits
+    uint32_t neg; // Negative bits
+
+    constexpr BalancedTernary() : pos(0), neg(0) {}
+    constexpr BalancedTernary(uint64_t p, uint64_t n) : pos((uint32_t)p), neg((uint32_t)n) {}
 
-    TernaryWord() : pos(0), neg(0) {}
-    TernaryWord(uint64_t p, uint64_t n) : pos(p), neg(n) {}
-    
-    // Create from integer (for testing)
-    static TernaryWord FromInt64(int64_t value);
-    int64_t ToInt64() const;
+    // Create from integer (table-driven, 9-trit chunks). Values outside the
+    // N-trit range keep their low N balanced digits (v mod 3^N).
+    static constexpr BalancedTernary FromInt64(int64_t value) {
+        if (HELIX_CONSTANT_EVALUATED()) return FromInt64Reference(value);
+        uint64_t p = 0, n = 0;
+        TritDetail::Int64ToPlanes<N>(value, p, n);
+        return BalancedTernary(p, n);
+    }
+
+    // (1,1) trits read as 0 here (p - n), as in Add
+    constexpr int64_t ToInt64() const {
+        if (HELIX_CONSTANT_EVALUATED()) return ToInt64Reference();
+        return TritDetail::PlanesValue(pos & TRIT_MASK, neg & TRIT_MASK, N);
+    }
+
+    // Reference Conversions (per-trit loops, for differential testing)
+    static constexpr BalancedTernary FromInt64Reference(int64_t value) {
+        // Repeatedly divide by 3: remainder 1 -> +1, remainder 2 -> -1 with a
+        // carry of +1 into the quotient.
+        uint64_t p = 0;
+        uint64_t n = 0;
+        int64_t current = value;
+        for (int i = 0; i < N; ++i) {
+            if (current == 0) break;
+
+            int rem = (int)(current % 3);
+            if (rem < 0) rem += 3; // C++ % keeps the dividend's sign
+
+            if (rem == 0) {
+                current /= 3;
+            } else if (rem == 1) {
+                p |= (1ULL << i);
+                current = (current - 1) / 3;
+            } else {
+                n |= (1ULL << i);
+                current = (current + 1) / 3;
+            }
+        }
+        return BalancedTernary(p, n);
+    }
+
+    constexpr int64_t ToInt64Reference() const {
+        int64_t result = 0;
+        int64_t powerOf3 = 1;
+        for (int i = 0; i < N; ++i) {
+            if ((pos >> i) & 1) result += powerOf3;
+            if ((neg >> i) & 1) result -= powerOf3;
+            powerOf3 *= 3;
+        }
+        return result;
+    }
 
     // Logic Operations
-    TernaryWord Min(const TernaryWord& other) const;
-    TernaryWord Max(const TernaryWord& other) const;
-    TernaryWord Negate() const;
-    TernaryWord XOR(const TernaryWord& other) const; // Sum Mod 3
-    
-    TernaryWord ShiftLeft() const;  // LSL
-    TernaryWord ShiftRight() const; // LSR
+    // Kleene MIN (AND): P = A.p & B.p, N = A.n | B.n
+    constexpr BalancedTernary Min(const BalancedTernary& other) const {
+        return BalancedTernary(pos & other.pos, neg | other.neg);
+    }
+    // Kleene MAX (OR): P = A.p | B.p, N = A.n & B.n
+    constexpr BalancedTernary Max(const BalancedTernary& other) const {
+        return BalancedTernary(pos | other.pos, neg & other.neg);
+    }
+    // Invert sign: Swap P and N
+    constexpr BalancedTernary Negate() const {
+        return BalancedTernary(neg, pos);
+    }
+    // Sum Mod 3 (no carry), evaluated on whole bitplanes
+    constexpr BalancedTernary XOR(const BalancedTernary& other) const {
+        uint64_t p = 0, n = 0;
+        TritDetail::SumMod3(pos & TRIT_MASK, TritDetail::CleanNeg(pos, neg) & TRIT_MASK,
+                            other.pos & TRIT_MASK, TritDetail::CleanNeg(other.pos, other.neg) & TRIT_MASK, p, n);
+        return BalancedTernary(p & TRIT_MASK, n & TRIT_MASK);
+    }
+
+    // LSL (plane shift, zero fill, drops the top trit)
+    constexpr BalancedTernary ShiftLeft() const {
+        return BalancedTernary(((uint64_t)pos << 1) & TRIT_MASK, (TritDetail::CleanNeg(pos, neg) << 1) & TRIT_MASK);
+    }
+    // LSR (plane shift, zero fill)
+    constexpr BalancedTernary ShiftRight() const {
+        return BalancedTernary((pos & TRIT_MASK) >> 1, (TritDetail::CleanNeg(pos, neg) & TRIT_MASK) >> 1);
+    }
 
     // Arithmetic Operations
-    TernaryWord Add(const TernaryWord& other) const;
-    TernaryWord SaturatingAdd(const TernaryWord& other) const; // Cognitive Mode
+    // Word-level carry-lookahead adder. carry_out receives the carry trit out of
+    // the MSB (-1, 0, +1); in balanced ternary a non-zero carry means overflow.
+    constexpr BalancedTernary Add(const BalancedTernary& other) const {
+        int8_t carry = 0;
+        return Add(other, carry);
+    }
+    constexpr BalancedTernary Add(const BalancedTernary& other, int8_t& carry_out) const {
+        // Normalize: only the low N trits count, and (1,1) encodings read as 0
+        uint64_t ap = pos & ~neg & TRIT_MASK;
+        uint64_t an = neg & ~pos & TRIT_MASK;
+        uint64_t bp = other.pos & ~other.neg & TRIT_MASK;
+        uint64_t bn = other.neg & ~other.pos & TRIT_MASK;
+
+        uint64_t rp = 0, rn = 0;
+        TritDetail::AddPlanes<N>(ap, an, bp, bn, rp, rn, carry_out);
+        return BalancedTernary(rp, rn);
+    }
+
+    // Cognitive Mode: clamp to all +1s / all -1s on overflow
+    constexpr BalancedTernary SaturatingAdd(const BalancedTernary& other) const {
+        int8_t carry = 0;
+        return SaturatingAdd(other, carry);
+    }
+    constexpr BalancedTernary SaturatingAdd(const BalancedTernary& other, int8_t& carry_out) const {
+        BalancedTernary sum = Add(other, carry_out);
+
+        // Branch-free select
+        uint64_t sat_hi = 0ULL - (uint64_t)(carry_out == 1);
+        uint64_t sat_lo = 0ULL - (uint64_t)(carry_out == -1);
+        uint64_t keep = ~(sat_hi | sat_lo);
+
+        return BalancedTernary((sum.pos & keep) | (TRIT_MASK & sat_hi),
+                               (sum.neg & keep) | (TRIT_MASK & sat_lo));
+    }
+
+    // Reference Ripple-Carry Adder (per-trit loop, for differential testing)
+    BalancedTernary AddRipple(const BalancedTernary& other, int8_t& carry_out) const;
+
+    // Multiply/Divide (constexpr).
+    // These are the int64 conversion round trip, not native ternary
+    // arithmetic: ToInt64, multiply or divide, FromInt64. The bitplane
+    // shift-add measured slower than that for every operand that fits int64,
+    // so it only runs where the product does not. The interpreter's MUL/DIV/MOD
+    // do not come here (RegArith, cpu.h).
+    // Multiply returns the low N trits of the 2N-trit product; 'high' receives
+    // the upper N (non-zero means the product overflowed the word). The double
+    // estimate is within 2^-52 of a * b.
+    constexpr BalancedTernary Multiply(const BalancedTernary& other, BalancedTernary& high) const {
+        int64_t a = ToInt64(), b = other.ToInt64();
+        double estimate = (double)a * (double)b;
+        if (estimate <= -4e18 || estimate >= 4e18) return MultiplyPlanes(other, high);
+        const int64_t range = TritDetail::Pow3(N);
+        int64_t p = a * b;
+        BalancedTernary low = FromInt64(p);
+        high = (p >= -(range / 2) && p <= range / 2) ? BalancedTernary() : FromInt64((p - low.ToInt64()) / range);
+        return low;
+    }
+    constexpr BalancedTernary Multiply(const BalancedTernary& other) const {
+        BalancedTernary high;
+        return Multiply(other, high);
+    }
+    // Truncating division (C++ semantics: remainder takes the dividend's sign).
+    // Returns false on a zero divisor. N <= 32 words fit int64, so this is
+    // the int64 division.
+    constexpr bool DivMod(const BalancedTernary& divisor, BalancedTernary& quotient, BalancedTernary& remainder) const {
+        int64_t b = divisor.ToInt64();
+        if (b == 0) return false;
+        int64_t a = ToInt64();
+        quotient = FromInt64(a / b);
+        remainder = FromInt64(a % b);
+        return true;
+    }
+
+    // Bitplane forms, same results for every operand. Not the hot path:
+    // MultiplyPlanes is the fallback for products beyond int64 (and the
+    // reference for the int64 route); DivModPlanes (long division,
+    // trit_word.cpp, run time only) has no caller outside test_alu and the
+    // microbenchmark and is kept as the differential reference for DivMod.
+    // Shift-add over the non-zero trits of the shorter operand: partial
+    // products (+-a shifted by i, a plane swap for -1) are folded into a
+    // carry-save pair, then resolved by one 64-trit settle.
+    constexpr BalancedTernary MultiplyPlanes(const BalancedTernary& other, BalancedTernary& high) const {
+        uint64_t ap = pos & ~neg & TRIT_MASK;
+        uint64_t an = neg & ~pos & TRIT_MASK;
+        uint64_t bp = other.pos & ~other.neg & TRIT_MASK;
+        uint64_t bn = other.neg & ~other.pos & TRIT_MASK;
+
+        if ((ap | an) < (bp | bn)) { // Shorter operand drives the loop
+            uint64_t tp = ap, tn = an;
+            ap = bp; an = bn;
+            bp = tp; bn = tn;
+        }
+
+        uint64_t sp = 0, sn = 0, cp = 0, cn = 0;
+        for (uint64_t m = bp | bn; m; m &= m - 1) {
+            uint64_t bit = m & (0 - m); // Multiplying by it shifts by the trit index
+            uint64_t negate = 0 - (uint64_t)((bn & bit) != 0);
+            uint64_t pp = ((ap & ~negate) | (an & negate)) * bit;
+            uint64_t pn = ((an & ~negate) | (ap & negate)) * bit;
+            uint64_t np = 0, nn = 0;
+            TritDetail::CarrySave(sp, sn, cp, cn, pp, pn, np, nn, cp, cn);
+            sp = np; sn = nn;
+            cp <<= 1; cn <<= 1;
+        }
+
+        uint64_t rp = 0, rn = 0;
+        TritDetail::AddPlanesSettle(sp, sn, cp, cn, rp, rn);
+
+        high = BalancedTernary((rp >> N) & TRIT_MASK, (rn >> N) & TRIT_MASK);
+        return BalancedTernary(rp & TRIT_MASK, rn & TRIT_MASK);
+    }
+    bool DivModPlanes(const BalancedTernary& divisor, BalancedTernary& quotient, BalancedTernary& remainder) const;
 
     // Cognitive Operations (Phase 6)
-    TernaryWord Consensus(const TernaryWord& other) const; // A=B->A, else 0
-    TernaryWord Decay(const TernaryWord& mask) const;      // Intersect with mask
-    int PopCount() const;                                  // Count non-zero trits
+    // Consensus: A=B -> A, 0 with X -> X, conflict -> 0
+    //   P_out = (P1 & ~N2) | (P2 & ~N1),  N_out = (N1 & ~P2) | (N2 & ~P1)
+    constexpr BalancedTernary Consensus(const BalancedTernary& other) const {
+        return BalancedTernary((pos & ~other.neg) | (other.pos & ~neg),
+                               (neg & ~other.pos) | (other.neg & ~pos));
+    }
+    // Decay: intersect with mask
+    constexpr BalancedTernary Decay(const BalancedTernary& mask) const {
+        return BalancedTernary(pos & mask.pos, neg & mask.neg);
+    }
+    // Count non-zero trits
+    constexpr int PopCount() const {
+        return TritDetail::CountBits((pos | neg) & TRIT_MASK);
+    }
 
     // Encoding (Phase 6)
     uint64_t ToPacked() const;                             // 2-bit packing
-    static TernaryWord FromPacked(uint64_t val);
+    static BalancedTernary FromPacked(uint64_t val);
+
+    // Packing backend: BMI2 PDEP/PEXT when the host supports it, else a
+    // portable bit spread. SetPackedBMI2 is clamped to host support.
+    static bool PackedUsesBMI2();
+    static void SetPackedBMI2(bool enable);
+
+    // Bulk codec: 'count' words as a dense little-endian stream of 2N-bit
+    // codes (for 27 trits, 4 words = 27 bytes), for on-disk and compressed formats.
+    static size_t PackedStreamBytes(size_t count) { return (count * 2 * N + 7) / 8; }
+    static void PackStream(const BalancedTernary* words, size_t count, uint8_t* out);
+    static void UnpackStream(const uint8_t* in, size_t count, BalancedTernary* words);
+
+    // Reference Encoding (per-trit loops, for differential testing)
+    uint64_t ToPackedReference() const;
+    static BalancedTernary FromPackedReference(uint64_t val);
 
     // Bit-Slicing (for Instruction Decoding)
-    int8_t GetTrit(int index) const;
-    void SetTrit(int index, int8_t val);
-    
-    // Slice: Extract value from [start, start+len-1]
-    int64_t Slice(int start, int len) const;
-    
-    // SetSlice: Set value into [start, start+len-1]
-    void SetSlice(int start, int len, int64_t val);
+    constexpr int8_t GetTrit(int index) const {
+        if (index < 0 || index >= N) return 0;
+        if ((pos >> index) & 1) return 1;
+        if ((neg >> index) & 1) return -1;
+        return 0;
+    }
+    constexpr void SetTrit(int index, int8_t val) {
+        if (index < 0 || index >= N) return;
+        pos &= ~(1u << index);
+        neg &= ~(1u << index);
+        if (val == 1) pos |= (1u << index);
+        else if (val == -1) neg |= (1u << index);
+    }
+
+    // Slice: Extract value from [start, start+len-1] (masked planes + chunk tables)
+    constexpr int64_t Slice(int start, int len) const {
+        int lo = start < 0 ? 0 : start;
+        int hi = start + len < N ? start + len : N;
+        if (hi <= lo) return 0;
+
+        uint64_t mask = TritDetail::TritMask(hi - lo);
+        uint64_t p = (pos >> lo) & mask;
+        uint64_t n = (TritDetail::CleanNeg(pos, neg) >> lo) & mask;
+
+        int64_t val = HELIX_CONSTANT_EVALUATED() ? BalancedTernary(p, n).ToInt64Reference()
+                                                 : TritDetail::PlanesValue(p, n, hi - lo);
+
+        // Trits below index 0 read as 0 but still occupy low digits
+        for (int i = start; i < 0; ++i) val *= 3;
+        return val;
+    }
+
+    // SetSlice: Set value into [start, start+len-1]. The balanced digits of val
+    // come from the word conversion, then both planes are merged under the mask.
+    constexpr void SetSlice(int start, int len, int64_t val) {
+        int lo = start < 0 ? 0 : start;
+        int hi = start + len < N ? start + len : N;
+        if (hi <= lo) return;
+
+        // Low len digits of val; digits destined for negative indices are dropped
+        BalancedTernary digits = FromInt64(val);
+        uint64_t p = (uint64_t)digits.pos >> (lo - start);
+        uint64_t n = (uint64_t)digits.neg >> (lo - start);
+
+        uint64_t mask = TritDetail::TritMask(hi - lo) << lo;
+        pos = (uint32_t)((pos & ~mask) | ((p << lo) & mask));
+        neg = (uint32_t)((neg & ~mask) | ((n << lo) & mask));
+    }
+
+    // Reference Slicing (per-trit loops, for differential testing)
+    int64_t SliceReference(int start, int len) const;
+    void SetSliceReference(int start, int len, int64_t val);
 
     // Helpers
     std::string ToString() const;
 };
 
+// Multi-limb word: N / 27 little-endian limbs of 27 trits
+template <int N>
+class BalancedTernary<N, true> {
+    static_assert(N % 27 == 0, "Multi-limb BalancedTernary needs a multiple of 27 trits");
+
+public:
+    using Limb = BalancedTernary<27>;
+    static constexpr int NUM_TRITS = N;
+    static constexpr int LIMB_TRITS = 27;
+    static constexpr int LIMBS = N / 27;
+
+    Limb limbs[LIMBS]; // limbs[0] holds trits 0..26
+
+    constexpr BalancedTernary() : limbs{} {}
+
+    // Values wider than one limb carry into the next (v = q * 3^27 + r)
+    static constexpr BalancedTernary FromInt64(int64_t value) {
+        const int64_t base = TritDetail::Pow3(LIMB_TRITS);
+        const int64_t half = (base - 1) / 2;
+        BalancedTernary w;
+        for (int i = 0; i < LIMBS && value != 0; ++i) {
+            int64_t q = value / base;
+            int64_t r = value % base;
+            if (r > half) { r -= base; ++q; }
+            else if (r < -half) { r += base; --q; }
+            w.limbs[i] = Limb::FromInt64(r);
+            value = q;
+        }
+        return w;
+    }
+
+    // Wraps (mod 2^64) when the value does not fit in int64
+    constexpr int64_t ToInt64() const {
+        const uint64_t base = (uint64_t)TritDetail::Pow3(LIMB_TRITS);
+        uint64_t result = 0;
+        for (int i = LIMBS - 1; i >= 0; --i) result = result * base + (uint64_t)limbs[i].ToInt64();
+        return (int64_t)result;
+    }
+
+    constexpr int8_t GetTrit(int index) const {
+        if (index < 0 || index >= N) return 0;
+        return limbs[index / LIMB_TRITS].GetTrit(index % LIMB_TRITS);
+    }
+    constexpr void SetTrit(int index, int8_t val) {
+        if (index < 0 || index >= N) return;
+        limbs[index / LIMB_TRITS].SetTrit(index % LIMB_TRITS, val);
+    }
+
+    // Logic Operations (limb-wise)
+    constexpr BalancedTernary Min(const BalancedTernary& other) const {
+        BalancedTernary r;
+        for (int i = 0; i < LIMBS; ++i) r.limbs[i] = limbs[i].Min(other.limbs[i]);
+        return r;
+    }
+    constexpr BalancedTernary Max(const BalancedTernary& other) const {
+        BalancedTernary r;
+        for (int i = 0; i < LIMBS; ++i) r.limbs[i] = limbs[i].Max(other.limbs[i]);
+        return r;
+    }
+    constexpr BalancedTernary Negate() const {
+        BalancedTernary r;
+        for (int i = 0; i < LIMBS; ++i) r.limbs[i] = limbs[i].Negate();
+        return r;
+    }
+    constexpr BalancedTernary XOR(const BalancedTernary& other) const {
+        BalancedTernary r;
+        for (int i = 0; i < LIMBS; ++i) r.limbs[i] = limbs[i].XOR(other.limbs[i]);
+        return r;
+    }
+    constexpr BalancedTernary Consensus(const BalancedTernary& other) const {
+        BalancedTernary r;
+        for (int i = 0; i < LIMBS; ++i) r.limbs[i] = limbs[i].Consensus(other.limbs[i]);
+        return r;
+    }
+    constexpr BalancedTernary Decay(const BalancedTernary& mask) const {
+        BalancedTernary r;
+        for (int i = 0; i < LIMBS; ++i) r.limbs[i] = limbs[i].Decay(mask.limbs[i]);
+        return r;
+    }
+    constexpr int PopCount() const {
+        int count = 0;
+        for (int i = 0; i < LIMBS; ++i) count += limbs[i].PopCount();
+        return count;
+    }
+
+    // Shifts move the boundary trit between limbs
+    constexpr BalancedTernary ShiftLeft() const {
+        BalancedTernary r;
+        for (int i = LIMBS - 1; i >= 0; --i) {
+            r.limbs[i] = limbs[i].ShiftLeft();
+            if (i > 0) r.limbs[i].SetTrit(0, limbs[i - 1].GetTrit(LIMB_TRITS - 1));
+        }
+        return r;
+    }
+    constexpr BalancedTernary ShiftRight() const {
+        BalancedTernary r;
+        for (int i = 0; i < LIMBS; ++i) {
+            r.limbs[i] = limbs[i].ShiftRight();
+            if (i + 1 < LIMBS) r.limbs[i].SetTrit(LIMB_TRITS - 1, limbs[i + 1].GetTrit(0));
+        }
+        return r;
+    }
+
+    // Limb-wise lookahead adds with the carry trit rippled between limbs
+    constexpr BalancedTernary Add(const BalancedTernary& other) const {
+        int8_t carry = 0;
+        return Add(other, carry);
+    }
+    constexpr BalancedTernary Add(const BalancedTernary& other, int8_t& carry_out) const {
+        BalancedTernary r;
+        int8_t carry = 0;
+        for (int i = 0; i < LIMBS; ++i) {
+            int8_t c1 = 0, c2 = 0;
+            Limb s = limbs[i].Add(other.limbs[i], c1);
+            r.limbs[i] = s.Add(Limb::FromInt64(carry), c2);
+            carry = (int8_t)(c1 + c2); // |a + b + cin| <= 3^27, so one trit
+        }
+        carry_out = carry;
+        return r;
+    }
+
+    std::string ToString() const {
+        std::string s;
+        for (int i = N - 1; i >= 0; --i) {
+            int8_t t = GetTrit(i);
+            s += t > 0 ? '+' : (t < 0 ? '-' : '0');
+        }
+        return s;
+    }
+};
+
+// Machine word (27 trits) and a 3-limb wide word
+using TernaryWord = BalancedTernary<27>;
+using TernaryWord81 = BalancedTernary<81>;
+
+static_assert(sizeof(TernaryWord) == 8, "TernaryWord storage must stay 8 bytes");
@@ -0,0 +1,55 @@
+#include "worker_pool.h"
+
+WorkerPool::WorkerPool(int threads) : thread_count(threads > 1 ? threads : 1) {
+    for (int k = 1; k < thread_count; ++k) workers.emplace_back(&WorkerPool::WorkerLoop, this, k);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers) t.join();
+}
+
+void WorkerPool::ParallelFor(int count, const std::function<void(int, int)>& body) {
+    if (thread_count == 1) {
+        body(0, count);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &body;
+        job_count = count;
+        running = (int)workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    body(0, RangeBegin(count, thread_count, 1));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return running == 0; });
+    job = nullptr;
+}
+
+void WorkerPool::WorkerLoop(int range) {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+        const std::function<void(int, int)>& body = *job;
+        int count = job_count;
+        lock.unlock();
+
+        int begin = RangeBegin(count, thread_count, range);
+        int end = RangeBegin(count, thread_count, range + 1);
+        if (begin < end) body(begin, end);
+
+        lock.lock();
+        if (--running == 0) done.notify_one();
+    }
+}
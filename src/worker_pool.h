@@ -0,0 +1,42 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker Pool
+// Persistent threads for data-parallel work inside one instruction (VMMUL
+// rows). ParallelFor splits [0, count) into Threads() contiguous ranges,
+// runs the first on the calling thread and the others on the workers, and
+// returns once all of them are done. The ranges depend only on count and
+// the thread count, never on timing. Workers sleep between jobs; one caller
+// at a time.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threads); // Including the calling thread (at least 1)
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int Threads() const { return thread_count; }
+    void ParallelFor(int count, const std::function<void(int begin, int end)>& body);
+
+    // Range k of count items split 'threads' ways
+    static int RangeBegin(int count, int threads, int k) { return (int)((int64_t)count * k / threads); }
+
+private:
+    void WorkerLoop(int range);
+
+    int thread_count;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake; // New job or shutdown
+    std::condition_variable done; // Last worker finished its range
+    const std::function<void(int, int)>* job = nullptr;
+    int job_count = 0;
+    uint64_t generation = 0; // Bumped per job
+    int running = 0;         // Workers still in the current job
+    bool stopping = false;
+};